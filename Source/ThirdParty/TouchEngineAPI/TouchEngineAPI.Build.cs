@@ -1,6 +1,7 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 using System.IO;
+using EpicGames.Core;
 using UnrealBuildTool;
 
 public class TouchEngineAPI : ModuleRules
@@ -28,10 +29,46 @@ public class TouchEngineAPI : ModuleRules
             RuntimeDependencies.Add("$(BinaryOutputDir)/TouchEngine.dll", Path.Combine("$(PluginDir)", "Binaries/ThirdParty/Win64/TouchEngine.dll"));
             PublicAdditionalLibraries.Add(Path.Combine(BinDir, "TouchEngine.lib"));
         }
+        else if (Target.Platform == UnrealTargetPlatform.Linux)
+        {
+            // There is no TouchEngine for Linux: this is meant for a stand-in build of the API (see Source/ThirdParty/TouchEngineStandIn),
+            // used with -nullrhi to profile the cook pipeline. The library is resolved by the dynamic loader when the module loads.
+            // The TouchEngine module is not allowed on Linux by default, as we do not ship the library: Linux is an opt-in profiling setup, and the library is only linked if it has been built.
+            PublicIncludePaths.Add(Path.Combine(ModuleDirectory, "include"));
+            PublicDefinitions.Add("TE_EXPORT=");
+
+            string LibPath = GetConfiguredLibraryPath(Target, "libTouchEngine.so") ?? Path.Combine(ModuleDirectory, "../../../Binaries/ThirdParty/Linux/libTouchEngine.so");
+            if (File.Exists(LibPath))
+            {
+                RuntimeDependencies.Add("$(BinaryOutputDir)/libTouchEngine.so", LibPath);
+                PublicAdditionalLibraries.Add(LibPath);
+            }
+        }
         else if (Target.Platform == UnrealTargetPlatform.Mac)
         {
             //PublicDelayLoadDLLs.Add(Path.Combine(ModuleDirectory, "Mac", "Release", "libExampleLibrary.dylib"));
             //RuntimeDependencies.Add("$(PluginDir)/Source/ThirdParty/TouchEngineLibrary/Mac/Release/libExampleLibrary.dylib");
         }
 	}
+
+	/**
+	 * Returns the library set with [TouchEngine] LibraryPath in the project's Engine.ini, resolved like FTouchEngineModule::GetTouchEngineLibPath does at runtime,
+	 * or null if none is set. Only needed on the platforms where we link against the library instead of loading it at runtime.
+	 */
+	private static string GetConfiguredLibraryPath(ReadOnlyTargetRules Target, string LibName)
+	{
+		DirectoryReference ProjectDir = Target.ProjectFile != null ? Target.ProjectFile.Directory : null;
+		ConfigHierarchy EngineIni = ConfigCache.ReadHierarchy(ConfigHierarchyType.Engine, ProjectDir, Target.Platform);
+		string ConfiguredPath;
+		if (!EngineIni.GetString("TouchEngine", "LibraryPath", out ConfiguredPath) || string.IsNullOrEmpty(ConfiguredPath))
+		{
+			return null;
+		}
+
+		if (!Path.IsPathRooted(ConfiguredPath) && ProjectDir != null)
+		{
+			ConfiguredPath = Path.GetFullPath(Path.Combine(ProjectDir.FullName, ConfiguredPath));
+		}
+		return Directory.Exists(ConfiguredPath) ? Path.Combine(ConfiguredPath, LibName) : ConfiguredPath;
+	}
 }
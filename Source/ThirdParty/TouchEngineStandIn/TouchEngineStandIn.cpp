@@ -0,0 +1,1889 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+/*
+ * Stand-in implementation of the TouchEngine C API.
+ *
+ * It implements the non-graphics part of the API (instances, links, float buffers, tables, strings) without launching
+ * TouchDesigner, so the plugin's cook pipeline (FTouchFrameCooker, FTouchVariableManager, FTouchEngineDynamicVariableContainer)
+ * can be exercised and measured on machines without a TouchEngine install or a GPU. It is meant to be paired with the
+ * headless resource provider (-nullrhi): textures are opaque objects, and texture transfers are no-ops.
+ *
+ * This file is not part of any UBT module, it is built as a shared library by the CMakeLists.txt next to it (with Clang or MSVC):
+ *   cmake -S Source/ThirdParty/TouchEngineStandIn -B Intermediate/TouchEngineStandIn -DCMAKE_CXX_COMPILER=clang++ -DCMAKE_BUILD_TYPE=Release
+ *   cmake --build Intermediate/TouchEngineStandIn --config Release
+ * On Windows, point the plugin at it with -TouchEngineLib=<path> or [TouchEngine] LibraryPath=<path> in Engine.ini.
+ * On Linux, it is written to Binaries/ThirdParty/Linux/libTouchEngine.so, where the plugin links against it unless [TouchEngine] LibraryPath
+ * points somewhere else when the plugin is built. The TouchEngine module also needs "Linux" in its PlatformAllowList in TouchEngine.uplugin.
+ *
+ * The behaviour is configured through environment variables:
+ *   TE_STANDIN_COOK_TIME_US       Simulated cook time per frame, in microseconds (default 1000)
+ *   TE_STANDIN_COOK_JITTER_US     Random jitter added to the cook time, in microseconds (default 0)
+ *   TE_STANDIN_CHANGE_INTERVAL    Outputs change value every N cooked frames, 0 to never change them (default 1)
+ *   TE_STANDIN_DROP_INTERVAL      Every Nth frame is reported as dropped, 0 to never drop frames (default 0)
+ *   TE_STANDIN_LAYOUT             Path to a layout file, used when the loaded .tox is not itself a layout file
+ *
+ * A layout file is a text file (it may be given the .tox extension and loaded directly) starting with the line
+ * "# TouchEngine stand-in layout", followed by one link per line:
+ *   <par|in|out> <bool|double|int|string|chop|dat|top> <name> [count | <channels>x<samples> | <rows>x<columns>]
+ * Empty lines and lines starting with '#' are ignored.
+ */
+
+#include <TouchEngine/TEInstance.h>
+#include <TouchEngine/TEFloatBuffer.h>
+#include <TouchEngine/TETable.h>
+#include <TouchEngine/TETexture.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	/** Every object handed out by the library is preceded by this header, which is how TERetain / TERelease / TEGetType find it. */
+	struct alignas(16) FObjectHeader
+	{
+		std::atomic<int32_t> RefCount { 1 };
+		TEObjectType Type = TEObjectTypeUnknown;
+		void (*Destroy)(FObjectHeader* Header) = nullptr;
+	};
+	static_assert(sizeof(FObjectHeader) == 16, "The object payload must stay 16 bytes aligned");
+
+	FObjectHeader* GetHeader(const void* Object)
+	{
+		return const_cast<FObjectHeader*>(static_cast<const FObjectHeader*>(Object) - 1);
+	}
+
+	template<typename T>
+	void DestroyObject(FObjectHeader* Header)
+	{
+		static_cast<T*>(static_cast<void*>(Header + 1))->~T();
+		Header->~FObjectHeader();
+		::operator delete(Header);
+	}
+
+	template<typename T, typename... TArgs>
+	T* CreateObject(TEObjectType Type, TArgs&&... Args)
+	{
+		void* Memory = ::operator new(sizeof(FObjectHeader) + sizeof(T));
+		FObjectHeader* Header = new (Memory) FObjectHeader();
+		Header->Type = Type;
+		Header->Destroy = &DestroyObject<T>;
+		return new (Header + 1) T(std::forward<TArgs>(Args)...);
+	}
+
+	struct FStringBody : TEString
+	{
+		explicit FStringBody(std::string InValue)
+			: Storage(std::move(InValue))
+		{
+			string = Storage.c_str();
+		}
+
+		std::string Storage;
+	};
+
+	struct FStringArrayBody : TEStringArray
+	{
+		explicit FStringArrayBody(std::vector<std::string> InValues)
+			: Storage(std::move(InValues))
+		{
+			for (const std::string& Value : Storage)
+			{
+				Pointers.push_back(Value.c_str());
+			}
+			count = static_cast<int32_t>(Storage.size());
+			strings = Pointers.empty() ? nullptr : Pointers.data();
+		}
+
+		std::vector<std::string> Storage;
+		std::vector<const char*> Pointers;
+	};
+
+	struct FLinkInfoBody : TELinkInfo
+	{
+		FLinkInfoBody(const TELinkInfo& Info, std::string InLabel, std::string InName, std::string InIdentifier)
+			: TELinkInfo(Info)
+			, Label(std::move(InLabel))
+			, Name(std::move(InName))
+			, Identifier(std::move(InIdentifier))
+		{
+			label = Label.c_str();
+			name = Name.c_str();
+			identifier = Identifier.c_str();
+		}
+
+		std::string Label;
+		std::string Name;
+		std::string Identifier;
+	};
+
+	struct FErrorArrayBody : TEErrorArray
+	{
+		FErrorArrayBody()
+		{
+			count = 0;
+			errors = nullptr;
+		}
+	};
+
+	/** Stands in for any texture output by the instance. It has no backing memory: the headless importer provides the pixels. */
+	struct FTextureBody
+	{
+		TETextureType Type = TETextureTypeD3DShared;
+		TETextureOrigin Origin = TETextureOriginTopLeft;
+	};
+
+	TEObject* RetainObject(TEObject* Object)
+	{
+		if (Object)
+		{
+			GetHeader(Object)->RefCount.fetch_add(1, std::memory_order_relaxed);
+		}
+		return Object;
+	}
+
+	void ReleaseObject(TEObject* Object)
+	{
+		if (Object)
+		{
+			FObjectHeader* Header = GetHeader(Object);
+			if (Header->RefCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			{
+				Header->Destroy(Header);
+			}
+		}
+	}
+
+	/** Holds a reference to a TEObject, the same way the plugin's TouchObject does */
+	template<typename T>
+	class TObjectRef
+	{
+	public:
+		TObjectRef() = default;
+		TObjectRef(const TObjectRef& Other) : Object(static_cast<T*>(RetainObject(Other.Object))) {}
+		~TObjectRef() { ReleaseObject(Object); }
+		TObjectRef& operator=(const TObjectRef& Other)
+		{
+			Set(Other.Object);
+			return *this;
+		}
+
+		/** Takes a new reference to InObject */
+		void Set(T* InObject)
+		{
+			T* Previous = Object;
+			Object = static_cast<T*>(RetainObject(const_cast<void*>(static_cast<const void*>(InObject))));
+			ReleaseObject(const_cast<void*>(static_cast<const void*>(Previous)));
+		}
+		/** Adopts a reference that was already retained, such as a newly created object */
+		void Adopt(T* InObject)
+		{
+			ReleaseObject(const_cast<void*>(static_cast<const void*>(Object)));
+			Object = InObject;
+		}
+		/** Returns a new reference for the caller to release */
+		T* Share() const { return static_cast<T*>(RetainObject(const_cast<void*>(static_cast<const void*>(Object)))); }
+		T* Get() const { return Object; }
+
+	private:
+		T* Object = nullptr;
+	};
+
+	int64_t ReadEnvironmentInt(const char* Name, int64_t DefaultValue)
+	{
+		const char* Value = std::getenv(Name);
+		return Value && *Value ? std::strtoll(Value, nullptr, 10) : DefaultValue;
+	}
+
+	template<typename T>
+	TEResult CopyValues(const std::vector<T>& Source, T* Destination, int32_t Count)
+	{
+		if (!Destination || Count < 0 || static_cast<size_t>(Count) > Source.size())
+		{
+			return TEResultBadUsage;
+		}
+		std::copy_n(Source.begin(), Count, Destination);
+		return TEResultSuccess;
+	}
+}
+
+struct TEFloatBuffer_
+{
+	TEFloatBuffer_(double InRate, int32_t InChannels, uint32_t InCapacity, const char* const* InNames, bool bInTimeDependent)
+		: Rate(InRate)
+		, Capacity(InCapacity)
+		, bTimeDependent(bInTimeDependent)
+		, Values(std::max(InChannels, 0), std::vector<float>(InCapacity, 0.f))
+	{
+		for (int32_t Channel = 0; Channel < static_cast<int32_t>(Values.size()); ++Channel)
+		{
+			Names.emplace_back(InNames && InNames[Channel] ? InNames[Channel] : "");
+		}
+		UpdatePointers();
+	}
+
+	TEFloatBuffer_(const TEFloatBuffer_& Other)
+		: Rate(Other.Rate)
+		, Capacity(Other.Capacity)
+		, Count(Other.Count)
+		, bTimeDependent(Other.bTimeDependent)
+		, StartTime(Other.StartTime)
+		, ExtendBefore(Other.ExtendBefore)
+		, ExtendAfter(Other.ExtendAfter)
+		, ExtendConstant(Other.ExtendConstant)
+		, Values(Other.Values)
+		, Names(Other.Names)
+	{
+		UpdatePointers();
+	}
+
+	void UpdatePointers()
+	{
+		ValuePointers.clear();
+		NamePointers.clear();
+		for (size_t Channel = 0; Channel < Values.size(); ++Channel)
+		{
+			ValuePointers.push_back(Values[Channel].data());
+			NamePointers.push_back(Names[Channel].empty() ? nullptr : Names[Channel].c_str());
+		}
+	}
+
+	double Rate;
+	uint32_t Capacity;
+	uint32_t Count = 0;
+	bool bTimeDependent;
+	int64_t StartTime = 0;
+	TEFloatBufferExtend ExtendBefore = TEFloatBufferExtendHold;
+	TEFloatBufferExtend ExtendAfter = TEFloatBufferExtendHold;
+	float ExtendConstant = 0.f;
+	std::vector<std::vector<float>> Values;
+	std::vector<std::string> Names;
+	std::vector<const float*> ValuePointers;
+	std::vector<const char*> NamePointers;
+};
+
+struct TETable_
+{
+	std::string* GetCell(int32_t Row, int32_t Column)
+	{
+		if (Row < 0 || Column < 0 || Row >= Rows || Column >= Columns)
+		{
+			return nullptr;
+		}
+		return &Cells[static_cast<size_t>(Row) * Columns + Column];
+	}
+
+	int32_t Rows = 0;
+	int32_t Columns = 0;
+	std::vector<std::string> Cells;
+};
+
+namespace
+{
+	/** A link of the simulated component, and its current value */
+	struct FLink
+	{
+		TELinkInfo Info {};
+		std::string Name;
+		std::string Identifier;
+		std::string Group;
+		TELinkInterest Interest = TELinkInterestAll;
+		// 1st dimension of the value: channels for CHOPs, rows for DATs
+		int32_t SizeA = 0;
+		// 2nd dimension of the value: samples for CHOPs, columns for DATs
+		int32_t SizeB = 0;
+
+		bool BoolValue = false;
+		std::vector<double> DoubleValues;
+		std::vector<int32_t> IntValues;
+		std::string StringValue;
+		TObjectRef<TEFloatBuffer> FloatBufferValue;
+		TObjectRef<TETable> TableValue;
+		TObjectRef<TETexture> TextureValue;
+	};
+
+	/** The groups returned by TEInstanceGetLinkGroups, one per kind of link in the layout */
+	struct FGroup
+	{
+		std::string Identifier;
+		std::string Label;
+		TEScope Scope;
+		std::vector<std::string> Children;
+	};
+
+	constexpr const char* LayoutHeader = "# TouchEngine stand-in layout";
+
+	constexpr const char* DefaultLayout =
+		"par double Speed 1\n"
+		"par int Mode 1\n"
+		"par bool Enable\n"
+		"par string Label\n"
+		"in double Position 3\n"
+		"in chop InputChop 2x64\n"
+		"in dat InputDat 4x4\n"
+		"in top InputTop\n"
+		"out double Result 4\n"
+		"out string Status\n"
+		"out chop OutputChop 2x64\n"
+		"out dat OutputDat 4x4\n"
+		"out top OutputTop\n";
+
+	bool ReadFile(const std::string& Path, std::string& OutContent)
+	{
+		std::ifstream Stream(Path, std::ios::binary);
+		if (!Stream)
+		{
+			return false;
+		}
+		std::stringstream Buffer;
+		Buffer << Stream.rdbuf();
+		OutContent = Buffer.str();
+		return true;
+	}
+
+	/** Parses the layout description, see the top of the file for the format. Returns false if any line is malformed. */
+	bool ParseLayout(const std::string& Layout, std::vector<std::unique_ptr<FLink>>& OutLinks)
+	{
+		std::istringstream Lines(Layout);
+		std::string Line;
+		while (std::getline(Lines, Line))
+		{
+			Line.erase(std::remove(Line.begin(), Line.end(), '\r'), Line.end());
+			if (Line.empty() || Line[0] == '#')
+			{
+				continue;
+			}
+
+			std::istringstream Tokens(Line);
+			std::string Kind, Type, Name, Size;
+			if (!(Tokens >> Kind >> Type >> Name))
+			{
+				return false;
+			}
+			Tokens >> Size;
+
+			std::unique_ptr<FLink> Link = std::make_unique<FLink>();
+			Link->Name = Name;
+			Link->Info.intent = TELinkIntentNotSpecified;
+			if (Kind == "par")
+			{
+				Link->Info.scope = TEScopeInput;
+				Link->Info.domain = TELinkDomainParameter;
+				Link->Identifier = "p/" + Name;
+				Link->Group = "group/parameters";
+			}
+			else if (Kind == "in" || Kind == "out")
+			{
+				const bool bIsInput = Kind == "in";
+				Link->Info.scope = bIsInput ? TEScopeInput : TEScopeOutput;
+				Link->Info.domain = TELinkDomainOperator;
+				Link->Identifier = (bIsInput ? "i/" : "o/") + Name;
+				Link->Group = bIsInput ? "group/inputs" : "group/outputs";
+			}
+			else
+			{
+				return false;
+			}
+
+			// 1. The size is either a count, or two dimensions separated by 'x'
+			int32_t Count = 1;
+			const size_t Separator = Size.find('x');
+			if (Separator != std::string::npos)
+			{
+				Link->SizeA = std::max(1, std::atoi(Size.substr(0, Separator).c_str()));
+				Link->SizeB = std::max(1, std::atoi(Size.substr(Separator + 1).c_str()));
+			}
+			else if (!Size.empty())
+			{
+				Count = std::max(1, std::atoi(Size.c_str()));
+			}
+
+			// 2. Type specific defaults
+			if (Type == "bool")
+			{
+				Link->Info.type = TELinkTypeBoolean;
+			}
+			else if (Type == "double")
+			{
+				Link->Info.type = TELinkTypeDouble;
+				Link->DoubleValues.assign(Count, 0.0);
+			}
+			else if (Type == "int")
+			{
+				Link->Info.type = TELinkTypeInt;
+				Link->IntValues.assign(Count, 0);
+			}
+			else if (Type == "string")
+			{
+				Link->Info.type = TELinkTypeString;
+			}
+			else if (Type == "chop")
+			{
+				Link->Info.type = TELinkTypeFloatBuffer;
+				Link->SizeA = std::max(Link->SizeA, 1);
+				Link->SizeB = std::max(Link->SizeB, 1);
+			}
+			else if (Type == "dat")
+			{
+				Link->Info.type = TELinkTypeStringData;
+				Link->SizeA = std::max(Link->SizeA, 1);
+				Link->SizeB = std::max(Link->SizeB, 1);
+			}
+			else if (Type == "top")
+			{
+				Link->Info.type = TELinkTypeTexture;
+			}
+			else
+			{
+				return false;
+			}
+			Link->Info.count = Link->Info.type == TELinkTypeDouble || Link->Info.type == TELinkTypeInt ? Count : 1;
+
+			OutLinks.push_back(std::move(Link));
+		}
+		return true;
+	}
+}
+
+struct TEInstance_
+{
+	/** The state shared with the worker thread, which can outlive the instance if the last reference is released from a callback */
+	struct FWorker
+	{
+		std::mutex Mutex;
+		std::condition_variable Condition;
+		std::deque<std::function<void()>> Tasks;
+		bool bExit = false;
+		std::thread Thread;
+	};
+
+	TEInstance_(TEInstanceEventCallback InEventCallback, TEInstanceLinkCallback InLinkCallback, void* InInfo)
+		: EventCallback(InEventCallback)
+		, LinkCallback(InLinkCallback)
+		, CallbackInfo(InInfo)
+		, CookTimeMicroseconds(std::max<int64_t>(ReadEnvironmentInt("TE_STANDIN_COOK_TIME_US", 1000), 0))
+		, CookJitterMicroseconds(std::max<int64_t>(ReadEnvironmentInt("TE_STANDIN_COOK_JITTER_US", 0), 0))
+		, ChangeInterval(std::max<int64_t>(ReadEnvironmentInt("TE_STANDIN_CHANGE_INTERVAL", 1), 0))
+		, DropInterval(std::max<int64_t>(ReadEnvironmentInt("TE_STANDIN_DROP_INTERVAL", 0), 0))
+		, Random(std::random_device{}())
+		, Worker(std::make_shared<FWorker>())
+	{
+		std::shared_ptr<FWorker> State = Worker;
+		Worker->Thread = std::thread([State]()
+		{
+			for (;;)
+			{
+				std::function<void()> Task;
+				{
+					std::unique_lock<std::mutex> Lock(State->Mutex);
+					State->Condition.wait(Lock, [&State]() { return State->bExit || !State->Tasks.empty(); });
+					if (State->bExit)
+					{
+						return;
+					}
+					Task = std::move(State->Tasks.front());
+					State->Tasks.pop_front();
+				}
+				Task();
+			}
+		});
+	}
+
+	~TEInstance_()
+	{
+		{
+			std::lock_guard<std::mutex> Lock(Worker->Mutex);
+			Worker->bExit = true;
+			Worker->Tasks.clear();
+		}
+		bCancelFrame = true;
+		Worker->Condition.notify_all();
+
+		if (Worker->Thread.get_id() == std::this_thread::get_id())
+		{
+			Worker->Thread.detach();
+		}
+		else if (Worker->Thread.joinable())
+		{
+			Worker->Thread.join();
+		}
+	}
+
+	void Enqueue(std::function<void()> Task)
+	{
+		{
+			std::lock_guard<std::mutex> Lock(Worker->Mutex);
+			Worker->Tasks.push_back(std::move(Task));
+		}
+		Worker->Condition.notify_all();
+	}
+
+	void SendEvent(TEEvent Event, TEResult Result, int64_t StartValue = 0, int32_t StartScale = 1, int64_t EndValue = 0, int32_t EndScale = 1)
+	{
+		if (EventCallback)
+		{
+			EventCallback(this, Event, Result, StartValue, StartScale, EndValue, EndScale, CallbackInfo);
+		}
+	}
+
+	void SendLinkEvent(TELinkEvent Event, const std::string& Identifier)
+	{
+		if (LinkCallback)
+		{
+			LinkCallback(this, Event, Identifier.c_str(), CallbackInfo);
+		}
+	}
+
+	/** Must be called with DataMutex held */
+	FLink* FindLink(const char* Identifier)
+	{
+		if (!Identifier)
+		{
+			return nullptr;
+		}
+		const auto Found = LinksByIdentifier.find(Identifier);
+		return Found != LinksByIdentifier.end() ? Found->second : nullptr;
+	}
+
+	/** Must be called with DataMutex held */
+	const FGroup* FindGroup(const char* Identifier) const
+	{
+		for (const FGroup& Group : Groups)
+		{
+			if (Identifier && Group.Identifier == Identifier)
+			{
+				return &Group;
+			}
+		}
+		return nullptr;
+	}
+
+	/** Must be called with DataMutex held */
+	void ClearLinks()
+	{
+		Links.clear();
+		LinksByIdentifier.clear();
+		Groups.clear();
+	}
+
+	/** Must be called with DataMutex held */
+	void AddLinks(std::vector<std::unique_ptr<FLink>>&& NewLinks)
+	{
+		ClearLinks();
+		Links = std::move(NewLinks);
+		for (const std::unique_ptr<FLink>& Link : Links)
+		{
+			LinksByIdentifier[Link->Identifier] = Link.get();
+
+			auto Group = std::find_if(Groups.begin(), Groups.end(), [&Link](const FGroup& Existing) { return Existing.Identifier == Link->Group; });
+			if (Group == Groups.end())
+			{
+				const bool bIsParameter = Link->Info.domain == TELinkDomainParameter;
+				Groups.push_back({ Link->Group, bIsParameter ? "Parameters" : Link->Info.scope == TEScopeInput ? "Inputs" : "Outputs", Link->Info.scope, {} });
+				Group = std::prev(Groups.end());
+			}
+			Group->Children.push_back(Link->Identifier);
+
+			if (Link->Info.type == TELinkTypeFloatBuffer && Link->Info.scope == TEScopeOutput)
+			{
+				Link->FloatBufferValue.Adopt(TEFloatBufferCreate(-1.0, Link->SizeA, Link->SizeB, nullptr));
+			}
+		}
+	}
+
+	/** Updates the value of the output links for the given frame. Must be called with DataMutex held. Returns the identifiers of the links that changed. */
+	std::vector<std::string> UpdateOutputs(uint64_t Frame)
+	{
+		std::vector<std::string> Changed;
+		for (const std::unique_ptr<FLink>& Link : Links)
+		{
+			if (Link->Info.scope != TEScopeOutput || Link->Info.domain != TELinkDomainOperator)
+			{
+				continue;
+			}
+
+			const double Phase = static_cast<double>(Frame) / 60.0;
+			switch (Link->Info.type)
+			{
+			case TELinkTypeBoolean:
+				Link->BoolValue = (Frame & 1) != 0;
+				break;
+			case TELinkTypeDouble:
+				for (size_t Index = 0; Index < Link->DoubleValues.size(); ++Index)
+				{
+					Link->DoubleValues[Index] = std::sin(Phase + static_cast<double>(Index));
+				}
+				break;
+			case TELinkTypeInt:
+				std::fill(Link->IntValues.begin(), Link->IntValues.end(), static_cast<int32_t>(Frame));
+				break;
+			case TELinkTypeString:
+				Link->StringValue = "frame " + std::to_string(Frame);
+				break;
+			case TELinkTypeFloatBuffer:
+				{
+					// A new buffer every time, as the plugin may still be reading the previous one
+					TEFloatBuffer* Buffer = TEFloatBufferCreate(-1.0, Link->SizeA, Link->SizeB, nullptr);
+					for (int32_t Channel = 0; Channel < Link->SizeA; ++Channel)
+					{
+						std::vector<float>& Samples = Buffer->Values[Channel];
+						for (int32_t Sample = 0; Sample < Link->SizeB; ++Sample)
+						{
+							Samples[Sample] = static_cast<float>(std::sin(Phase + Channel + Sample * 0.1));
+						}
+					}
+					Buffer->Count = static_cast<uint32_t>(Link->SizeB);
+					Link->FloatBufferValue.Adopt(Buffer);
+					break;
+				}
+			case TELinkTypeStringData:
+				{
+					TETable* Table = TETableCreate();
+					TETableResize(Table, Link->SizeA, Link->SizeB);
+					for (int32_t Row = 0; Row < Link->SizeA; ++Row)
+					{
+						for (int32_t Column = 0; Column < Link->SizeB; ++Column)
+						{
+							*Table->GetCell(Row, Column) = std::to_string(Frame) + ":" + std::to_string(Row) + ":" + std::to_string(Column);
+						}
+					}
+					Link->TableValue.Adopt(Table);
+					break;
+				}
+			case TELinkTypeTexture:
+				Link->TextureValue.Adopt(CreateObject<FTextureBody>(TEObjectTypeTexture));
+				break;
+			default:
+				continue;
+			}
+
+			if (Link->Interest == TELinkInterestAll || Link->Interest == TELinkInterestSubsequentValues)
+			{
+				Link->Interest = TELinkInterestAll;
+				Changed.push_back(Link->Identifier);
+			}
+		}
+		return Changed;
+	}
+
+	/** Runs on the worker thread */
+	void CookFrame(int64_t TimeValue, int32_t TimeScale)
+	{
+		// 1. Simulate the cook, which can be interrupted by TEInstanceCancelFrame
+		const int64_t Jitter = CookJitterMicroseconds > 0 ? std::uniform_int_distribution<int64_t>(0, CookJitterMicroseconds)(Random) : 0;
+		const auto CookStart = std::chrono::steady_clock::now();
+		{
+			std::unique_lock<std::mutex> Lock(Worker->Mutex);
+			Worker->Condition.wait_for(Lock, std::chrono::microseconds(CookTimeMicroseconds + Jitter), [this]() { return bCancelFrame.load() || Worker->bExit; });
+		}
+		const int64_t CookNanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - CookStart).count();
+		const bool bCancelled = bCancelFrame.exchange(false);
+
+		// 2. Update the outputs, unless the frame was cancelled or is simulated as dropped
+		const uint64_t Frame = ++FramesStarted;
+		const bool bDropped = !bCancelled && DropInterval > 0 && Frame % DropInterval == 0;
+		std::vector<std::string> ChangedLinks;
+		{
+			std::lock_guard<std::mutex> Lock(DataMutex);
+			if (!bCancelled && !bDropped && ChangeInterval > 0 && Frame % ChangeInterval == 0)
+			{
+				ChangedLinks = UpdateOutputs(Frame);
+			}
+		}
+		for (const std::string& Identifier : ChangedLinks)
+		{
+			SendLinkEvent(TELinkEventValueChange, Identifier);
+		}
+
+		// 3. A dropped frame is reported with the start time of the previous frame, which is how TouchEngine reports it
+		const int64_t FrameDuration = std::max<int64_t>(1, static_cast<int64_t>(std::llround(TimeScale / std::max(FrameRate.load(), 0.001))));
+		const int64_t StartValue = bDropped && LastStartTimeValue >= 0 ? LastStartTimeValue : TimeValue;
+		LastStartTimeValue = StartValue;
+
+		FramesSinceStatistics += bCancelled ? 0 : 1;
+		FramesDroppedSinceStatistics += bDropped ? 1 : 0;
+		CookNanosecondsSinceStatistics += CookNanoseconds;
+		DeliverStatistics();
+
+		bFrameInProgress = false;
+		SendEvent(TEEventFrameDidFinish, bCancelled ? TEResultCancelled : TEResultSuccess, StartValue, TimeScale, StartValue + FrameDuration, TimeScale);
+	}
+
+	/** Sends the statistics about once per second, as TouchEngine does. Runs on the worker thread. */
+	void DeliverStatistics()
+	{
+		const auto Now = std::chrono::steady_clock::now();
+		const TEInstanceStatisticsCallback Callback = StatisticsCallback.load();
+		if (!Callback || Now - LastStatisticsTime < std::chrono::seconds(1))
+		{
+			return;
+		}
+
+		TEInstanceStatistics Statistics {};
+		Statistics.memUsedGPU = 0;
+		Statistics.memUsedCPU = 0;
+		Statistics.frameTimeCPU = FramesSinceStatistics > 0 ? CookNanosecondsSinceStatistics / FramesSinceStatistics : 0;
+		Statistics.frameTimeGPU = -1;
+		Statistics.frames = FramesSinceStatistics;
+		Statistics.framesDropped = FramesDroppedSinceStatistics;
+
+		FramesSinceStatistics = 0;
+		FramesDroppedSinceStatistics = 0;
+		CookNanosecondsSinceStatistics = 0;
+		LastStatisticsTime = Now;
+
+		Callback(this, &Statistics, CallbackInfo);
+	}
+
+	const TEInstanceEventCallback EventCallback;
+	const TEInstanceLinkCallback LinkCallback;
+	void* const CallbackInfo;
+	std::atomic<TEInstanceStatisticsCallback> StatisticsCallback { nullptr };
+
+	const int64_t CookTimeMicroseconds;
+	const int64_t CookJitterMicroseconds;
+	const int64_t ChangeInterval;
+	const int64_t DropInterval;
+	std::mt19937_64 Random;
+
+	/** Guards the configuration and the links */
+	std::mutex DataMutex;
+	std::string Path;
+	TETimeMode TimeMode = TETimeExternal;
+	TETextureOrigin OutputTextureOrigin = TETextureOriginTopLeft;
+	std::string AssetDirectory;
+	bool bLoaded = false;
+	std::vector<std::unique_ptr<FLink>> Links;
+	std::map<std::string, FLink*> LinksByIdentifier;
+	std::vector<FGroup> Groups;
+
+	std::atomic<double> FrameRate { 60.0 };
+	std::atomic<bool> bFrameInProgress { false };
+	std::atomic<bool> bCancelFrame { false };
+
+	// Only accessed from the worker thread
+	uint64_t FramesStarted = 0;
+	int64_t LastStartTimeValue = -1;
+	int64_t FramesSinceStatistics = 0;
+	int64_t FramesDroppedSinceStatistics = 0;
+	int64_t CookNanosecondsSinceStatistics = 0;
+	std::chrono::steady_clock::time_point LastStatisticsTime = std::chrono::steady_clock::now();
+
+	std::shared_ptr<FWorker> Worker;
+};
+
+namespace
+{
+	/** Locks the instance data and finds the link, or returns TEResultNoMatchingEntity */
+	template<typename TFunc>
+	TEResult WithLink(TEInstance* Instance, const char* Identifier, TFunc&& Func)
+	{
+		if (!Instance)
+		{
+			return TEResultBadUsage;
+		}
+		std::lock_guard<std::mutex> Lock(Instance->DataMutex);
+		FLink* Link = Instance->FindLink(Identifier);
+		return Link ? Func(*Link) : TEResultNoMatchingEntity;
+	}
+
+	bool IsValueReadable(const FLink& Link, TELinkValue Which)
+	{
+		// Outputs only have a current value, inputs also have a default one
+		return Which == TELinkValueCurrent || (Which == TELinkValueDefault && Link.Info.scope == TEScopeInput);
+	}
+}
+
+extern "C"
+{
+
+/*
+ * TEObject
+ */
+
+TEObject* TERetain(TEObject* object)
+{
+	return RetainObject(object);
+}
+
+void TERelease_(TEObject** object)
+{
+	if (object)
+	{
+		ReleaseObject(*object);
+		*object = nullptr;
+	}
+}
+
+TEObjectType TEGetType(const TEObject* object)
+{
+	return object ? GetHeader(object)->Type : TEObjectTypeUnknown;
+}
+
+/*
+ * TEResult
+ */
+
+const char* TEResultGetDescription(TEResult result)
+{
+	switch (result)
+	{
+	case TEResultSuccess: return "Success";
+	case TEResultInsufficientMemory: return "Insufficient memory";
+	case TEResultGPUAllocationFailed: return "GPU allocation failed";
+	case TEResultTextureFormatNotSupported: return "Texture format not supported";
+	case TEResultTextureComponentMapNotSupported: return "Texture component map not supported";
+	case TEResultExecutableError: return "TouchEngine crashed or stopped responding";
+	case TEResultInternalError: return "Internal error";
+	case TEResultMissingResource: return "Missing resource";
+	case TEResultDroppedSamples: return "Samples were dropped";
+	case TEResultMissedSamples: return "Insufficient samples were provided";
+	case TEResultBadUsage: return "Invalid arguments or improper call";
+	case TEResultNoMatchingEntity: return "No matching entity";
+	case TEResultCancelled: return "Cancelled";
+	case TEResultExpiredKey: return "Expired key";
+	case TEResultNoKey: return "No key";
+	case TEResultKeyError: return "Key error";
+	case TEResultFileError: return "File error";
+	case TEResultNewerFileVersion: return "Newer file version";
+	case TEResultTouchEngineNotFound: return "TouchEngine not found";
+	case TEResultTouchEngineBadPath: return "TouchEngine bad path";
+	case TEResultFailedToLaunchTouchEngine: return "Failed to launch TouchEngine";
+	case TEResultFeatureNotSupportedBySystem: return "Feature not supported by system";
+	case TEResultOlderEngineVersion: return "Older engine version";
+	case TEResultIncompatibleEngineVersion: return "Incompatible engine version";
+	case TEResultPermissionDenied: return "Permission denied";
+	case TEResultComponentErrors: return "The component reported errors";
+	case TEResultComponentWarnings: return "The component reported warnings";
+	default: return nullptr;
+	}
+}
+
+TESeverity TEResultGetSeverity(TEResult result)
+{
+	switch (result)
+	{
+	case TEResultSuccess:
+		return TESeverityNone;
+	case TEResultTextureComponentMapNotSupported:
+	case TEResultDroppedSamples:
+	case TEResultMissedSamples:
+	case TEResultCancelled:
+	case TEResultOlderEngineVersion:
+	case TEResultComponentWarnings:
+		return TESeverityWarning;
+	default:
+		return TESeverityError;
+	}
+}
+
+/*
+ * TEInstance lifecycle
+ */
+
+TEResult TEInstanceGetSupportedFileExtensions(TEStringArray** extensions)
+{
+	if (!extensions)
+	{
+		return TEResultBadUsage;
+	}
+	*extensions = CreateObject<FStringArrayBody>(TEObjectTypeStringArray, std::vector<std::string>{ "tox" });
+	return TEResultSuccess;
+}
+
+TEResult TEInstanceCreate(TEInstanceEventCallback event_callback, TEInstanceLinkCallback link_callback, void* callback_info, TEInstance** instance)
+{
+	if (!instance)
+	{
+		return TEResultBadUsage;
+	}
+	*instance = CreateObject<TEInstance_>(TEObjectTypeInstance, event_callback, link_callback, callback_info);
+	return TEResultSuccess;
+}
+
+TEResult TEInstanceConfigure(TEInstance* instance, const char* path, TETimeMode mode)
+{
+	if (!instance)
+	{
+		return TEResultBadUsage;
+	}
+
+	bool bWasLoaded;
+	{
+		std::lock_guard<std::mutex> Lock(instance->DataMutex);
+		instance->Path = path ? path : "";
+		instance->TimeMode = mode;
+		bWasLoaded = instance->bLoaded;
+		instance->bLoaded = false;
+		instance->ClearLinks();
+	}
+
+	instance->Enqueue([instance, bWasLoaded]()
+	{
+		if (bWasLoaded)
+		{
+			instance->SendEvent(TEEventInstanceDidUnload, TEResultSuccess);
+		}
+		instance->SendEvent(TEEventInstanceReady, TEResultSuccess);
+	});
+	return TEResultSuccess;
+}
+
+TEResult TEInstanceLoad(TEInstance* instance)
+{
+	if (!instance)
+	{
+		return TEResultBadUsage;
+	}
+
+	std::string Path;
+	{
+		std::lock_guard<std::mutex> Lock(instance->DataMutex);
+		Path = instance->Path;
+	}
+	if (Path.empty())
+	{
+		return TEResultBadUsage;
+	}
+
+	instance->Enqueue([instance, Path]()
+	{
+		// 1. The .tox itself can be a layout file, otherwise fall back to TE_STANDIN_LAYOUT, then to the default layout
+		std::string Layout;
+		if (!ReadFile(Path, Layout))
+		{
+			instance->SendEvent(TEEventInstanceDidLoad, TEResultFileError);
+			return;
+		}
+		if (Layout.compare(0, std::strlen(LayoutHeader), LayoutHeader) != 0)
+		{
+			const char* LayoutPath = std::getenv("TE_STANDIN_LAYOUT");
+			if (!LayoutPath || !*LayoutPath || !ReadFile(LayoutPath, Layout))
+			{
+				Layout = DefaultLayout;
+			}
+		}
+
+		std::vector<std::unique_ptr<FLink>> NewLinks;
+		if (!ParseLayout(Layout, NewLinks))
+		{
+			instance->SendEvent(TEEventInstanceDidLoad, TEResultFileError);
+			return;
+		}
+
+		// 2. Add the links, then let the caller know they are all there
+		std::vector<std::string> Added;
+		{
+			std::lock_guard<std::mutex> Lock(instance->DataMutex);
+			instance->AddLinks(std::move(NewLinks));
+			instance->bLoaded = true;
+			for (const FGroup& Group : instance->Groups)
+			{
+				Added.push_back(Group.Identifier);
+				Added.insert(Added.end(), Group.Children.begin(), Group.Children.end());
+			}
+		}
+		for (const std::string& Identifier : Added)
+		{
+			instance->SendLinkEvent(TELinkEventAdded, Identifier);
+		}
+		instance->SendEvent(TEEventInstanceDidLoad, TEResultSuccess);
+	});
+	return TEResultSuccess;
+}
+
+TEResult TEInstanceUnload(TEInstance* instance)
+{
+	if (!instance)
+	{
+		return TEResultBadUsage;
+	}
+
+	instance->bCancelFrame = true;
+	instance->Enqueue([instance]()
+	{
+		{
+			std::lock_guard<std::mutex> Lock(instance->DataMutex);
+			instance->bLoaded = false;
+			instance->ClearLinks();
+		}
+		instance->bCancelFrame = false;
+		instance->SendEvent(TEEventInstanceDidUnload, TEResultSuccess);
+	});
+	return TEResultSuccess;
+}
+
+bool TEInstanceHasFile(TEInstance* instance)
+{
+	if (!instance)
+	{
+		return false;
+	}
+	std::lock_guard<std::mutex> Lock(instance->DataMutex);
+	return !instance->Path.empty();
+}
+
+void TEInstanceGetPath(TEInstance* instance, TEString** string)
+{
+	if (!instance || !string)
+	{
+		return;
+	}
+	std::lock_guard<std::mutex> Lock(instance->DataMutex);
+	*string = instance->Path.empty() ? nullptr : CreateObject<FStringBody>(TEObjectTypeString, instance->Path);
+}
+
+TETimeMode TEInstanceGetTimeMode(TEInstance* instance)
+{
+	if (!instance)
+	{
+		return TETimeExternal;
+	}
+	std::lock_guard<std::mutex> Lock(instance->DataMutex);
+	return instance->TimeMode;
+}
+
+TEResult TEInstanceAssociateGraphicsContext(TEInstance* instance, TEGraphicsContext* /*context*/)
+{
+	// There is no GPU work to do, any context is accepted
+	return instance ? TEResultSuccess : TEResultBadUsage;
+}
+
+TEResult TEInstanceAssociateAdapter(TEInstance* instance, TEAdapter* /*adapter*/)
+{
+	return instance ? TEResultSuccess : TEResultBadUsage;
+}
+
+TEResult TEInstanceSetOutputTextureOrigin(TEInstance* instance, TETextureOrigin origin)
+{
+	if (!instance)
+	{
+		return TEResultBadUsage;
+	}
+	std::lock_guard<std::mutex> Lock(instance->DataMutex);
+	instance->OutputTextureOrigin = origin;
+	return TEResultSuccess;
+}
+
+TETextureOrigin TEInstanceGetOutputTextureOrigin(TEInstance* instance)
+{
+	if (!instance)
+	{
+		return TETextureOriginTopLeft;
+	}
+	std::lock_guard<std::mutex> Lock(instance->DataMutex);
+	return instance->OutputTextureOrigin;
+}
+
+TEResult TEInstanceResume(TEInstance* instance)
+{
+	return instance ? TEResultSuccess : TEResultBadUsage;
+}
+
+TEResult TEInstanceSuspend(TEInstance* instance)
+{
+	return instance ? TEResultSuccess : TEResultBadUsage;
+}
+
+TEResult TEInstanceSetFrameRate(TEInstance* instance, int64_t numerator, int32_t denominator)
+{
+	if (!instance || numerator <= 0 || denominator <= 0)
+	{
+		return TEResultBadUsage;
+	}
+	instance->FrameRate = static_cast<double>(numerator) / denominator;
+	return TEResultSuccess;
+}
+
+TEResult TEInstanceSetFloatFrameRate(TEInstance* instance, float rate)
+{
+	if (!instance || rate <= 0.f)
+	{
+		return TEResultBadUsage;
+	}
+	instance->FrameRate = rate;
+	return TEResultSuccess;
+}
+
+TEResult TEInstanceGetFrameRate(TEInstance* instance, int64_t* numerator, int32_t* denominator)
+{
+	if (!instance || !numerator || !denominator)
+	{
+		return TEResultBadUsage;
+	}
+	// Expressed in thousandths, which is exact for the integer and NTSC rates
+	*numerator = std::llround(instance->FrameRate.load() * 1000.0);
+	*denominator = 1000;
+	return TEResultSuccess;
+}
+
+TEResult TEInstanceGetFloatFrameRate(TEInstance* instance, float* rate)
+{
+	if (!instance || !rate)
+	{
+		return TEResultBadUsage;
+	}
+	*rate = static_cast<float>(instance->FrameRate.load());
+	return TEResultSuccess;
+}
+
+TEResult TEInstanceSetStatisticsCallback(TEInstance* instance, TEInstanceStatisticsCallback callback)
+{
+	if (!instance)
+	{
+		return TEResultBadUsage;
+	}
+	instance->StatisticsCallback = callback;
+	return TEResultSuccess;
+}
+
+void TEInstanceGetAssetDirectory(TEInstance* instance, TEString** string)
+{
+	if (!instance || !string)
+	{
+		return;
+	}
+	std::lock_guard<std::mutex> Lock(instance->DataMutex);
+	*string = instance->AssetDirectory.empty() ? nullptr : CreateObject<FStringBody>(TEObjectTypeString, instance->AssetDirectory);
+}
+
+TEResult TEInstanceSetAssetDirectory(TEInstance* instance, const char* path)
+{
+	if (!instance)
+	{
+		return TEResultBadUsage;
+	}
+	std::lock_guard<std::mutex> Lock(instance->DataMutex);
+	instance->AssetDirectory = path ? path : "";
+	return TEResultSuccess;
+}
+
+/*
+ * Textures and semaphores. There is no GPU: transfers are accepted and never reported back.
+ */
+
+TEResult TEInstanceGetSupportedTextureTypes(TEInstance* instance, TETextureType types[], int32_t* count)
+{
+	if (!instance || !count)
+	{
+		return TEResultBadUsage;
+	}
+	static constexpr TETextureType Supported[] = { TETextureTypeD3DShared, TETextureTypeVulkan };
+	const int32_t Available = static_cast<int32_t>(sizeof(Supported) / sizeof(Supported[0]));
+	if (types)
+	{
+		std::copy_n(Supported, std::min(*count, Available), types);
+	}
+	const bool bEnoughSpace = !types || *count >= Available;
+	*count = Available;
+	return bEnoughSpace ? TEResultSuccess : TEResultInsufficientMemory;
+}
+
+TEResult TEInstanceGetSupportedTextureFormats(TEInstance* instance, TETextureFormat formats[], int32_t* count)
+{
+	if (!instance || !count)
+	{
+		return TEResultBadUsage;
+	}
+	static constexpr TETextureFormat Supported[] = { TETextureFormatR8Unorm, TETextureFormatRG8Unorm, TETextureFormatRGBA8Unorm, TETextureFormatBGRA8Unorm, TETextureFormatSRGBA8Unorm, TETextureFormatSBGRA8Unorm, TETextureFormatR16F, TETextureFormatRGBA16F, TETextureFormatR32F, TETextureFormatRGBA32F };
+	const int32_t Available = static_cast<int32_t>(sizeof(Supported) / sizeof(Supported[0]));
+	if (formats)
+	{
+		std::copy_n(Supported, std::min(*count, Available), formats);
+	}
+	const bool bEnoughSpace = !formats || *count >= Available;
+	*count = Available;
+	return bEnoughSpace ? TEResultSuccess : TEResultInsufficientMemory;
+}
+
+TEResult TEInstanceGetSupportedSemaphoreTypes(TEInstance* instance, TESemaphoreType /*types*/[], int32_t* count)
+{
+	if (!instance || !count)
+	{
+		return TEResultBadUsage;
+	}
+	*count = 0;
+	return TEResultSuccess;
+}
+
+bool TEInstanceDoesTextureOwnershipTransfer(TEInstance* /*instance*/)
+{
+	return false;
+}
+
+TEResult TEInstanceAddTextureTransfer(TEInstance* instance, TETexture* texture, TESemaphore* /*semaphore*/, uint64_t /*value*/)
+{
+	return instance && texture ? TEResultSuccess : TEResultBadUsage;
+}
+
+bool TEInstanceHasTextureTransfer(TEInstance* /*instance*/, const TETexture* /*texture*/)
+{
+	return false;
+}
+
+TEResult TEInstanceGetTextureTransfer(TEInstance* /*instance*/, const TETexture* /*texture*/, TESemaphore** semaphore, uint64_t* /*waitValue*/)
+{
+	if (semaphore)
+	{
+		*semaphore = nullptr;
+	}
+	return TEResultNoMatchingEntity;
+}
+
+TETextureType TETextureGetType(const TETexture* texture)
+{
+	return texture && TEGetType(texture) == TEObjectTypeTexture ? static_cast<const FTextureBody*>(texture)->Type : TETextureTypeD3DShared;
+}
+
+TETextureOrigin TETextureGetOrigin(const TETexture* texture)
+{
+	return texture && TEGetType(texture) == TEObjectTypeTexture ? static_cast<const FTextureBody*>(texture)->Origin : TETextureOriginTopLeft;
+}
+
+TETextureComponentMap TETextureGetComponentMap(TETexture* /*texture*/)
+{
+	return kTETextureComponentMapIdentity;
+}
+
+/*
+ * Frames
+ */
+
+TEResult TEInstanceStartFrameAtTime(TEInstance* instance, int64_t time_value, int32_t time_scale, bool /*discontinuity*/)
+{
+	if (!instance || time_scale <= 0)
+	{
+		return TEResultBadUsage;
+	}
+	{
+		std::lock_guard<std::mutex> Lock(instance->DataMutex);
+		if (!instance->bLoaded)
+		{
+			return TEResultBadUsage;
+		}
+	}
+
+	bool bExpected = false;
+	if (!instance->bFrameInProgress.compare_exchange_strong(bExpected, true))
+	{
+		// Only one frame can be requested at a time
+		return TEResultBadUsage;
+	}
+
+	instance->Enqueue([instance, time_value, time_scale]()
+	{
+		instance->CookFrame(time_value, time_scale);
+	});
+	return TEResultSuccess;
+}
+
+TEResult TEInstanceCancelFrame(TEInstance* instance)
+{
+	if (!instance)
+	{
+		return TEResultBadUsage;
+	}
+	if (!instance->bFrameInProgress)
+	{
+		return TEResultNoMatchingEntity;
+	}
+
+	{
+		std::lock_guard<std::mutex> Lock(instance->Worker->Mutex);
+		instance->bCancelFrame = true;
+	}
+	instance->Worker->Condition.notify_all();
+	return TEResultSuccess;
+}
+
+TEResult TEInstanceGetErrors(TEInstance* instance, TEErrorArray** errors)
+{
+	if (!instance || !errors)
+	{
+		return TEResultBadUsage;
+	}
+	*errors = CreateObject<FErrorArrayBody>(TEObjectTypeErrorArray);
+	return TEResultSuccess;
+}
+
+/*
+ * Link layout
+ */
+
+TEResult TEInstanceGetLinkGroups(TEInstance* instance, TEScope scope, TEStringArray** groups)
+{
+	if (!instance || !groups)
+	{
+		return TEResultBadUsage;
+	}
+	std::lock_guard<std::mutex> Lock(instance->DataMutex);
+	std::vector<std::string> Identifiers;
+	for (const FGroup& Group : instance->Groups)
+	{
+		if (Group.Scope == scope)
+		{
+			Identifiers.push_back(Group.Identifier);
+		}
+	}
+	*groups = CreateObject<FStringArrayBody>(TEObjectTypeStringArray, std::move(Identifiers));
+	return TEResultSuccess;
+}
+
+TEResult TEInstanceLinkGetChildren(TEInstance* instance, const char* identifier, TEStringArray** children)
+{
+	if (!instance || !children)
+	{
+		return TEResultBadUsage;
+	}
+	std::lock_guard<std::mutex> Lock(instance->DataMutex);
+	if (const FGroup* Group = instance->FindGroup(identifier))
+	{
+		*children = CreateObject<FStringArrayBody>(TEObjectTypeStringArray, Group->Children);
+		return TEResultSuccess;
+	}
+	if (instance->FindLink(identifier))
+	{
+		*children = CreateObject<FStringArrayBody>(TEObjectTypeStringArray, std::vector<std::string>());
+		return TEResultSuccess;
+	}
+	return TEResultNoMatchingEntity;
+}
+
+TEResult TEInstanceLinkGetParent(TEInstance* instance, const char* identifier, TEString** string)
+{
+	return WithLink(instance, identifier, [string](FLink& Link)
+	{
+		if (!string)
+		{
+			return TEResultBadUsage;
+		}
+		*string = CreateObject<FStringBody>(TEObjectTypeString, Link.Group);
+		return TEResultSuccess;
+	});
+}
+
+TEResult TEInstanceLinkGetInfo(TEInstance* instance, const char* identifier, TELinkInfo** info)
+{
+	if (!instance || !info)
+	{
+		return TEResultBadUsage;
+	}
+	std::lock_guard<std::mutex> Lock(instance->DataMutex);
+	if (const FGroup* Group = instance->FindGroup(identifier))
+	{
+		TELinkInfo GroupInfo {};
+		GroupInfo.scope = Group->Scope;
+		GroupInfo.intent = TELinkIntentNotSpecified;
+		GroupInfo.type = TELinkTypeGroup;
+		GroupInfo.domain = TELinkDomainNone;
+		GroupInfo.count = static_cast<int32_t>(Group->Children.size());
+		*info = CreateObject<FLinkInfoBody>(TEObjectTypeLinkInfo, GroupInfo, Group->Label, Group->Label, Group->Identifier);
+		return TEResultSuccess;
+	}
+	if (const FLink* Link = instance->FindLink(identifier))
+	{
+		*info = CreateObject<FLinkInfoBody>(TEObjectTypeLinkInfo, Link->Info, Link->Name, Link->Name, Link->Identifier);
+		return TEResultSuccess;
+	}
+	return TEResultNoMatchingEntity;
+}
+
+TEResult TEInstanceLinkGetState(TEInstance* instance, const char* identifier, TELinkState** state)
+{
+	return WithLink(instance, identifier, [state](FLink&)
+	{
+		if (!state)
+		{
+			return TEResultBadUsage;
+		}
+		TELinkState* NewState = CreateObject<TELinkState>(TEObjectTypeLinkState);
+		NewState->enabled = true;
+		NewState->editable = true;
+		*state = NewState;
+		return TEResultSuccess;
+	});
+}
+
+bool TEInstanceLinkHasChoices(TEInstance* /*instance*/, const char* /*identifier*/)
+{
+	return false;
+}
+
+TEResult TEInstanceLinkGetChoiceLabels(TEInstance* instance, const char* identifier, TEStringArray** labels)
+{
+	if (labels)
+	{
+		*labels = nullptr;
+	}
+	return WithLink(instance, identifier, [](FLink&) { return TEResultNoMatchingEntity; });
+}
+
+TEResult TEInstanceLinkGetChoiceValues(TEInstance* instance, const char* identifier, TEStringArray** values)
+{
+	if (values)
+	{
+		*values = nullptr;
+	}
+	return WithLink(instance, identifier, [](FLink&) { return TEResultNoMatchingEntity; });
+}
+
+bool TEInstanceLinkHasUserTint(TEInstance* /*instance*/, const char* /*identifier*/)
+{
+	return false;
+}
+
+TEResult TEInstanceLinkGetUserTint(TEInstance* /*instance*/, const char* /*identifier*/, TEColor* /*tint*/)
+{
+	return TEResultNoMatchingEntity;
+}
+
+TEResult TEInstanceLinkSetInterest(TEInstance* instance, const char* identifier, TELinkInterest interest)
+{
+	return WithLink(instance, identifier, [interest](FLink& Link)
+	{
+		Link.Interest = interest;
+		return TEResultSuccess;
+	});
+}
+
+TELinkInterest TEInstanceLinkGetInterest(TEInstance* instance, const char* identifier)
+{
+	TELinkInterest Interest = TELinkInterestNone;
+	WithLink(instance, identifier, [&Interest](FLink& Link)
+	{
+		Interest = Link.Interest;
+		return TEResultSuccess;
+	});
+	return Interest;
+}
+
+/*
+ * Link values
+ */
+
+bool TEInstanceLinkHasValue(TEInstance* instance, const char* identifier, TELinkValue which, int32_t index)
+{
+	// There are no ranges in the simulated component, only default and current values
+	bool bHasValue = false;
+	WithLink(instance, identifier, [which, index, &bHasValue](FLink& Link)
+	{
+		bHasValue = index >= 0 && index < Link.Info.count && IsValueReadable(Link, which);
+		return TEResultSuccess;
+	});
+	return bHasValue;
+}
+
+TEResult TEInstanceLinkGetBooleanValue(TEInstance* instance, const char* identifier, TELinkValue which, bool* value)
+{
+	return WithLink(instance, identifier, [which, value](FLink& Link)
+	{
+		if (Link.Info.type != TELinkTypeBoolean || !value)
+		{
+			return TEResultBadUsage;
+		}
+		*value = which == TELinkValueMaximum || which == TELinkValueUIMaximum ? true : which == TELinkValueCurrent && Link.BoolValue;
+		return TEResultSuccess;
+	});
+}
+
+TEResult TEInstanceLinkGetDoubleValue(TEInstance* instance, const char* identifier, TELinkValue which, double* value, int32_t count)
+{
+	return WithLink(instance, identifier, [which, value, count](FLink& Link)
+	{
+		if (Link.Info.type != TELinkTypeDouble)
+		{
+			return TEResultBadUsage;
+		}
+		return which == TELinkValueCurrent ? CopyValues(Link.DoubleValues, value, count) : CopyValues(std::vector<double>(Link.DoubleValues.size(), 0.0), value, count);
+	});
+}
+
+TEResult TEInstanceLinkGetIntValue(TEInstance* instance, const char* identifier, TELinkValue which, int32_t* value, int32_t count)
+{
+	return WithLink(instance, identifier, [which, value, count](FLink& Link)
+	{
+		if (Link.Info.type != TELinkTypeInt)
+		{
+			return TEResultBadUsage;
+		}
+		return which == TELinkValueCurrent ? CopyValues(Link.IntValues, value, count) : CopyValues(std::vector<int32_t>(Link.IntValues.size(), 0), value, count);
+	});
+}
+
+TEResult TEInstanceLinkGetStringValue(TEInstance* instance, const char* identifier, TELinkValue which, TEString** string)
+{
+	return WithLink(instance, identifier, [which, string](FLink& Link)
+	{
+		if ((Link.Info.type != TELinkTypeString && Link.Info.type != TELinkTypeStringData) || !string)
+		{
+			return TEResultBadUsage;
+		}
+		*string = CreateObject<FStringBody>(TEObjectTypeString, which == TELinkValueCurrent ? Link.StringValue : std::string());
+		return TEResultSuccess;
+	});
+}
+
+TEResult TEInstanceLinkGetTextureValue(TEInstance* instance, const char* identifier, TELinkValue which, TETexture** value)
+{
+	return WithLink(instance, identifier, [which, value](FLink& Link)
+	{
+		if (Link.Info.type != TELinkTypeTexture || !value)
+		{
+			return TEResultBadUsage;
+		}
+		*value = which == TELinkValueCurrent ? Link.TextureValue.Share() : nullptr;
+		return TEResultSuccess;
+	});
+}
+
+TEResult TEInstanceLinkGetTableValue(TEInstance* instance, const char* identifier, TELinkValue which, TETable** value)
+{
+	return WithLink(instance, identifier, [which, value](FLink& Link)
+	{
+		if (Link.Info.type != TELinkTypeStringData || !value)
+		{
+			return TEResultBadUsage;
+		}
+		*value = which == TELinkValueCurrent ? Link.TableValue.Share() : nullptr;
+		return *value ? TEResultSuccess : TEResultNoMatchingEntity;
+	});
+}
+
+TEResult TEInstanceLinkGetFloatBufferValue(TEInstance* instance, const char* identifier, TELinkValue which, TEFloatBuffer** value)
+{
+	return WithLink(instance, identifier, [which, value](FLink& Link)
+	{
+		if (Link.Info.type != TELinkTypeFloatBuffer || !value)
+		{
+			return TEResultBadUsage;
+		}
+		// Float buffers have no default value
+		*value = which == TELinkValueCurrent ? Link.FloatBufferValue.Share() : nullptr;
+		return *value ? TEResultSuccess : TEResultNoMatchingEntity;
+	});
+}
+
+TEResult TEInstanceLinkGetObjectValue(TEInstance* instance, const char* identifier, TELinkValue /*which*/, TEObject** value)
+{
+	if (value)
+	{
+		*value = nullptr;
+	}
+	return WithLink(instance, identifier, [](FLink&) { return TEResultBadUsage; });
+}
+
+TEResult TEInstanceLinkSetBooleanValue(TEInstance* instance, const char* identifier, bool value)
+{
+	return WithLink(instance, identifier, [value](FLink& Link)
+	{
+		if (Link.Info.type != TELinkTypeBoolean || Link.Info.scope != TEScopeInput)
+		{
+			return TEResultBadUsage;
+		}
+		Link.BoolValue = value;
+		return TEResultSuccess;
+	});
+}
+
+TEResult TEInstanceLinkSetDoubleValue(TEInstance* instance, const char* identifier, const double* value, int32_t count)
+{
+	return WithLink(instance, identifier, [value, count](FLink& Link)
+	{
+		if (Link.Info.type != TELinkTypeDouble || Link.Info.scope != TEScopeInput || !value || count < 0 || count > Link.Info.count)
+		{
+			return TEResultBadUsage;
+		}
+		std::copy_n(value, count, Link.DoubleValues.begin());
+		return TEResultSuccess;
+	});
+}
+
+TEResult TEInstanceLinkSetIntValue(TEInstance* instance, const char* identifier, const int32_t* value, int32_t count)
+{
+	return WithLink(instance, identifier, [value, count](FLink& Link)
+	{
+		if (Link.Info.type != TELinkTypeInt || Link.Info.scope != TEScopeInput || !value || count < 0 || count > Link.Info.count)
+		{
+			return TEResultBadUsage;
+		}
+		std::copy_n(value, count, Link.IntValues.begin());
+		return TEResultSuccess;
+	});
+}
+
+TEResult TEInstanceLinkSetStringValue(TEInstance* instance, const char* identifier, const char* value)
+{
+	return WithLink(instance, identifier, [value](FLink& Link)
+	{
+		if ((Link.Info.type != TELinkTypeString && Link.Info.type != TELinkTypeStringData) || Link.Info.scope != TEScopeInput)
+		{
+			return TEResultBadUsage;
+		}
+		Link.StringValue = value ? value : "";
+		return TEResultSuccess;
+	});
+}
+
+TEResult TEInstanceLinkSetTextureValue(TEInstance* instance, const char* identifier, TETexture* texture, TEGraphicsContext* /*context*/)
+{
+	return WithLink(instance, identifier, [texture](FLink& Link)
+	{
+		if (Link.Info.type != TELinkTypeTexture || Link.Info.scope != TEScopeInput)
+		{
+			return TEResultBadUsage;
+		}
+		Link.TextureValue.Set(texture);
+		return TEResultSuccess;
+	});
+}
+
+TEResult TEInstanceLinkSetFloatBufferValue(TEInstance* instance, const char* identifier, const TEFloatBuffer* buffer)
+{
+	return WithLink(instance, identifier, [buffer](FLink& Link)
+	{
+		if (Link.Info.type != TELinkTypeFloatBuffer || Link.Info.scope != TEScopeInput)
+		{
+			return TEResultBadUsage;
+		}
+		Link.FloatBufferValue.Set(const_cast<TEFloatBuffer*>(buffer));
+		return TEResultSuccess;
+	});
+}
+
+TEResult TEInstanceLinkAddFloatBuffer(TEInstance* instance, const char* identifier, const TEFloatBuffer* buffer)
+{
+	// Samples are not accumulated: the last buffer added is the value of the link
+	return TEInstanceLinkSetFloatBufferValue(instance, identifier, buffer);
+}
+
+TEResult TEInstanceLinkSetTableValue(TEInstance* instance, const char* identifier, const TETable* table)
+{
+	return WithLink(instance, identifier, [table](FLink& Link)
+	{
+		if (Link.Info.type != TELinkTypeStringData || Link.Info.scope != TEScopeInput)
+		{
+			return TEResultBadUsage;
+		}
+		Link.TableValue.Set(const_cast<TETable*>(table));
+		return TEResultSuccess;
+	});
+}
+
+TEResult TEInstanceLinkSetObjectValue(TEInstance* instance, const char* identifier, TEObject* /*object*/)
+{
+	return WithLink(instance, identifier, [](FLink&) { return TEResultBadUsage; });
+}
+
+/*
+ * TEFloatBuffer
+ */
+
+TEFloatBuffer* TEFloatBufferCreate(double rate, int32_t channels, uint32_t capacity, const char* const* names)
+{
+	return CreateObject<TEFloatBuffer_>(TEObjectTypeFloatBuffer, rate, channels, capacity, names, false);
+}
+
+TEFloatBuffer* TEFloatBufferCreateTimeDependent(double rate, int32_t channels, uint32_t capacity, const char* const* names)
+{
+	return CreateObject<TEFloatBuffer_>(TEObjectTypeFloatBuffer, rate, channels, capacity, names, true);
+}
+
+TEFloatBuffer* TEFloatBufferCreateCopy(const TEFloatBuffer* buffer)
+{
+	return buffer ? CreateObject<TEFloatBuffer_>(TEObjectTypeFloatBuffer, *buffer) : nullptr;
+}
+
+TEResult TEFloatBufferSetValues(TEFloatBuffer* buffer, const float** values, uint32_t count)
+{
+	if (!buffer || !values || count > buffer->Capacity)
+	{
+		return TEResultBadUsage;
+	}
+	for (size_t Channel = 0; Channel < buffer->Values.size(); ++Channel)
+	{
+		std::copy_n(values[Channel], count, buffer->Values[Channel].begin());
+	}
+	buffer->Count = count;
+	return TEResultSuccess;
+}
+
+TEResult TEFloatBufferSetStartTime(TEFloatBuffer* buffer, int64_t start)
+{
+	if (!buffer || !buffer->bTimeDependent)
+	{
+		return TEResultBadUsage;
+	}
+	buffer->StartTime = start;
+	return TEResultSuccess;
+}
+
+const float* const* TEFloatBufferGetValues(const TEFloatBuffer* buffer)
+{
+	return buffer && !buffer->ValuePointers.empty() ? buffer->ValuePointers.data() : nullptr;
+}
+
+bool TEFloatBufferIsTimeDependent(const TEFloatBuffer* buffer)
+{
+	return buffer && buffer->bTimeDependent;
+}
+
+int64_t TEFloatBufferGetStartTime(const TEFloatBuffer* buffer)
+{
+	return buffer ? buffer->StartTime : 0;
+}
+
+int64_t TEFloatBufferGetEndTime(const TEFloatBuffer* buffer)
+{
+	return buffer ? buffer->StartTime + buffer->Count : 0;
+}
+
+uint32_t TEFloatBufferGetCapacity(const TEFloatBuffer* buffer)
+{
+	return buffer ? buffer->Capacity : 0;
+}
+
+double TEFloatBufferGetRate(const TEFloatBuffer* buffer)
+{
+	return buffer ? buffer->Rate : -1.0;
+}
+
+int32_t TEFloatBufferGetChannelCount(const TEFloatBuffer* buffer)
+{
+	return buffer ? static_cast<int32_t>(buffer->Values.size()) : 0;
+}
+
+uint32_t TEFloatBufferGetValueCount(const TEFloatBuffer* buffer)
+{
+	return buffer ? buffer->Count : 0;
+}
+
+const char* const* TEFloatBufferGetChannelNames(const TEFloatBuffer* buffer)
+{
+	if (!buffer || std::all_of(buffer->Names.begin(), buffer->Names.end(), [](const std::string& Name) { return Name.empty(); }))
+	{
+		return nullptr;
+	}
+	return buffer->NamePointers.data();
+}
+
+TEFloatBufferExtend TEFloatBufferGetExtendBefore(const TEFloatBuffer* buffer)
+{
+	return buffer ? buffer->ExtendBefore : TEFloatBufferExtendHold;
+}
+
+TEFloatBufferExtend TEFloatBufferGetExtendAfter(const TEFloatBuffer* buffer)
+{
+	return buffer ? buffer->ExtendAfter : TEFloatBufferExtendHold;
+}
+
+float TEFloatBufferGetExtendConstantValue(const TEFloatBuffer* buffer)
+{
+	return buffer ? buffer->ExtendConstant : 0.f;
+}
+
+void TEFloatBufferSetExtend(TEFloatBuffer* buffer, TEFloatBufferExtend before, TEFloatBufferExtend after, float constant)
+{
+	if (buffer)
+	{
+		buffer->ExtendBefore = before;
+		buffer->ExtendAfter = after;
+		buffer->ExtendConstant = constant;
+	}
+}
+
+/*
+ * TETable
+ */
+
+TETable* TETableCreate(void)
+{
+	return CreateObject<TETable_>(TEObjectTypeTable);
+}
+
+TETable* TETableCreateCopy(const TETable* table)
+{
+	return table ? CreateObject<TETable_>(TEObjectTypeTable, *table) : nullptr;
+}
+
+int32_t TETableGetRowCount(const TETable* table)
+{
+	return table ? table->Rows : 0;
+}
+
+int32_t TETableGetColumnCount(const TETable* table)
+{
+	return table ? table->Columns : 0;
+}
+
+const char* TETableGetStringValue(const TETable* table, int32_t row, int32_t column)
+{
+	if (!table)
+	{
+		return nullptr;
+	}
+	const std::string* Cell = const_cast<TETable*>(table)->GetCell(row, column);
+	return Cell ? Cell->c_str() : nullptr;
+}
+
+void TETableResize(TETable* table, int32_t rows, int32_t columns)
+{
+	if (!table || rows < 0 || columns < 0)
+	{
+		return;
+	}
+
+	// Keep the existing cells where they are
+	std::vector<std::string> Cells(static_cast<size_t>(rows) * columns);
+	for (int32_t Row = 0; Row < std::min(rows, table->Rows); ++Row)
+	{
+		for (int32_t Column = 0; Column < std::min(columns, table->Columns); ++Column)
+		{
+			Cells[static_cast<size_t>(Row) * columns + Column] = std::move(table->Cells[static_cast<size_t>(Row) * table->Columns + Column]);
+		}
+	}
+	table->Rows = rows;
+	table->Columns = columns;
+	table->Cells = std::move(Cells);
+}
+
+TEResult TETableSetStringValue(TETable* table, int32_t row, int32_t column, const char* value)
+{
+	std::string* Cell = table ? table->GetCell(row, column) : nullptr;
+	if (!Cell)
+	{
+		return TEResultBadUsage;
+	}
+	*Cell = value ? value : "";
+	return TEResultSuccess;
+}
+
+}
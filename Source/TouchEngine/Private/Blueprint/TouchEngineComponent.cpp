@@ -18,10 +18,13 @@
 #include "Editor.h" // used to access GEditor and especially GEditor->IsSimulatingInEditor()
 #endif
 
+#include "Logging.h"
 #include "ToxAsset.h"
 #include "Engine/TouchEngineInfo.h"
 #include "Engine/TouchEngineSubsystem.h"
 #include "Engine/Util/CookFrameData.h"
+#include "Engine/Util/TouchCookStats.h"
+#include "Engine/Util/TouchCookTimeline.h"
 
 #include "Engine/Engine.h"
 #include "Misc/CoreDelegates.h"
@@ -29,6 +32,7 @@
 #include "Misc/Paths.h"
 #include "Tasks/Task.h"
 #include "Util/TouchEngineStatsGroup.h"
+#include "Util/TouchEngineTrace.h"
 #include "Util/TouchHelpers.h"
 #include "RenderingThread.h"
 #include "Engine/TEDebug.h"
@@ -38,6 +42,11 @@
 
 DEFINE_LOG_CATEGORY(LogTouchEngineComponent)
 
+/** The weight of the newest sample in the moving averages the backpressure is derived from */
+static constexpr double BackpressureAveragingWeight = 0.1;
+/** The number of seconds the backpressure needs to stay lower before it is lowered */
+static constexpr double BackpressureLoweringDelay = 0.5;
+
 void UTouchEngineComponentBase::BroadcastOnToxStartedLoading(bool bInSkipBlueprintEvent)
 {
 	OnToxStartedLoading_Native.Broadcast(); // the native event should always broadcast as it affects UI
@@ -167,6 +176,25 @@ void UTouchEngineComponentBase::BroadcastOnEndFrame(ECookFrameResult Result, con
 	}
 }
 
+void UTouchEngineComponentBase::BroadcastOnBackpressureChanged() const
+{
+	OnBackpressureChanged_Native.Broadcast(Backpressure);
+	
+#if WITH_EDITOR
+	const bool bCanBroadcastEvents = HasBegunPlay() || bAllowRunningInEditor;
+#else
+	const bool bCanBroadcastEvents = HasBegunPlay();
+#endif
+
+	if (bCanBroadcastEvents)
+	{
+#if WITH_EDITOR
+		FEditorScriptExecutionGuard ScriptGuard;
+#endif
+		OnBackpressureChanged.Broadcast(Backpressure);
+	}
+}
+
 void UTouchEngineComponentBase::BroadcastCustomBeginPlay() const
 {
 #if WITH_EDITOR
@@ -335,6 +363,31 @@ bool UTouchEngineComponentBase::KeepFrameTexture(UTexture2D* FrameTexture, UText
 	return false;
 }
 
+bool UTouchEngineComponentBase::GetObservedTextureDescriptors(TArray<FTouchEngineTextureDescriptor>& ExportedTextures, TArray<FTouchEngineTextureDescriptor>& ImportedTextures) const
+{
+	ExportedTextures.Reset();
+	ImportedTextures.Reset();
+	if (EngineInfo && EngineInfo->Engine && EngineInfo->Engine->IsReadyToCookFrame())
+	{
+		return EngineInfo->Engine->GetObservedTextureDescriptors(ImportedTextures, ExportedTextures);
+	}
+	return false;
+}
+
+FTouchEngineStatistics UTouchEngineComponentBase::GetTouchEngineStatistics() const
+{
+	if (EngineInfo && EngineInfo->Engine)
+	{
+		return EngineInfo->Engine->GetStatistics();
+	}
+	return FTouchEngineStatistics();
+}
+
+int32 UTouchEngineComponentBase::GetNumPendingCooks() const
+{
+	return EngineInfo && EngineInfo->Engine ? EngineInfo->Engine->GetNumPendingCooks() : 0;
+}
+
 void UTouchEngineComponentBase::BeginDestroy()
 {
 	ReleaseResources(EReleaseTouchResources::KillProcess);
@@ -613,9 +666,50 @@ void UTouchEngineComponentBase::TickComponent(float DeltaTime, ELevelTick TickTy
 	// for every Cook Mode we do the same thing
 	static double StartTime = GStartTime;
 	const double Now = FPlatformTime::Seconds();
-	UE_LOG(LogTouchEngineComponent, Log, TEXT("  ====== ====== ====== ====== ------ ------ ====== ====== TickComponent ====== ====== ------ ------ ====== ====== ====== ======  %f"), Now - StartTime)
+	UE_LOG_TOUCHENGINE_HOT_PATH(Log, TEXT("  ====== ====== ====== ====== ------ ------ ====== ====== TickComponent ====== ====== ------ ------ ====== ====== ====== ======  %f"), Now - StartTime);
 	StartTime = Now;
-	StartNewCook(DeltaTime);
+	
+	// Ticks faster than the CookRate only accumulate the input changes and the elapsed time, which are sent with the next cook
+	if (ShouldRequestCook_GameThread(DeltaTime))
+	{
+		StartNewCook(TimeSinceLastCookRequest);
+		TimeSinceLastCookRequest = 0.f;
+	}
+	else
+	{
+		EngineInfo->CheckIfCookTimedOut_GameThread(CookTimeout);
+	}
+}
+
+bool UTouchEngineComponentBase::ShouldRequestCook_GameThread(float DeltaTime)
+{
+	TimeSinceLastCookRequest += DeltaTime;
+	const double CookInterval = GetCookInterval();
+	if (CookInterval <= 0.0)
+	{
+		return true;
+	}
+
+	// We request the cook on the tick closest to when it is due, and carry the difference over so the average rate matches the CookRate
+	CookRateAccumulator += DeltaTime;
+	if (CookRateAccumulator + DeltaTime * 0.5 < CookInterval)
+	{
+		return false;
+	}
+	// After a hitch, we do not try to catch up with a burst of cooks
+	CookRateAccumulator = FMath::Min(CookRateAccumulator - CookInterval, CookInterval * 0.5);
+	return true;
+}
+
+double UTouchEngineComponentBase::GetCookInterval() const
+{
+	switch (CookRate)
+	{
+	case ETouchEngineCookRate::TouchEngineFrameRate: return EngineInfo && EngineInfo->Engine ? EngineInfo->Engine->GetFrameRate().AsInterval() : 1.0 / TEFrameRate; // The engine has the exact rational rate
+	case ETouchEngineCookRate::Custom: return CustomCookRate > 0.f ? 1.0 / CustomCookRate : 0.0;
+	case ETouchEngineCookRate::EveryTick:
+	default: return 0.0;
+	}
 }
 
 void UTouchEngineComponentBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
@@ -813,9 +907,17 @@ void UTouchEngineComponentBase::StartNewCook(float DeltaTime)
 
 	// 1. First, we get a new frame ID and we set the inputs
 	FTouchEngineInputFrameData InputFrameData{EngineInfo->Engine->GetNextFrameID()};
+#if UE_TRACE_ENABLED
+	// The path tells apart the components of the same actor. It is only used to tag the trace events, so we only build it when they are traced
+	if (UE_TRACE_CHANNELEXPR_IS_ENABLED(TouchEngineChannel))
+	{
+		InputFrameData.ComponentName = FName(GetPathName());
+	}
+#endif
+	TOUCHENGINE_TRACE_BEGIN_COOK(InputFrameData);
 
-	UE_LOG(LogTouchEngineComponent, Log, TEXT("[StartNewCook[%s]] ------ Starting new Cook [Frame No %lld] ------"), *GetCurrentThreadStr(), InputFrameData.FrameID)
-	UE_LOG(LogTouchEngineComponent, Verbose, TEXT("[StartNewCook[%s]] Calling `VarsOnStartFrame` for frame %lld"), *GetCurrentThreadStr(), InputFrameData.FrameID)
+	UE_LOG_TOUCHENGINE_HOT_PATH(Log, TEXT("[StartNewCook[%s]] ------ Starting new Cook [Frame No %lld] ------"), *GetCurrentThreadStr(), InputFrameData.FrameID);
+	UE_LOG_TOUCHENGINE_HOT_PATH(Verbose, TEXT("[StartNewCook[%s]] Calling `VarsOnStartFrame` for frame %lld"), *GetCurrentThreadStr(), InputFrameData.FrameID);
 	{
 		DECLARE_SCOPE_CYCLE_COUNTER(TEXT("  I.A [GT] Set Inputs"), STAT_TE_I_A, STATGROUP_TouchEngine);
 		// Here we are only gathering the input values but we are only sending them to TouchEngine when the cook is processed
@@ -824,10 +926,15 @@ void UTouchEngineComponentBase::StartNewCook(float DeltaTime)
 
 	// 2. We prepare the request
 	InputFrameData.StartTime = FPlatformTime::Seconds() - GStartTime;
-	const int64 TimeScale = EngineInfo && EngineInfo->Engine ? EngineInfo->Engine->GetFrameRate() * 1000 : 1000; // The TimeScale should be a multiplier of the frame rate for best results. Decided on TDUE-189
+	const int64 TimeScale = EngineInfo && EngineInfo->Engine ? EngineInfo->Engine->GetTimeScale() : 1000;
+	TMap<FString, FTouchEngineDynamicVariableStruct> VariablesToSend;
+	{
+		TOUCHENGINE_TRACE_COOK_PHASE(InputCopy, InputFrameData);
+		VariablesToSend = DynamicVariables.CopyInputsForCook(InputFrameData.FrameID);
+	}
 	FCookFrameRequest CookFrameRequest{
 		DeltaTime, TimeScale, InputFrameData,
-		DynamicVariables.CopyInputsForCook(InputFrameData.FrameID)
+		MoveTemp(VariablesToSend)
 	};
 
 	// 2b. If the user put a breakpoint in OnStartFrame and decided to turn off AllowRunningInEditor, we could arrive here with an invalid engine.
@@ -859,14 +966,18 @@ void UTouchEngineComponentBase::StartNewCook(float DeltaTime)
              }); // ExecuteOnGameThread<void>
          }); // PendingCookFrame->Next
 
+	// 3b. Now that the cook is enqueued, we let the game code know if TouchEngine is falling behind
+	AverageCookRequestInterval = AverageCookRequestInterval > 0.0 ? FMath::Lerp(AverageCookRequestInterval, static_cast<double>(DeltaTime), BackpressureAveragingWeight) : DeltaTime;
+	UpdateBackpressure_GameThread();
+
 	// 4. In Synchronised mode, we do stall the GameThread. This is the only difference between Synchronised and Independent/Delayed Synchronised modes (apart from the TETimeMode)
 	if (CookMode == ETouchEngineCookMode::Synchronized)
 	{
 		DECLARE_SCOPE_CYCLE_COUNTER(TEXT("II. [GT] Synchronized Wait"), STAT_TE_II, STATGROUP_TouchEngine);
-		UE_LOG(LogTouchEngineComponent, Log, TEXT("   [UTouchEngineComponentBase::StartNewCook[%s]] About to wait for PendingCookFrame for frame %lld"), *GetCurrentThreadStr(), InputFrameData.FrameID)
+		UE_LOG_TOUCHENGINE_HOT_PATH(Log, TEXT("   [UTouchEngineComponentBase::StartNewCook[%s]] About to wait for PendingCookFrame for frame %lld"), *GetCurrentThreadStr(), InputFrameData.FrameID);
 		FlushRenderingCommands(); //We need to ensure the RHI Thread starts the copies before we wait or we would end in a deadlock
-		const bool bDidCookTimeout = !PendingCookFrame.WaitFor(FTimespan::FromSeconds(CookTimeout));
-		UE_LOG(LogTouchEngineComponent, Log, TEXT("   [UTouchEngineComponentBase::StartNewCook[%s]] Done waiting for PendingCookFrame for frame %lld. Cook timeout? %s"), *GetCurrentThreadStr(), InputFrameData.FrameID, bDidCookTimeout ? TEXT("TRUE") : TEXT("false"))
+		[[maybe_unused]] const bool bDidCookTimeout = !PendingCookFrame.WaitFor(FTimespan::FromSeconds(CookTimeout));
+		UE_LOG_TOUCHENGINE_HOT_PATH(Log, TEXT("   [UTouchEngineComponentBase::StartNewCook[%s]] Done waiting for PendingCookFrame for frame %lld. Cook timeout? %s"), *GetCurrentThreadStr(), InputFrameData.FrameID, bDidCookTimeout ? TEXT("TRUE") : TEXT("false"));
 	}
 	
 	// 6. We check if the cook timed out
@@ -891,13 +1002,34 @@ void UTouchEngineComponentBase::OnCookFinished(const UE::TouchEngine::FCookFrame
 		const TESeverity Severity = TEResultGetSeverity(CookFrameResult.TouchEngineInternalResult);
 		Verbosity = Severity == TESeverityError ? ELogVerbosity::Error : (Severity == TESeverityWarning ? ELogVerbosity::Warning : Verbosity);
 	}
-	UE_CLOG(Verbosity == ELogVerbosity::Log, LogTouchEngineComponent, Log, TEXT("[StartNewCook->Next[%s]] PendingCookFrame [Frame No %lld] done with result `%s` and internal result `%s`"),
-		   *GetCurrentThreadStr(), CookFrameResult.FrameData.FrameID, *UEnum::GetValueAsString(CookFrameResult.Result), *TEResultToString(CookFrameResult.TouchEngineInternalResult))
+	UE_CLOG_TOUCHENGINE_HOT_PATH(Verbosity == ELogVerbosity::Log, Log, TEXT("[StartNewCook->Next[%s]] PendingCookFrame [Frame No %lld] done with result `%s` and internal result `%s`"),
+		   *GetCurrentThreadStr(), CookFrameResult.FrameData.FrameID, *UEnum::GetValueAsString(CookFrameResult.Result), *TEResultToString(CookFrameResult.TouchEngineInternalResult));
 	UE_CLOG(Verbosity == ELogVerbosity::Warning, LogTouchEngineComponent, Warning, TEXT("[StartNewCook->Next[%s]] PendingCookFrame [Frame No %lld] done with result `%s` and internal result `%s`"),
 		   *GetCurrentThreadStr(), CookFrameResult.FrameData.FrameID, *UEnum::GetValueAsString(CookFrameResult.Result), *TEResultToString(CookFrameResult.TouchEngineInternalResult))
 	UE_CLOG(Verbosity == ELogVerbosity::Error, LogTouchEngineComponent, Error, TEXT("[StartNewCook->Next[%s]] PendingCookFrame [Frame No %lld] done with result `%s` and internal result `%s`"),
 		   *GetCurrentThreadStr(), CookFrameResult.FrameData.FrameID, *UEnum::GetValueAsString(CookFrameResult.Result), *TEResultToString(CookFrameResult.TouchEngineInternalResult))
 	
+	// 0. We keep track of what the backpressure is derived from
+	if (CookFrameResult.Result == ECookFrameResult::InputsDiscarded)
+	{
+		++NumInputsDiscardedSinceUpdate;
+	}
+	else if (CookFrameResult.CookStartedTime > 0.0 && CookFrameResult.CookFinishedTime > CookFrameResult.CookStartedTime)
+	{
+		const double CookDuration = CookFrameResult.CookFinishedTime - CookFrameResult.CookStartedTime;
+		AverageCookDuration = AverageCookDuration > 0.0 ? FMath::Lerp(AverageCookDuration, CookDuration, BackpressureAveragingWeight) : CookDuration;
+	}
+	
+	// 0b. We accumulate the frame counts. The frame cooker only computes them for successful cooks, and the cooks which were not delivered are
+	// counted as discarded from the FrameIDs of the next frame delivered, so they are not counted twice
+	if (CookFrameResult.Result == ECookFrameResult::Success)
+	{
+		++FrameCounters.FramesDelivered;
+		FrameCounters.FramesDropped += CookFrameResult.NumFramesDropped;
+		FrameCounters.FramesDuplicated += CookFrameResult.NumFramesDuplicated;
+		FrameCounters.FramesDiscarded += CookFrameResult.NumFramesDiscarded;
+	}
+	
 	// 1. We update the latency and call BroadcastOnEndFrame
 	if (EngineInfo && EngineInfo->Engine) // they could be null if we stopped play for example
 	{
@@ -910,14 +1042,29 @@ void UTouchEngineComponentBase::OnCookFinished(const UE::TouchEngine::FCookFrame
 		OutputFrameData.CookStartTime = CookFrameResult.TECookStartTime;
 		OutputFrameData.CookEndTime = CookFrameResult.TECookEndTime;
 
-		UE_LOG(LogTouchEngineComponent, Log, TEXT("[PendingCookFrame.Next[%s]] Calling `BroadcastOnEndFrame` for frame %lld"), *GetCurrentThreadStr(), CookFrameResult.FrameData.FrameID)
+		UE_LOG_TOUCHENGINE_HOT_PATH(Log, TEXT("[PendingCookFrame.Next[%s]] Calling `BroadcastOnEndFrame` for frame %lld"), *GetCurrentThreadStr(), CookFrameResult.FrameData.FrameID);
 
 		if (CookFrameResult.Result == ECookFrameResult::Success && !OutputFrameData.bWasFrameDropped) // if the cook was skipped by TE or not successful, we know that the outputs have not changed, so no need to update them 
 		{
 			DECLARE_SCOPE_CYCLE_COUNTER(TEXT("    IV.B.1 [GT] Post Cook - DynVar Get Outputs"), STAT_TE_IV_B_1, STATGROUP_TouchEngine);
+			TOUCHENGINE_TRACE_COOK_PHASE(GetOutputs, CookFrameResult.FrameData);
 			DynamicVariables.GetOutputs(EngineInfo);
 		}
 
+		FTouchCookStats::Get().AddCookResult_GameThread(CookFrameResult.Result, OutputFrameData);
+		if (FTouchCookTimeline::IsCaptureEnabled())
+		{
+			if (!CookTimeline)
+			{
+				CookTimeline = MakeShared<FTouchCookTimeline>(FTouchCookTimeline::GetDefaultCapacity());
+			}
+			const int32 EntryIndex = CookTimeline->AddCook_GameThread(CookFrameResult, OutputFrameData, FTouchCookTimeline::Now());
+			if (CookFrameResult.Result == ECookFrameResult::Success && !OutputFrameData.bWasFrameDropped)
+			{
+				// The copies of the TOP outputs were enqueued on the Render Thread before the cook came back, so this runs once they have been enqueued (not done) on the GPU
+				CookTimeline->EnqueueTextureCopiesEnqueued_GameThread(EntryIndex, CookFrameResult.FrameData.FrameID);
+			}
+		}
 		{
 			DECLARE_SCOPE_CYCLE_COUNTER(TEXT("    IV.B.2 [GT] Post Cook - BroadcastOnEndFrame"), STAT_TE_IV_B_2, STATGROUP_TouchEngine);
 			BroadcastOnEndFrame(CookFrameResult.Result, OutputFrameData);
@@ -937,6 +1084,8 @@ void UTouchEngineComponentBase::OnCookFinished(const UE::TouchEngine::FCookFrame
 		BroadcastOnEndFrame(CookFrameResult.Result == ECookFrameResult::Success ? ECookFrameResult::Cancelled : CookFrameResult.Result, OutputFrameData);
 	}
 
+	TOUCHENGINE_TRACE_END_COOK(CookFrameResult.FrameData);
+
 	// 3. We let the FrameCooker know that we can accept a next cook job. Does not actually start a new cook.
 	if (CookFrameResult.OnReadyToStartNextCook)
 	{
@@ -962,11 +1111,11 @@ void UTouchEngineComponentBase::OnCookFinished(const UE::TouchEngine::FCookFrame
 			{
 				if (WeakTEComponent.IsValid() && WeakTEComponent->EngineInfo)
 				{
-					UE_LOG(LogTouchEngineComponent, Verbose, TEXT("[UTouchEngineComponentBase::StartNewCook[%s]] Calling ExecuteNextPendingCookFrame_GameThread after frame %lld"),
-					       *GetCurrentThreadStr(), FrameID)
-					const bool Started = WeakTEComponent->EngineInfo->ExecuteNextPendingCookFrame_GameThread();
-					UE_LOG(LogTouchEngineComponent, Verbose, TEXT("[UTouchEngineComponentBase::StartNewCook[%s]] Called ExecuteNextPendingCookFrame_GameThread after frame %lld which returned `%s`"),
-					       *GetCurrentThreadStr(), FrameID, Started ? TEXT("TRUE") : TEXT("FALSE"))
+					UE_LOG_TOUCHENGINE_HOT_PATH(Verbose, TEXT("[UTouchEngineComponentBase::StartNewCook[%s]] Calling ExecuteNextPendingCookFrame_GameThread after frame %lld"),
+					       *GetCurrentThreadStr(), FrameID);
+					[[maybe_unused]] const bool Started = WeakTEComponent->EngineInfo->ExecuteNextPendingCookFrame_GameThread();
+					UE_LOG_TOUCHENGINE_HOT_PATH(Verbose, TEXT("[UTouchEngineComponentBase::StartNewCook[%s]] Called ExecuteNextPendingCookFrame_GameThread after frame %lld which returned `%s`"),
+					       *GetCurrentThreadStr(), FrameID, Started ? TEXT("TRUE") : TEXT("FALSE"));
 				}
 			});
 		}, LowLevelTasks::ETaskPriority::BackgroundNormal);
@@ -1047,6 +1196,14 @@ void UTouchEngineComponentBase::HandleToxLoaded(const UE::TouchEngine::FTouchLoa
 				
 			EngineInfo->Engine->SetExportedTexturePoolSize(ExportedTexturePoolSize);
 			EngineInfo->Engine->SetImportedTexturePoolSize(ImportedTexturePoolSize);
+			EngineInfo->Engine->SetExportedTexturePoolBudget(static_cast<int64>(ExportedTexturePoolBudget) * 1024 * 1024);
+			EngineInfo->Engine->SetImportedTexturePoolBudget(static_cast<int64>(ImportedTexturePoolBudget) * 1024 * 1024);
+			EngineInfo->Engine->SetTexturePoolAdaptiveSizing(bAdaptiveTexturePoolSize, MinExportedTexturePoolSize, MinImportedTexturePoolSize);
+			for (const FString& TOPOutput : ReadbackTOPOutputs)
+			{
+				EngineInfo->Engine->SetTOPReadbackEnabled(TOPOutput, true, ReadbackRingSize);
+			}
+			PrewarmTexturePools();
 		}
 			
 		BroadcastOnToxLoaded(bInSkipBlueprintEvents); 
@@ -1105,6 +1262,47 @@ void UTouchEngineComponentBase::CreateEngineInfo()
 	}
 }
 
+void UTouchEngineComponentBase::PrewarmTexturePools() const
+{
+	TArray<FTouchEngineTextureDescriptor> ExportedTextures = PrewarmedExportedTextures;
+	TArray<FTouchEngineTextureDescriptor> ImportedTextures = PrewarmedImportedTextures;
+	if (bLearnPrewarmedTextures && IsValid(ToxAsset))
+	{
+		TArray<FTouchEngineTextureDescriptor> LearntExportedTextures;
+		TArray<FTouchEngineTextureDescriptor> LearntImportedTextures;
+		const UTouchEngineSubsystem* TESubsystem = GEngine->GetEngineSubsystem<UTouchEngineSubsystem>();
+		if (TESubsystem->GetObservedTextureDescriptors(ToxAsset, LearntImportedTextures, LearntExportedTextures))
+		{
+			FTouchEngineTextureDescriptor::Merge(ExportedTextures, LearntExportedTextures);
+			FTouchEngineTextureDescriptor::Merge(ImportedTextures, LearntImportedTextures);
+		}
+	}
+
+	if (!ExportedTextures.IsEmpty() || !ImportedTextures.IsEmpty())
+	{
+		UE_LOG(LogTouchEngineComponent, Log, TEXT("[UTouchEngineComponentBase::PrewarmTexturePools] Prewarming %d exported and %d imported texture descriptors for `%s`"), ExportedTextures.Num(), ImportedTextures.Num(), *GetReadableName())
+		EngineInfo->Engine->PrewarmTexturePools_GameThread(ImportedTextures, ExportedTextures);
+	}
+}
+
+void UTouchEngineComponentBase::LearnPrewarmedTextures() const
+{
+	if (!bLearnPrewarmedTextures || !IsValid(ToxAsset) || !EngineInfo || !EngineInfo->Engine || !EngineInfo->Engine->IsReadyToCookFrame())
+	{
+		return;
+	}
+	
+	TArray<FTouchEngineTextureDescriptor> ExportedTextures;
+	TArray<FTouchEngineTextureDescriptor> ImportedTextures;
+	if (EngineInfo->Engine->GetObservedTextureDescriptors(ImportedTextures, ExportedTextures))
+	{
+		if (UTouchEngineSubsystem* TESubsystem = GEngine ? GEngine->GetEngineSubsystem<UTouchEngineSubsystem>() : nullptr) // this can be called during shutdown
+		{
+			TESubsystem->CacheObservedTextureDescriptors(ToxAsset, ImportedTextures, ExportedTextures);
+		}
+	}
+}
+
 FString UTouchEngineComponentBase::GetAbsoluteToxPath() const
 {
 	if (IsValid(ToxAsset))
@@ -1137,6 +1335,7 @@ void UTouchEngineComponentBase::ReleaseResources(EReleaseTouchResources ReleaseM
 	if (EngineInfo)
 	{
 		const bool bHadValidEngine = EngineInfo->Engine && (EngineInfo->Engine->IsLoading() || EngineInfo->Engine->IsReadyToCookFrame());
+		LearnPrewarmedTextures();
 		switch (ReleaseMode)
 		{
 		case EReleaseTouchResources::KillProcess:
@@ -1154,4 +1353,55 @@ void UTouchEngineComponentBase::ReleaseResources(EReleaseTouchResources ReleaseM
 			BroadcastOnToxUnloaded();
 		}
 	}
+	ResetBackpressure_GameThread();
+	CookRateAccumulator = 0.0;
+	TimeSinceLastCookRequest = 0.f;
+}
+
+void UTouchEngineComponentBase::UpdateBackpressure_GameThread()
+{
+	// 1. We find the current backpressure. Discarded inputs, or a full queue, mean that the inputs sent now are likely to be discarded as well
+	const int32 NumPendingCooks = GetNumPendingCooks();
+	ETouchEngineBackpressure NewBackpressure = ETouchEngineBackpressure::None;
+	if (NumInputsDiscardedSinceUpdate > 0 || NumPendingCooks >= FMath::Max(1, InputBufferLimit))
+	{
+		NewBackpressure = ETouchEngineBackpressure::Saturated;
+	}
+	else if (NumPendingCooks > 1 || (AverageCookRequestInterval > 0.0 && AverageCookDuration > AverageCookRequestInterval))
+	{
+		// More than one cook waiting, or cooks taking longer than the interval between two requests, means the queue is growing
+		NewBackpressure = ETouchEngineBackpressure::Elevated;
+	}
+	NumInputsDiscardedSinceUpdate = 0;
+
+	// 2. We raise the backpressure right away, but only lower it once it has stayed lower for a little while, to not flip every tick
+	const double Now = FPlatformTime::Seconds();
+	if (NewBackpressure >= Backpressure)
+	{
+		LastBackpressureRaisedTime = Now;
+	}
+	else if (Now - LastBackpressureRaisedTime < BackpressureLoweringDelay)
+	{
+		return;
+	}
+
+	if (NewBackpressure != Backpressure)
+	{
+		UE_LOG(LogTouchEngineComponent, Verbose, TEXT("[UTouchEngineComponentBase::UpdateBackpressure_GameThread] Backpressure of `%s` changed to `%s` (%d cooks pending, average cook duration %.2fms, average request interval %.2fms)"),
+			*GetReadableName(), *UEnum::GetValueAsString(NewBackpressure), NumPendingCooks, AverageCookDuration * 1000.0, AverageCookRequestInterval * 1000.0)
+		Backpressure = NewBackpressure;
+		BroadcastOnBackpressureChanged();
+	}
+}
+
+void UTouchEngineComponentBase::ResetBackpressure_GameThread()
+{
+	AverageCookDuration = 0.0;
+	AverageCookRequestInterval = 0.0;
+	NumInputsDiscardedSinceUpdate = 0;
+	if (Backpressure != ETouchEngineBackpressure::None)
+	{
+		Backpressure = ETouchEngineBackpressure::None;
+		BroadcastOnBackpressureChanged();
+	}
 }
\ No newline at end of file
@@ -27,12 +27,18 @@
 #include "Engine/TEDebug.h"
 #include "Util/TouchFrameCooker.h"
 #include "Util/TouchHelpers.h"
+#include "Util/TouchEngineStatsGroup.h"
 #include "Misc/Paths.h"
 
 #define LOCTEXT_NAMESPACE "FTouchEngine"
 
 namespace UE::TouchEngine
 {
+	/** How close a frame rate needs to be from an integer or NTSC rate to be considered equal to it */
+	static constexpr double FrameRateTolerance = 0.001;
+	/** The lowest frame rate we can send, as fractional rates are sent with a precision of 1/1000 */
+	static constexpr double MinFrameRate = 0.001;
+
 	void FTouchEngineHazardPointer::TouchEventCallback_AnyThread(TEInstance* Instance, TEEvent Event, TEResult Result, int64_t StartTimeValue, int32_t StartTimeScale, int64_t EndTimeValue, int32_t EndTimeScale, void* Info)
 	{
 		UE_LOG(LogTouchEngineTECalls, Log, TEXT("TouchEventCallback:  Event: `%s`   Result: `%hs`  StartTime: %lld   TimeScale: %d    EndTime: %lld   TimeScale: %d [%s]"),
@@ -68,6 +74,18 @@ namespace UE::TouchEngine
 		}
 	}
 
+	void FTouchEngineHazardPointer::StatisticsCallback_AnyThread(TEInstance* Instance, const TEInstanceStatistics* Statistics, void* Info)
+	{
+		const FTouchEngineHazardPointer* HazardPointer = static_cast<FTouchEngineHazardPointer*>(Info);
+		if (Statistics && HazardPointer && HazardPointer->TouchEngine.IsValid())
+		{
+			if (const TSharedPtr<FTouchEngine> TouchEnginePin = HazardPointer->TouchEngine.Pin())
+			{
+				TouchEnginePin->OnStatistics_AnyThread(*Statistics);
+			}
+		}
+	}
+
 	FTouchEngine::~FTouchEngine()
 	{
 		check(IsInGameThread());
@@ -142,6 +160,7 @@ namespace UE::TouchEngine
 		// SharedCleanUp resets the path - we want to print the path in UE_LOGs later.
 		FString OldToxPath = GetToxPath();
 		SharedCleanUp();
+		ResetStatistics();
 		
 		LoadState_GameThread = ELoadState::NoTouchInstance;
 		if (TouchResources.TouchEngineInstance)
@@ -155,6 +174,11 @@ namespace UE::TouchEngine
 		return LoadState_GameThread == ELoadState::Ready && TouchResources.FrameCooker ? TouchResources.FrameCooker->GetNextFrameID() : -1;
 	}
 
+	int32 FTouchEngine::GetNumPendingCooks() const
+	{
+		return TouchResources.FrameCooker ? TouchResources.FrameCooker->GetNumPendingCooks() : 0;
+	}
+
 	TFuture<FCookFrameResult> FTouchEngine::CookFrame_GameThread(FCookFrameRequest&& CookFrameRequest, int32 InputBufferLimit)
 	{
 		check(IsInGameThread());
@@ -170,7 +194,7 @@ namespace UE::TouchEngine
 		TFuture<FCookFrameResult> CookFrame = TouchResources.FrameCooker->CookFrame_GameThread(MoveTemp(CookFrameRequest), InputBufferLimit)
            .Next([this](FCookFrameResult Value)
            {
-               UE_LOG(LogTouchEngine, Verbose, TEXT("[CookFrame_GameThread->Next[%s]] Finished cooking frame (code: %d)"), *GetCurrentThreadStr(), static_cast<int32>(Value.Result));
+               UE_LOG_TOUCHENGINE_HOT_PATH(Verbose, TEXT("[CookFrame_GameThread->Next[%s]] Finished cooking frame (code: %d)"), *GetCurrentThreadStr(), static_cast<int32>(Value.Result));
 
                switch (Value.Result)
                {
@@ -275,15 +299,37 @@ namespace UE::TouchEngine
 		}
 	}
 
-	bool FTouchEngine::SetFrameRate(int64 FrameRate)
+	bool FTouchEngine::SetFrameRate(double FrameRate)
 	{
-		if (ensureMsgf(!TouchResources.TouchEngineInstance, TEXT("TargetFrameRate can only be set before the engine is started.")))
+		if (ensureMsgf(!TouchResources.TouchEngineInstance, TEXT("TargetFrameRate can only be set before the engine is started."))
+			&& ensureMsgf(FrameRate >= MinFrameRate, TEXT("The FrameRate must be at least %f, got %f"), MinFrameRate, FrameRate))
 		{
-			TargetFrameRate = FrameRate;
+			const int32 WholeFrameRate = FMath::RoundToInt32(FrameRate);
+			const int32 NTSCFrameRate = FMath::RoundToInt32(FrameRate * 1.001);
+			// Rates close to 0 would otherwise round to a whole or NTSC rate of 0
+			if (WholeFrameRate > 0 && FMath::IsNearlyEqual(FrameRate, static_cast<double>(WholeFrameRate), FrameRateTolerance))
+			{
+				TargetFrameRate = FFrameRate(WholeFrameRate, 1);
+			}
+			else if (NTSCFrameRate > 0 && FMath::IsNearlyEqual(FrameRate, NTSCFrameRate * 1000 / 1001.0, FrameRateTolerance)) // 59.94 is really 60000/1001
+			{
+				TargetFrameRate = FFrameRate(NTSCFrameRate * 1000, 1001);
+			}
+			else
+			{
+				TargetFrameRate = FFrameRate(FMath::RoundToInt32(FrameRate * 1000), 1000);
+			}
 			return true;
 		}
 		return false;
 	}
+
+	int64 FTouchEngine::GetTimeScale() const
+	{
+		// The TimeScale should be a multiplier of the frame rate for best results. Decided on TDUE-189.
+		// For fractional rates, using the numerator gives a frame duration of Denominator ticks, 1001 for NTSC rates
+		return TargetFrameRate.Denominator == 1 ? static_cast<int64>(TargetFrameRate.Numerator) * 1000 : TargetFrameRate.Numerator;
+	}
 	
 	bool FTouchEngine::SetExportedTexturePoolSize(int ExportedTexturePoolSize)
 	{
@@ -298,11 +344,88 @@ namespace UE::TouchEngine
 	{
 		if (ensureMsgf(TouchResources.ResourceProvider, TEXT("ImportedTexturePoolSize can only be set after the engine is started.")))
 		{
-			TouchResources.ResourceProvider->SetExportedTexturePoolSize(ImportedTexturePoolSize);
+			TouchResources.ResourceProvider->SetImportedTexturePoolSize(ImportedTexturePoolSize);
 			return true;
 		}
 		return false;
 	}
+
+	bool FTouchEngine::SetExportedTexturePoolBudget(int64 ExportedTexturePoolBudgetBytes)
+	{
+		if (ensureMsgf(TouchResources.ResourceProvider, TEXT("ExportedTexturePoolBudget can only be set after the engine is started.")))
+		{
+			return TouchResources.ResourceProvider->SetExportedTexturePoolBudget(ExportedTexturePoolBudgetBytes);
+		}
+		return false;
+	}
+
+	bool FTouchEngine::SetImportedTexturePoolBudget(int64 ImportedTexturePoolBudgetBytes)
+	{
+		if (ensureMsgf(TouchResources.ResourceProvider, TEXT("ImportedTexturePoolBudget can only be set after the engine is started.")))
+		{
+			return TouchResources.ResourceProvider->SetImportedTexturePoolBudget(ImportedTexturePoolBudgetBytes);
+		}
+		return false;
+	}
+
+	bool FTouchEngine::SetTexturePoolAdaptiveSizing(bool bEnabled, int32 MinExportedPoolSize, int32 MinImportedPoolSize)
+	{
+		if (ensureMsgf(TouchResources.ResourceProvider, TEXT("The adaptive texture pool sizing can only be set after the engine is started.")))
+		{
+			const bool bExportedSet = TouchResources.ResourceProvider->SetExportedTexturePoolAdaptiveSizing(bEnabled, MinExportedPoolSize);
+			const bool bImportedSet = TouchResources.ResourceProvider->SetImportedTexturePoolAdaptiveSizing(bEnabled, MinImportedPoolSize);
+			return bExportedSet && bImportedSet;
+		}
+		return false;
+	}
+
+	void FTouchEngine::PrewarmTexturePools_GameThread(const TArray<FTouchEngineTextureDescriptor>& ImportedTextures, const TArray<FTouchEngineTextureDescriptor>& ExportedTextures)
+	{
+		if (ensureMsgf(TouchResources.ResourceProvider, TEXT("The texture pools can only be prewarmed after the engine is started.")))
+		{
+			DECLARE_SCOPE_CYCLE_COUNTER(TEXT("Prewarm Texture Pools"), STAT_TE_PrewarmTexturePools, STATGROUP_TouchEngine);
+			TouchResources.ResourceProvider->PrewarmImportedTexturePool_GameThread(ImportedTextures);
+			TouchResources.ResourceProvider->PrewarmExportedTexturePool_GameThread(ExportedTextures);
+		}
+	}
+
+	bool FTouchEngine::GetObservedTextureDescriptors(TArray<FTouchEngineTextureDescriptor>& OutImportedTextures, TArray<FTouchEngineTextureDescriptor>& OutExportedTextures) const
+	{
+		if (TouchResources.ResourceProvider)
+		{
+			OutImportedTextures = TouchResources.ResourceProvider->GetObservedImportedTextureDescriptors();
+			OutExportedTextures = TouchResources.ResourceProvider->GetObservedExportedTextureDescriptors();
+			return true;
+		}
+		return false;
+	}
+	
+	bool FTouchEngine::SetTOPReadbackEnabled(const FString& Identifier, bool bEnabled, int32 RingSize)
+	{
+		if (ensureMsgf(TouchResources.ResourceProvider, TEXT("The TOP readback can only be enabled after the engine is started.")))
+		{
+			TouchResources.ResourceProvider->GetImporter().GetReadback().SetReadbackEnabled(FName(Identifier), bEnabled, RingSize);
+			return true;
+		}
+		return false;
+	}
+
+	FDelegateHandle FTouchEngine::AddTOPReadbackListener(FOnTouchTextureReadback::FDelegate&& Listener)
+	{
+		if (ensureMsgf(TouchResources.ResourceProvider, TEXT("TOP readback listeners can only be added after the engine is started.")))
+		{
+			return TouchResources.ResourceProvider->GetImporter().GetReadback().AddListener(MoveTemp(Listener));
+		}
+		return {};
+	}
+
+	void FTouchEngine::RemoveTOPReadbackListener(FDelegateHandle Handle)
+	{
+		if (TouchResources.ResourceProvider)
+		{
+			TouchResources.ResourceProvider->GetImporter().GetReadback().RemoveListener(Handle);
+		}
+	}
 	
 	bool FTouchEngine::GetSupportedPixelFormat(TSet<TEnumAsByte<EPixelFormat>>& SupportedPixelFormat) const
 	{
@@ -407,16 +530,33 @@ namespace UE::TouchEngine
 				return false;
 			}
 
-			const TEResult SetFrameResult = TEInstanceSetFrameRate(TouchResources.TouchEngineInstance, TargetFrameRate, 1);
+			// Integer and NTSC rates are exact rational numbers, the others were only kept to the thousandth of a frame and are sent as a float
+			const bool bIsExactFrameRate = TargetFrameRate.Denominator == 1 || TargetFrameRate.Denominator == 1001;
+			const TEResult SetFrameResult = bIsExactFrameRate
+				? TEInstanceSetFrameRate(TouchResources.TouchEngineInstance, TargetFrameRate.Numerator, TargetFrameRate.Denominator)
+				: TEInstanceSetFloatFrameRate(TouchResources.TouchEngineInstance, static_cast<float>(TargetFrameRate.AsDecimal()));
 			if (!OutputResultAndCheckForError_GameThread(SetFrameResult, TEXT("Unable to set frame rate")))
 			{
 				return false;
 			}
+
+			{
+				FScopeLock Lock(&StatisticsLock);
+				bAcceptsStatistics = true;
+			}
+			const TEResult StatisticsResult = TEInstanceSetStatisticsCallback(TouchResources.TouchEngineInstance, FTouchEngineHazardPointer::StatisticsCallback_AnyThread);
+			if (StatisticsResult != TEResultSuccess) // Not critical, we only lose the statistics
+			{
+				UE_LOG(LogTouchEngine, Warning, TEXT("[FTouchEngine::InstantiateEngineWithToxFile[%s]] Unable to register the statistics callback: %hs"), *GetCurrentThreadStr(), TEResultGetDescription(StatisticsResult));
+			}
 			
-			const TEResult GraphicsContextResult = TEInstanceAssociateGraphicsContext(TouchResources.TouchEngineInstance, TouchResources.ResourceProvider->GetContext());
-			if (!OutputResultAndCheckForError_GameThread(GraphicsContextResult, TEXT("Unable to associate graphics Context")))
+			if (TEGraphicsContext* GraphicsContext = TouchResources.ResourceProvider->GetContext()) // the headless resource provider has no graphics context
 			{
-				return false;
+				const TEResult GraphicsContextResult = TEInstanceAssociateGraphicsContext(TouchResources.TouchEngineInstance, GraphicsContext);
+				if (!OutputResultAndCheckForError_GameThread(GraphicsContextResult, TEXT("Unable to associate graphics Context")))
+				{
+					return false;
+				}
 			}
 
 			TouchResources.ResourceProvider->ConfigureInstance(TouchResources.TouchEngineInstance);
@@ -446,7 +586,7 @@ namespace UE::TouchEngine
 		{
 			return;
 		}
-		UE_LOG(LogTouchEngine, Log, TEXT(" [FTouchEngine::TouchEventCallback_AnyThread[%s]] Received TouchEvent `%s` with result `%hs` for frame `%lld`   (StartTime: %lld  TimeScale: %d    EndTime: %lld  TimeScale: %d)"),
+		UE_LOG_TOUCHENGINE_HOT_PATH(Log, TEXT(" [FTouchEngine::TouchEventCallback_AnyThread[%s]] Received TouchEvent `%s` with result `%hs` for frame `%lld`   (StartTime: %lld  TimeScale: %d    EndTime: %lld  TimeScale: %d)"),
 			*GetCurrentThreadStr(),
 			*TEEventToString(Event),
 			TEResultGetDescription(Result), 
@@ -463,10 +603,10 @@ namespace UE::TouchEngine
 			{
 				//todo: when cancelled, TouchResources.FrameCooker->GetCookingFrameID() returns -1, we should be able to return the last one that was set prior
 				const int64 CookingFrameID = TouchResources.FrameCooker ? TouchResources.FrameCooker->GetCookingFrameID() : -1;
-				UE_CLOG(Result == TEResultSuccess, LogTouchEngine, Log, TEXT("TEEventFrameDidFinish[%s] for frame `%lld`:  StartTime: %lld  TimeScale: %d    EndTime: %lld  TimeScale: %d => %s"), *GetCurrentThreadStr(), CookingFrameID, StartTimeValue, StartTimeScale, EndTimeValue, EndTimeScale, *TEResultToString(Result));
+				UE_CLOG_TOUCHENGINE_HOT_PATH(Result == TEResultSuccess, Log, TEXT("TEEventFrameDidFinish[%s] for frame `%lld`:  StartTime: %lld  TimeScale: %d    EndTime: %lld  TimeScale: %d => %s"), *GetCurrentThreadStr(), CookingFrameID, StartTimeValue, StartTimeScale, EndTimeValue, EndTimeScale, *TEResultToString(Result));
 				if (Result != TEResultSuccess)
 				{
-					UE_CLOG(Result == TEResultCancelled, LogTouchEngine, Log, TEXT("TEEventFrameDidFinish[%s] for frame `%lld`:  StartTime: %lld  TimeScale: %d    EndTime: %lld  TimeScale: %d => %s (`%hs`)"), *GetCurrentThreadStr(), CookingFrameID, StartTimeValue, StartTimeScale, EndTimeValue, EndTimeScale, *TEResultToString(Result), TEResultGetDescription(Result));
+					UE_CLOG_TOUCHENGINE_HOT_PATH(Result == TEResultCancelled, Log, TEXT("TEEventFrameDidFinish[%s] for frame `%lld`:  StartTime: %lld  TimeScale: %d    EndTime: %lld  TimeScale: %d => %s (`%hs`)"), *GetCurrentThreadStr(), CookingFrameID, StartTimeValue, StartTimeScale, EndTimeValue, EndTimeScale, *TEResultToString(Result), TEResultGetDescription(Result));
 					if (Result != TEResultCancelled && TouchResources.ErrorLog)
 					{
 						TouchResources.ErrorLog->AddResult(TEXT("The Cook was not successful."), Result, FString(), GET_FUNCTION_NAME_CHECKED(FTouchEngine, TouchEventCallback_AnyThread));
@@ -584,6 +724,7 @@ namespace UE::TouchEngine
 				check(SharedThis->TouchResources.ResourceProvider); //TouchResources.ResourceProvider is supposed to be valid at this point as it has been created in InstantiateEngineWithToxFile
 				SharedThis->TouchResources.FrameCooker = MakeShared<FTouchFrameCooker>(SharedThis->TouchResources.TouchEngineInstance, *SharedThis->TouchResources.VariableManager, *SharedThis->TouchResources.ResourceProvider);
 				SharedThis->TouchResources.FrameCooker->SetTimeMode(SharedThis->TimeMode);
+				SharedThis->TouchResources.FrameCooker->SetFrameRate(SharedThis->TargetFrameRate);
 			
 				SharedThis->LoadState_GameThread = ELoadState::Ready;
 				SharedThis->EmplaceLoadPromiseIfSet_GameThread(FTouchLoadResult::MakeSuccess(MoveTemp(VariablesIn.Value), MoveTemp(VariablesOut.Value)));
@@ -680,7 +821,7 @@ namespace UE::TouchEngine
 		TouchObject<TELinkInfo> Info;
 		const TEResult Result = TEInstanceLinkGetInfo(Instance, Identifier, Info.take());
 
-		// UE_LOG(LogTemp, Log, TEXT("  LinkValue_AnyThread for `%hs` with event `%s` for CookingFrame `%lld`"), Identifier, *TELinkEventToString(Event), TouchResources.FrameCooker ? TouchResources.FrameCooker->GetCookingFrameID() : -1)
+		UE_LOG_TOUCHENGINE_HOT_PATH(Verbose, TEXT("  LinkValue_AnyThread for `%hs` with event `%s` for CookingFrame `%lld`"), Identifier, *TELinkEventToString(Event), TouchResources.FrameCooker ? TouchResources.FrameCooker->GetCookingFrameID() : -1);
 		const bool bIsOutputValue = Result == TEResultSuccess && Info && Info->scope == TEScopeOutput;
 		const bool bHasValueChanged = Event == TELinkEventValueChange;
 		const bool bIsTextureValue = Info && Info->type == TELinkTypeTexture;
@@ -697,6 +838,62 @@ namespace UE::TouchEngine
 		}
 	}
 
+	FTouchEngineStatistics FTouchEngine::GetStatistics() const
+	{
+		FScopeLock Lock(&StatisticsLock);
+		FTouchEngineStatistics Result = Statistics;
+		if (Result.bIsValid)
+		{
+			Result.Age = FPlatformTime::Seconds() - Result.ReceivedTime;
+		}
+		return Result;
+	}
+
+	void FTouchEngine::OnStatistics_AnyThread(const TEInstanceStatistics& InStatistics)
+	{
+		FScopeLock Lock(&StatisticsLock);
+		if (!bAcceptsStatistics)
+		{
+			return;
+		}
+
+		FTouchEngineStatistics NewStatistics;
+		NewStatistics.bIsValid = true;
+		NewStatistics.GPUMemoryUsed = InStatistics.memUsedGPU;
+		NewStatistics.CPUMemoryUsed = InStatistics.memUsedCPU;
+		NewStatistics.CPUFrameTime = InStatistics.frameTimeCPU / 1000000.0;
+		NewStatistics.GPUFrameTime = InStatistics.frameTimeGPU >= 0 ? InStatistics.frameTimeGPU / 1000000.0 : -1.0;
+		NewStatistics.FramesProcessed = InStatistics.frames;
+		NewStatistics.FramesDropped = InStatistics.framesDropped;
+		NewStatistics.TotalFramesProcessed = Statistics.TotalFramesProcessed + FMath::Max<int64>(InStatistics.frames, 0);
+		NewStatistics.TotalFramesDropped = Statistics.TotalFramesDropped + FMath::Max<int64>(InStatistics.framesDropped, 0);
+		NewStatistics.ReceivedTime = FPlatformTime::Seconds();
+
+		// The stats are the sum over all the instances, so each instance only adds the difference with what it reported last time
+		INC_MEMORY_STAT_BY(STAT_TE_Instance_GPUMemoryUsed, NewStatistics.GPUMemoryUsed - Statistics.GPUMemoryUsed);
+		INC_MEMORY_STAT_BY(STAT_TE_Instance_CPUMemoryUsed, NewStatistics.CPUMemoryUsed - Statistics.CPUMemoryUsed);
+		INC_FLOAT_STAT_BY(STAT_TE_Instance_CPUFrameTime, NewStatistics.CPUFrameTime - Statistics.CPUFrameTime);
+		INC_FLOAT_STAT_BY(STAT_TE_Instance_GPUFrameTime, FMath::Max(NewStatistics.GPUFrameTime, 0.0) - FMath::Max(Statistics.GPUFrameTime, 0.0));
+		INC_DWORD_STAT_BY(STAT_TE_Instance_FramesProcessed, NewStatistics.TotalFramesProcessed - Statistics.TotalFramesProcessed);
+		INC_DWORD_STAT_BY(STAT_TE_Instance_FramesDropped, NewStatistics.TotalFramesDropped - Statistics.TotalFramesDropped);
+
+		Statistics = NewStatistics;
+	}
+
+	void FTouchEngine::ResetStatistics()
+	{
+		FScopeLock Lock(&StatisticsLock);
+		bAcceptsStatistics = false;
+
+		DEC_MEMORY_STAT_BY(STAT_TE_Instance_GPUMemoryUsed, Statistics.GPUMemoryUsed);
+		DEC_MEMORY_STAT_BY(STAT_TE_Instance_CPUMemoryUsed, Statistics.CPUMemoryUsed);
+		DEC_FLOAT_STAT_BY(STAT_TE_Instance_CPUFrameTime, Statistics.CPUFrameTime);
+		DEC_FLOAT_STAT_BY(STAT_TE_Instance_GPUFrameTime, FMath::Max(Statistics.GPUFrameTime, 0.0));
+		DEC_DWORD_STAT_BY(STAT_TE_Instance_FramesProcessed, Statistics.TotalFramesProcessed);
+		DEC_DWORD_STAT_BY(STAT_TE_Instance_FramesDropped, Statistics.TotalFramesDropped);
+		Statistics = FTouchEngineStatistics();
+	}
+
 	void FTouchEngine::SharedCleanUp()
 	{
 		check(IsInGameThread());
@@ -236,6 +236,28 @@ void UTouchEngineSubsystem::LoadPixelFormats(const UTouchEngineInfo* ComponentEn
 	}
 }
 
+void UTouchEngineSubsystem::CacheObservedTextureDescriptors(const UToxAsset* ToxAsset, const TArray<FTouchEngineTextureDescriptor>& ImportedTextures, const TArray<FTouchEngineTextureDescriptor>& ExportedTextures)
+{
+	if (IsValid(ToxAsset))
+	{
+		FObservedTextureDescriptors& Descriptors = CachedTextureDescriptors.FindOrAdd(ToxAsset->GetAbsoluteFilePath());
+		FTouchEngineTextureDescriptor::Merge(Descriptors.ImportedTextures, ImportedTextures);
+		FTouchEngineTextureDescriptor::Merge(Descriptors.ExportedTextures, ExportedTextures);
+	}
+}
+
+bool UTouchEngineSubsystem::GetObservedTextureDescriptors(const UToxAsset* ToxAsset, TArray<FTouchEngineTextureDescriptor>& OutImportedTextures, TArray<FTouchEngineTextureDescriptor>& OutExportedTextures) const
+{
+	const FObservedTextureDescriptors* Descriptors = IsValid(ToxAsset) ? CachedTextureDescriptors.Find(ToxAsset->GetAbsoluteFilePath()) : nullptr;
+	if (Descriptors)
+	{
+		OutImportedTextures = Descriptors->ImportedTextures;
+		OutExportedTextures = Descriptors->ExportedTextures;
+		return true;
+	}
+	return false;
+}
+
 TFuture<UE::TouchEngine::FCachedToxFileInfo> UTouchEngineSubsystem::EnqueueOrExecuteLoadTask(UToxAsset* ToxAsset, double LoadTimeoutInSeconds)
 {
 	using namespace UE::TouchEngine;
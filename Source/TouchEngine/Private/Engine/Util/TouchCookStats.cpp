@@ -0,0 +1,149 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#include "Engine/Util/TouchCookStats.h"
+
+#include "Blueprint/TouchEngineInputFrameData.h"
+#include "Util/TouchEngineStatsGroup.h"
+
+#include "Misc/CoreDelegates.h"
+
+CSV_DEFINE_CATEGORY_MODULE(TOUCHENGINE_API, TouchEngine, true);
+
+namespace UE::TouchEngine
+{
+	namespace Private
+	{
+		static double GetSortedPercentile(const TArray<double>& SortedValues, double Percentile)
+		{
+			const int32 Index = FMath::Clamp(FMath::CeilToInt32(Percentile * SortedValues.Num()) - 1, 0, SortedValues.Num() - 1);
+			return SortedValues[Index];
+		}
+	}
+
+	TUniquePtr<FTouchCookStats> FTouchCookStats::Instance;
+
+	void FTouchCookStats::Create()
+	{
+		check(!Instance);
+		Instance = TUniquePtr<FTouchCookStats>(new FTouchCookStats());
+	}
+
+	void FTouchCookStats::Destroy()
+	{
+		Instance.Reset();
+	}
+
+	FTouchCookStats& FTouchCookStats::Get()
+	{
+		check(Instance);
+		return *Instance;
+	}
+
+	FTouchCookStats::FTouchCookStats()
+	{
+		Latencies.Reserve(LatencyWindowSize);
+		TickLatencies.Reserve(LatencyWindowSize);
+		SortedLatencies.Reserve(LatencyWindowSize);
+
+		// The percentile stats are cleared every frame, so they need to be set every frame, even when no cook came back
+		EndFrameHandle = FCoreDelegates::OnEndFrame.AddRaw(this, &FTouchCookStats::PublishLatencies_GameThread);
+	}
+
+	FTouchCookStats::~FTouchCookStats()
+	{
+		FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+	}
+
+	void FTouchCookStats::AddCookResult_GameThread(ECookFrameResult Result, const FTouchEngineOutputFrameData& FrameData)
+	{
+		check(IsInGameThread());
+
+		// 1. The counters. The inputs discarded, the timeouts and the cooks which failed to start are counted by the frame cooker when they happen
+		switch (Result)
+		{
+		case ECookFrameResult::Success:
+			if (FrameData.bWasFrameDropped)
+			{
+				INC_DWORD_STAT(STAT_TE_Cook_FramesDropped);
+				CSV_CUSTOM_STAT(TouchEngine, CookFramesDropped, 1, ECsvCustomStatOp::Accumulate);
+			}
+			else
+			{
+				INC_DWORD_STAT(STAT_TE_Cook_Succeeded);
+				CSV_CUSTOM_STAT(TouchEngine, CookSucceeded, 1, ECsvCustomStatOp::Accumulate);
+			}
+			break;
+		case ECookFrameResult::Cancelled:
+			INC_DWORD_STAT(STAT_TE_Cook_Cancelled);
+			CSV_CUSTOM_STAT(TouchEngine, CookCancelled, 1, ECsvCustomStatOp::Accumulate);
+			return; // A cancelled cook did not go through TouchEngine, its latency is meaningless
+		case ECookFrameResult::InputsDiscarded:
+		case ECookFrameResult::TouchEngineCookTimeout:
+		case ECookFrameResult::FailedToStartCook:
+			return;
+		default:
+			INC_DWORD_STAT(STAT_TE_Cook_Errors);
+			CSV_CUSTOM_STAT(TouchEngine, CookErrors, 1, ECsvCustomStatOp::Accumulate);
+			return;
+		}
+
+		// 2. The latency of the cooks which went through TouchEngine
+		const double LatencyMs = FrameData.Latency * 1000.0;
+		if (Latencies.Num() < LatencyWindowSize)
+		{
+			Latencies.Add(LatencyMs);
+			TickLatencies.Add(FrameData.TickLatency);
+		}
+		else
+		{
+			Latencies[NextSampleIndex] = LatencyMs;
+			TickLatencies[NextSampleIndex] = FrameData.TickLatency;
+		}
+		NextSampleIndex = (NextSampleIndex + 1) % LatencyWindowSize;
+	}
+
+	void FTouchCookStats::PublishLatencies_GameThread()
+	{
+#if STATS || CSV_PROFILER
+		if (Latencies.IsEmpty())
+		{
+			return;
+		}
+
+		SortedLatencies = Latencies;
+		SortedLatencies.Sort();
+		const double P50 = Private::GetSortedPercentile(SortedLatencies, 0.5);
+		const double P95 = Private::GetSortedPercentile(SortedLatencies, 0.95);
+		const double P99 = Private::GetSortedPercentile(SortedLatencies, 0.99);
+		const double Max = SortedLatencies.Last();
+		int32 TickLatencyMax = 0;
+		for (const int32 TickLatency : TickLatencies)
+		{
+			TickLatencyMax = FMath::Max(TickLatencyMax, TickLatency);
+		}
+
+		SET_FLOAT_STAT(STAT_TE_Cook_LatencyP50, P50);
+		SET_FLOAT_STAT(STAT_TE_Cook_LatencyP95, P95);
+		SET_FLOAT_STAT(STAT_TE_Cook_LatencyP99, P99);
+		SET_FLOAT_STAT(STAT_TE_Cook_LatencyMax, Max);
+		SET_DWORD_STAT(STAT_TE_Cook_TickLatencyMax, TickLatencyMax);
+		CSV_CUSTOM_STAT(TouchEngine, CookLatencyP50Ms, P50, ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(TouchEngine, CookLatencyP95Ms, P95, ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(TouchEngine, CookLatencyP99Ms, P99, ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(TouchEngine, CookLatencyMaxMs, Max, ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(TouchEngine, CookTickLatencyMax, TickLatencyMax, ECsvCustomStatOp::Set);
+#endif
+	}
+}
@@ -0,0 +1,59 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/Util/CookFrameData.h"
+
+struct FTouchEngineOutputFrameData;
+
+namespace UE::TouchEngine
+{
+	/**
+	 * Gathers the results of the cooks of all the components and publishes them to STATGROUP_TouchEngine and to the TouchEngine CSV category.
+	 * The counters are published as cooks finish, and the latency percentiles once per frame, over the last LatencyWindowSize cooks.
+	 * The instance is owned by the module: it is created in StartupModule and destroyed in ShutdownModule.
+	 */
+	class FTouchCookStats : public FNoncopyable
+	{
+	public:
+		/** The number of cooks the latency percentiles are computed over */
+		static constexpr int32 LatencyWindowSize = 128;
+
+		static void Create();
+		static void Destroy();
+		static FTouchCookStats& Get();
+
+		~FTouchCookStats();
+
+		/** Records a cook which came back to the component, with the result and latency the component is about to broadcast */
+		void AddCookResult_GameThread(ECookFrameResult Result, const FTouchEngineOutputFrameData& FrameData);
+
+	private:
+		FTouchCookStats();
+
+		static TUniquePtr<FTouchCookStats> Instance;
+
+		FDelegateHandle EndFrameHandle;
+		/** The latencies of the last cooks, in milliseconds. Used as a ring buffer once full */
+		TArray<double> Latencies;
+		TArray<int32> TickLatencies;
+		int32 NextSampleIndex = 0;
+		/** Reused to sort the latencies when publishing */
+		TArray<double> SortedLatencies;
+
+		void PublishLatencies_GameThread();
+	};
+}
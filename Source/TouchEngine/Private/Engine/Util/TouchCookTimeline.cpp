@@ -0,0 +1,192 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#include "Engine/Util/TouchCookTimeline.h"
+
+#include "Logging.h"
+#include "Blueprint/TouchEngineComponent.h"
+#include "Blueprint/TouchEngineInputFrameData.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "RenderingThread.h"
+#include "UObject/UObjectIterator.h"
+
+namespace UE::TouchEngine
+{
+	static TAutoConsoleVariable<bool> CVarCookTimelineEnable(
+		TEXT("TouchEngine.CookTimeline.Enable"),
+		true,
+		TEXT("If true, the TouchEngine components record the timestamps of their last cooks, which can be dumped with TouchEngine.CookTimeline.Dump."));
+
+	static TAutoConsoleVariable<int32> CVarCookTimelineCapacity(
+		TEXT("TouchEngine.CookTimeline.Capacity"),
+		1024,
+		TEXT("The number of cooks recorded per TouchEngine component. Only applies to the components which start cooking after it is changed."));
+
+	static FString GetCookFrameResultString(ECookFrameResult Result)
+	{
+		return StaticEnum<ECookFrameResult>()->GetNameStringByValue(static_cast<int64>(Result));
+	}
+
+	static void DumpCookTimelines(const TArray<FString>& Args)
+	{
+		// TouchEngine.CookTimeline.Dump [Csv|Json] [Directory]
+		const bool bJson = Args.Num() > 0 && Args[0].Equals(TEXT("Json"), ESearchCase::IgnoreCase);
+		const FString Directory = Args.Num() > 1 ? Args[1] : FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("TouchEngine"), TEXT("CookTimeline"));
+		const FString Timestamp = FDateTime::Now().ToString();
+
+		int32 NumDumped = 0;
+		for (TObjectIterator<UTouchEngineComponentBase> It; It; ++It)
+		{
+			const UTouchEngineComponentBase* Component = *It;
+			if (!IsValid(Component) || Component->IsTemplate() || !Component->GetCookTimeline())
+			{
+				continue;
+			}
+
+			const TArray<FTouchCookTimelineEntry> Entries = Component->GetCookTimeline()->GetEntries();
+			if (Entries.IsEmpty())
+			{
+				continue;
+			}
+
+			const FString OwnerName = Component->GetOwner() ? FString::Printf(TEXT("%s.%s"), *Component->GetOwner()->GetName(), *Component->GetName()) : Component->GetName();
+			const FString FilePath = FPaths::Combine(Directory, FString::Printf(TEXT("%s_%s.%s"), *FPaths::MakeValidFileName(OwnerName), *Timestamp, bJson ? TEXT("json") : TEXT("csv")));
+			const bool bSaved = bJson ? FTouchCookTimeline::SaveToJson(Entries, OwnerName, FilePath) : FTouchCookTimeline::SaveToCsv(Entries, FilePath);
+			if (bSaved)
+			{
+				UE_LOG(LogTouchEngine, Display, TEXT("Dumped the last %d cooks of `%s` to `%s`"), Entries.Num(), *OwnerName, *FPaths::ConvertRelativePathToFull(FilePath));
+				++NumDumped;
+			}
+			else
+			{
+				UE_LOG(LogTouchEngine, Error, TEXT("Unable to write the cook timeline of `%s` to `%s`"), *OwnerName, *FilePath);
+			}
+		}
+		UE_CLOG(NumDumped == 0, LogTouchEngine, Display, TEXT("No TouchEngine component recorded any cook. Is TouchEngine.CookTimeline.Enable set?"));
+	}
+
+	static FAutoConsoleCommand CmdDumpCookTimelines(
+		TEXT("TouchEngine.CookTimeline.Dump"),
+		TEXT("Writes the last cooks recorded by each TouchEngine component to a file. Usage: TouchEngine.CookTimeline.Dump [Csv|Json] [Directory]. Defaults to Csv in Saved/TouchEngine/CookTimeline."),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&DumpCookTimelines));
+
+	FTouchCookTimeline::FTouchCookTimeline(int32 InCapacity)
+	{
+		Entries.SetNum(FMath::Max(1, InCapacity));
+	}
+
+	bool FTouchCookTimeline::IsCaptureEnabled()
+	{
+		return CVarCookTimelineEnable.GetValueOnAnyThread();
+	}
+
+	int32 FTouchCookTimeline::GetDefaultCapacity()
+	{
+		return CVarCookTimelineCapacity.GetValueOnAnyThread();
+	}
+
+	int32 FTouchCookTimeline::AddCook_GameThread(const FCookFrameResult& CookFrameResult, const FTouchEngineOutputFrameData& OutputFrameData, double OutputsFetchedTime)
+	{
+		check(IsInGameThread());
+		FScopeLock Lock(&EntriesLock);
+		const int32 EntryIndex = NextEntryIndex;
+		NextEntryIndex = (NextEntryIndex + 1) % Entries.Num();
+		NumRecorded = FMath::Min(NumRecorded + 1, Entries.Num());
+
+		FTouchCookTimelineEntry& Entry = Entries[EntryIndex];
+		Entry.FrameID = CookFrameResult.FrameData.FrameID;
+		Entry.Result = CookFrameResult.Result;
+		Entry.bWasFrameDropped = CookFrameResult.bWasFrameDropped;
+		Entry.TickLatency = OutputFrameData.TickLatency;
+		Entry.QueuedTime = CookFrameResult.FrameData.StartTime;
+		Entry.StartedTime = CookFrameResult.CookStartedTime;
+		Entry.TECookStartTime = CookFrameResult.TECookStartTime;
+		Entry.TECookEndTime = CookFrameResult.TECookEndTime;
+		Entry.FinishedTime = CookFrameResult.CookFinishedTime;
+		Entry.OutputsFetchedTime = OutputsFetchedTime;
+		Entry.TextureCopiesEnqueuedTime = 0.0;
+		return EntryIndex;
+	}
+
+	void FTouchCookTimeline::SetTextureCopiesEnqueued_AnyThread(int32 EntryIndex, int64 FrameID, double Time)
+	{
+		FScopeLock Lock(&EntriesLock);
+		if (Entries.IsValidIndex(EntryIndex) && Entries[EntryIndex].FrameID == FrameID)
+		{
+			Entries[EntryIndex].TextureCopiesEnqueuedTime = Time;
+		}
+	}
+
+	void FTouchCookTimeline::EnqueueTextureCopiesEnqueued_GameThread(int32 EntryIndex, int64 FrameID)
+	{
+		ENQUEUE_RENDER_COMMAND(TouchCookTimelineTextureCopiesEnqueued)([WeakThis = AsWeak(), EntryIndex, FrameID](FRHICommandListImmediate& RHICmdList)
+		{
+			if (const TSharedPtr<FTouchCookTimeline> ThisPin = WeakThis.Pin())
+			{
+				ThisPin->SetTextureCopiesEnqueued_AnyThread(EntryIndex, FrameID, Now());
+			}
+		});
+	}
+
+	TArray<FTouchCookTimelineEntry> FTouchCookTimeline::GetEntries() const
+	{
+		FScopeLock Lock(&EntriesLock);
+		TArray<FTouchCookTimelineEntry> Result;
+		Result.Reserve(NumRecorded);
+		const int32 FirstEntryIndex = (NextEntryIndex - NumRecorded + Entries.Num()) % Entries.Num();
+		for (int32 i = 0; i < NumRecorded; ++i)
+		{
+			Result.Add(Entries[(FirstEntryIndex + i) % Entries.Num()]);
+		}
+		return Result;
+	}
+
+	void FTouchCookTimeline::Reset()
+	{
+		FScopeLock Lock(&EntriesLock);
+		NextEntryIndex = 0;
+		NumRecorded = 0;
+	}
+
+	bool FTouchCookTimeline::SaveToCsv(const TArray<FTouchCookTimelineEntry>& Entries, const FString& FilePath)
+	{
+		FString Csv = TEXT("FrameID,Result,WasFrameDropped,TickLatency,QueuedTime,StartedTime,TECookStartTime,TECookEndTime,FinishedTime,OutputsFetchedTime,TextureCopiesEnqueuedTime\n");
+		for (const FTouchCookTimelineEntry& Entry : Entries)
+		{
+			Csv += FString::Printf(TEXT("%lld,%s,%d,%lld,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f\n"),
+				Entry.FrameID, *GetCookFrameResultString(Entry.Result), Entry.bWasFrameDropped ? 1 : 0, Entry.TickLatency,
+				Entry.QueuedTime, Entry.StartedTime, Entry.TECookStartTime, Entry.TECookEndTime, Entry.FinishedTime, Entry.OutputsFetchedTime, Entry.TextureCopiesEnqueuedTime);
+		}
+		return FFileHelper::SaveStringToFile(Csv, *FilePath);
+	}
+
+	bool FTouchCookTimeline::SaveToJson(const TArray<FTouchCookTimelineEntry>& Entries, const FString& OwnerName, const FString& FilePath)
+	{
+		FString Json = FString::Printf(TEXT("{\n\t\"Component\": \"%s\",\n\t\"Cooks\": [\n"), *OwnerName.ReplaceCharWithEscapedChar());
+		for (int32 i = 0; i < Entries.Num(); ++i)
+		{
+			const FTouchCookTimelineEntry& Entry = Entries[i];
+			Json += FString::Printf(TEXT("\t\t{ \"FrameID\": %lld, \"Result\": \"%s\", \"WasFrameDropped\": %s, \"TickLatency\": %lld, \"QueuedTime\": %.6f, \"StartedTime\": %.6f, \"TECookStartTime\": %.6f, \"TECookEndTime\": %.6f, \"FinishedTime\": %.6f, \"OutputsFetchedTime\": %.6f, \"TextureCopiesEnqueuedTime\": %.6f }%s\n"),
+				Entry.FrameID, *GetCookFrameResultString(Entry.Result), Entry.bWasFrameDropped ? TEXT("true") : TEXT("false"), Entry.TickLatency,
+				Entry.QueuedTime, Entry.StartedTime, Entry.TECookStartTime, Entry.TECookEndTime, Entry.FinishedTime, Entry.OutputsFetchedTime, Entry.TextureCopiesEnqueuedTime,
+				i + 1 < Entries.Num() ? TEXT(",") : TEXT(""));
+		}
+		Json += TEXT("\t]\n}\n");
+		return FFileHelper::SaveStringToFile(Json, *FilePath);
+	}
+}
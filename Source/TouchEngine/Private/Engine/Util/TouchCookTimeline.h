@@ -0,0 +1,87 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/Util/CookFrameData.h"
+
+struct FTouchEngineOutputFrameData;
+
+namespace UE::TouchEngine
+{
+	/** The timestamps of the phases of one cook. All the times are in seconds since GStartTime, or 0 if the cook never reached that phase. */
+	struct FTouchCookTimelineEntry
+	{
+		int64 FrameID = -1;
+		ECookFrameResult Result = ECookFrameResult::Count;
+		bool bWasFrameDropped = false;
+		int64 TickLatency = -1;
+
+		/** When the component created the cook request and enqueued it in the frame cooker */
+		double QueuedTime = 0.0;
+		/** When the frame cooker called TEInstanceStartFrameAtTime for this cook */
+		double StartedTime = 0.0;
+		/** The start_time returned by TouchEngine for this cook, in TouchEngine time */
+		double TECookStartTime = 0.0;
+		/** The end_time returned by TouchEngine for this cook, in TouchEngine time */
+		double TECookEndTime = 0.0;
+		/** When TouchEngine let us know the frame was done cooking */
+		double FinishedTime = 0.0;
+		/** When the component was done getting the outputs, just before broadcasting OnEndFrame */
+		double OutputsFetchedTime = 0.0;
+		/** When the Render Thread was done enqueuing the copies of the TOP outputs of this cook. The GPU might still be copying them at that time */
+		double TextureCopiesEnqueuedTime = 0.0;
+	};
+
+	/**
+	 * Keeps the timestamps of the last cooks of a component in a fixed size ring buffer, so they can be dumped to a file with TouchEngine.CookTimeline.Dump.
+	 * Recording a cook only copies a few values under a lock, so the capture can be left on during shows.
+	 */
+	class FTouchCookTimeline : public TSharedFromThis<FTouchCookTimeline>
+	{
+	public:
+		explicit FTouchCookTimeline(int32 InCapacity);
+
+		/** Returns false if the capture was disabled with TouchEngine.CookTimeline.Enable */
+		static bool IsCaptureEnabled();
+		/** The capacity new timelines are created with, set by TouchEngine.CookTimeline.Capacity */
+		static int32 GetDefaultCapacity();
+		/** Returns the time, in seconds since GStartTime, used for all the timestamps of the timeline */
+		static double Now() { return FPlatformTime::Seconds() - GStartTime; }
+
+		/** Records a cook which came back to the component. Returns the index of the entry, to be passed to SetTextureCopiesEnqueued_AnyThread */
+		int32 AddCook_GameThread(const FCookFrameResult& CookFrameResult, const FTouchEngineOutputFrameData& OutputFrameData, double OutputsFetchedTime);
+		/** Sets the time the texture copies of the given cook were enqueued, if the entry was not overwritten in the meantime */
+		void SetTextureCopiesEnqueued_AnyThread(int32 EntryIndex, int64 FrameID, double Time);
+		/** Enqueues a render command setting the time the texture copies of the given cook were enqueued. The texture copies of the cook have been enqueued before it */
+		void EnqueueTextureCopiesEnqueued_GameThread(int32 EntryIndex, int64 FrameID);
+
+		/** Returns a copy of the recorded cooks, from the oldest to the newest */
+		TArray<FTouchCookTimelineEntry> GetEntries() const;
+		void Reset();
+
+		/** Writes the given cooks to a CSV file, one cook per row */
+		static bool SaveToCsv(const TArray<FTouchCookTimelineEntry>& Entries, const FString& FilePath);
+		/** Writes the given cooks to a JSON file, as an array of objects */
+		static bool SaveToJson(const TArray<FTouchCookTimelineEntry>& Entries, const FString& OwnerName, const FString& FilePath);
+
+	private:
+		mutable FCriticalSection EntriesLock;
+		/** Allocated once with the capacity of the timeline, and used as a ring buffer */
+		TArray<FTouchCookTimelineEntry> Entries;
+		int32 NextEntryIndex = 0;
+		int32 NumRecorded = 0;
+	};
+}
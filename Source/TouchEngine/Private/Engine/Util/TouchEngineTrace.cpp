@@ -0,0 +1,88 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#include "Util/TouchEngineTrace.h"
+
+#include "ProfilingDebugging/MiscTrace.h"
+
+#if UE_TRACE_ENABLED
+UE_TRACE_CHANNEL_DEFINE(TouchEngineChannel)
+
+UE_TRACE_EVENT_BEGIN(TouchEngine, CookPhaseBegin)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(int64, FrameID)
+	UE_TRACE_EVENT_FIELD(UE::Trace::WideString, Phase)
+	UE_TRACE_EVENT_FIELD(UE::Trace::WideString, Component)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(TouchEngine, CookPhaseEnd)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(int64, FrameID)
+	UE_TRACE_EVENT_FIELD(UE::Trace::WideString, Phase)
+UE_TRACE_EVENT_END()
+
+namespace UE::TouchEngine
+{
+	namespace Private
+	{
+		static FString GetCookRegionName(const FTouchEngineInputFrameData& FrameData)
+		{
+			return FString::Printf(TEXT("TouchEngine Cook [%s] #%lld"), *FrameData.ComponentName.ToString(), FrameData.FrameID);
+		}
+	}
+
+	FCookPhaseTraceScope::FCookPhaseTraceScope(const TCHAR* InPhase, const FTouchEngineInputFrameData& FrameData)
+		: Phase(InPhase)
+		, FrameID(FrameData.FrameID)
+		, bIsTracing(UE_TRACE_CHANNELEXPR_IS_ENABLED(TouchEngineChannel))
+	{
+		if (bIsTracing)
+		{
+			const FString ComponentName = FrameData.ComponentName.ToString();
+			UE_TRACE_LOG(TouchEngine, CookPhaseBegin, TouchEngineChannel)
+				<< CookPhaseBegin.Cycle(FPlatformTime::Cycles64())
+				<< CookPhaseBegin.FrameID(FrameID)
+				<< CookPhaseBegin.Phase(Phase)
+				<< CookPhaseBegin.Component(*ComponentName, ComponentName.Len());
+		}
+	}
+
+	FCookPhaseTraceScope::~FCookPhaseTraceScope()
+	{
+		if (bIsTracing)
+		{
+			UE_TRACE_LOG(TouchEngine, CookPhaseEnd, TouchEngineChannel)
+				<< CookPhaseEnd.Cycle(FPlatformTime::Cycles64())
+				<< CookPhaseEnd.FrameID(FrameID)
+				<< CookPhaseEnd.Phase(Phase);
+		}
+	}
+
+	void TraceBeginCook(const FTouchEngineInputFrameData& FrameData)
+	{
+		if (UE_TRACE_CHANNELEXPR_IS_ENABLED(TouchEngineChannel))
+		{
+			TRACE_BEGIN_REGION(*Private::GetCookRegionName(FrameData));
+		}
+	}
+
+	void TraceEndCook(const FTouchEngineInputFrameData& FrameData)
+	{
+		if (UE_TRACE_CHANNELEXPR_IS_ENABLED(TouchEngineChannel))
+		{
+			TRACE_END_REGION(*Private::GetCookRegionName(FrameData));
+		}
+	}
+}
+#endif
@@ -19,6 +19,7 @@
 #include "TouchEngineModule.h"
 #include "ToxAsset.h"
 #include "Engine/TEDebug.h"
+#include "HAL/IConsoleManager.h"
 #include "Misc/UObjectToken.h"
 #include "GameFramework/Actor.h"
 #include "UObject/WeakObjectPtrTemplates.h"
@@ -27,6 +28,16 @@
 
 namespace UE::TouchEngine
 {
+	static TAutoConsoleVariable<float> CVarErrorLogRepeatInterval(
+		TEXT("TouchEngine.ErrorLog.RepeatInterval"),
+		10.f,
+		TEXT("The minimum number of seconds between two reports of the same TouchEngine error. The repeated errors are counted in between. If 0, a repeated error is only reported once."));
+
+	static TAutoConsoleVariable<int32> CVarErrorLogMaxDistinctErrors(
+		TEXT("TouchEngine.ErrorLog.MaxDistinctErrors"),
+		256,
+		TEXT("The maximum number of distinct errors kept per TouchEngine component. Further errors are only counted."));
+
 	FTouchErrorLog::FTouchErrorLog(const TWeakObjectPtr<UTouchEngineComponentBase> InComponent)
 		: Component(InComponent)
 	{
@@ -34,11 +45,11 @@ namespace UE::TouchEngine
 
 	void FTouchErrorLog::AddResult(const FString& ResultString, TEResult Result, const FString& VarName, const FName& FunctionName, const FString& AdditionalDescription)
 	{
-		const FString Message = ResultString + " " + TEResultGetDescription(Result);
+		// The description of the result is appended in GetLogMessage, only when the error is output
 		switch (TEResultGetSeverity(Result))
 		{
-		case TESeverityWarning: AddLog({EMessageSeverity::Warning, EErrorType::None, Result, FunctionName, VarName, Message, AdditionalDescription});	break;
-		case TESeverityError: AddLog({EMessageSeverity::Error, EErrorType::None, Result, FunctionName, VarName, Message, AdditionalDescription}); break;
+		case TESeverityWarning: AddLog({EMessageSeverity::Warning, EErrorType::None, Result, FunctionName, VarName, ResultString, AdditionalDescription});	break;
+		case TESeverityError: AddLog({EMessageSeverity::Error, EErrorType::None, Result, FunctionName, VarName, ResultString, AdditionalDescription}); break;
 		case TESeverityNone:  UE_LOG(LogTouchEngine, Display, TEXT("TouchEngine Result: %s %s for '%s'"), *ResultString, *AdditionalDescription, *VarName); break;
 		default: ;
 		}
@@ -60,8 +71,8 @@ namespace UE::TouchEngine
 	{
 		switch (TEResultGetSeverity(Result))
         {
-		case TESeverityWarning: AddLog({EMessageSeverity::Warning, ErrorCode, Result, FunctionName, VarName, GetErrorCodeDescription(ErrorCode), AdditionalDescription});	break;
-		case TESeverityError: AddLog({EMessageSeverity::Error, ErrorCode, Result, FunctionName, VarName, GetErrorCodeDescription(ErrorCode), AdditionalDescription}); break;
+		case TESeverityWarning: AddLog({EMessageSeverity::Warning, ErrorCode, Result, FunctionName, VarName, FString(), AdditionalDescription});	break;
+		case TESeverityError: AddLog({EMessageSeverity::Error, ErrorCode, Result, FunctionName, VarName, FString(), AdditionalDescription}); break;
 		case TESeverityNone:  UE_LOG(LogTouchEngine, Display, TEXT("TouchEngine Result: %s for '%s' in function `%s`"), *GetErrorCodeDescription(ErrorCode, Result), *VarName, *FunctionName.ToString()); break;
         default: break;
         }
@@ -70,12 +81,12 @@ namespace UE::TouchEngine
 	void FTouchErrorLog::AddWarning(EErrorType ErrorCode, const FString& VarName, const FName& FunctionName, const FString& AdditionalDescription)
 	{
 		// Successful result as default because it doesn't matter
-		AddLog({EMessageSeverity::Warning, ErrorCode, TEResultSuccess, FunctionName, VarName, GetErrorCodeDescription(ErrorCode), AdditionalDescription});
+		AddLog({EMessageSeverity::Warning, ErrorCode, TEResultSuccess, FunctionName, VarName, FString(), AdditionalDescription});
 	}
 
 	void FTouchErrorLog::AddError(EErrorType ErrorCode, const FString& VarName, const FName& FunctionName, const FString& AdditionalDescription)
 	{
-		AddLog({EMessageSeverity::Error, ErrorCode, TEResultSuccess, FunctionName, VarName, GetErrorCodeDescription(ErrorCode), AdditionalDescription});
+		AddLog({EMessageSeverity::Error, ErrorCode, TEResultSuccess, FunctionName, VarName, FString(), AdditionalDescription});
 	}
 
 	void FTouchErrorLog::AddCountMismatchWarning(const TouchObject<TELinkInfo>& Link, int ExpectedCount, const FString& VarName, const FName& FunctionName)
@@ -108,13 +119,56 @@ namespace UE::TouchEngine
 
 	void FTouchErrorLog::OutputMessages_GameThread()
 	{
-	#if WITH_EDITOR
-		FLogData Message;
-		while (PendingMessages.Dequeue(Message))
+		check(IsInGameThread());
+		
+		struct FLogToOutput
+		{
+			FLogData LogData;
+			int32 NumRepeats;
+			double RepeatPeriod;
+		};
+		TArray<FLogToOutput> LogsToOutput;
+		int32 NumNewDroppedLogs = 0;
 		{
-			OutputLogData_GameThread(Message);
+			const double Now = FPlatformTime::Seconds();
+			FScopeLock Lock(&LogEntriesLock);
+			if (!bHasPendingOutput && Now < NextRepeatCheckTime)
+			{
+				return;
+			}
+			
+			const float RepeatInterval = CVarErrorLogRepeatInterval.GetValueOnGameThread();
+			const bool bCheckRepeats = RepeatInterval > 0.f && Now >= NextRepeatCheckTime;
+			for (TPair<FLogData, FLogEntry>& LogEntry : LogEntries)
+			{
+				FLogEntry& Entry = LogEntry.Value;
+				const bool bShouldOutputRepeats = bCheckRepeats && Entry.Count > Entry.CountAtLastOutput && Now - Entry.LastOutputTime >= RepeatInterval;
+				if (Entry.bOutputPending || bShouldOutputRepeats)
+				{
+					// A pending entry was never output, so its first occurrence is output as any other error
+					const int32 NumRepeats = Entry.bOutputPending ? Entry.Count - 1 : Entry.Count - Entry.CountAtLastOutput;
+					LogsToOutput.Add({LogEntry.Key, Entry.bOutputPending ? 0 : NumRepeats, Now - Entry.LastOutputTime});
+					Entry.bOutputPending = false;
+					Entry.CountAtLastOutput = Entry.Count;
+					Entry.LastOutputTime = Now;
+				}
+			}
+			bHasPendingOutput = false;
+			if (bCheckRepeats || RepeatInterval <= 0.f)
+			{
+				NextRepeatCheckTime = Now + FMath::Max(1.f, RepeatInterval);
+			}
+			
+			NumNewDroppedLogs = NumDroppedLogs - NumDroppedLogsReported;
+			NumDroppedLogsReported = NumDroppedLogs;
+		}
+
+		for (const FLogToOutput& LogToOutput : LogsToOutput)
+		{
+			OutputLogData_GameThread(LogToOutput.LogData, LogToOutput.NumRepeats, LogToOutput.RepeatPeriod);
 		}
-	#endif
+		UE_CLOG(NumNewDroppedLogs > 0, LogTouchEngine, Warning, TEXT("%d TouchEngine errors of `%s` were not reported as %d distinct errors were already reported. See TouchEngine.ErrorLog.MaxDistinctErrors"),
+			NumNewDroppedLogs, *GetPathNameSafe(Component.Get()), CVarErrorLogMaxDistinctErrors.GetValueOnGameThread());
 	}
 
 	FString FTouchErrorLog::GetErrorCodeDescription(EErrorType ErrorCode, TEResult Result)
@@ -147,27 +201,52 @@ namespace UE::TouchEngine
 		return FMessageLog(FTouchEngineModule::MessageLogName);
 	}
 
-	void FTouchErrorLog::AddLog(const FLogData& LogData)
+	void FTouchErrorLog::AddLog(FLogData&& LogData)
 	{
-		if (TriggeredErrors.Contains(LogData))
+		const bool bIsInGameThread = IsInGameThread();
 		{
-			return;
+			FScopeLock Lock(&LogEntriesLock);
+			if (FLogEntry* ExistingEntry = LogEntries.Find(LogData))
+			{
+				// Already reported, it is only counted until OutputMessages_GameThread reports the repeats
+				++ExistingEntry->Count;
+				return;
+			}
+			if (LogEntries.Num() >= CVarErrorLogMaxDistinctErrors.GetValueOnAnyThread())
+			{
+				++NumDroppedLogs;
+				return;
+			}
+			
+			FLogEntry& NewEntry = LogEntries.Add(LogData);
+			NewEntry.Count = 1;
+			if (!bIsInGameThread)
+			{
+				NewEntry.bOutputPending = true;
+				bHasPendingOutput = true;
+				return;
+			}
+			NewEntry.CountAtLastOutput = 1;
+			NewEntry.LastOutputTime = FPlatformTime::Seconds();
 		}
-		TriggeredErrors.Add(LogData);
 
-		if (IsInGameThread())
+		OutputLogData_GameThread(LogData);
+	}
+
+	FString FTouchErrorLog::GetLogMessage(const FLogData& LogData)
+	{
+		if (LogData.ErrorCode != EErrorType::None)
 		{
-			OutputLogData_GameThread(LogData);
+			return GetErrorCodeDescription(LogData.ErrorCode);
 		}
-		else
+		if (LogData.Result != TEResultSuccess)
 		{
-#if WITH_EDITOR
-			PendingMessages.Enqueue(LogData);
-#endif
+			return LogData.Message + " " + TEResultGetDescription(LogData.Result);
 		}
+		return LogData.Message;
 	}
 
-	void FTouchErrorLog::OutputLogData_GameThread(const FLogData& LogData)
+	void FTouchErrorLog::OutputLogData_GameThread(const FLogData& LogData, int32 NumRepeats, double RepeatPeriod)
 	{
 		check(IsInGameThread());
 
@@ -208,7 +287,7 @@ namespace UE::TouchEngine
 		{
 			Message->AddToken(FActorToken::Create(Component->GetOwner()->GetPathName(), Component->GetOwner()->GetActorGuid(), FText::FromString(Component->GetOwner()->GetActorLabel())));
 		}
-		Message->AddToken(FTextToken::Create(FText::Format(LOCTEXT("TEMessageStringBase", " {1}"), SeverityStr, FText::FromString(LogData.Message))));
+		Message->AddToken(FTextToken::Create(FText::Format(LOCTEXT("TEMessageStringBase", " {1}"), SeverityStr, FText::FromString(GetLogMessage(LogData)))));
 		if (!LogData.AdditionalDescription.IsEmpty())
 		{
 			Message->AddToken(FTextToken::Create(FText::Format(INVTEXT(" {0}"), FText::FromString(LogData.AdditionalDescription))));
@@ -245,8 +324,17 @@ namespace UE::TouchEngine
 			Message->AddToken(FUObjectToken::Create(Component->ToxAsset, FText::FromString(Component->ToxAsset->GetRelativeFilePath())));
 			Message->AddToken(FTextToken::Create(INVTEXT(")")));
 		}
+		if (NumRepeats > 0)
+		{
+			Message->AddToken(FTextToken::Create(FText::Format(LOCTEXT("TEMessageStringRepeats", " Repeated {0} times in the last {1} seconds."), NumRepeats, FMath::RoundToInt(RepeatPeriod))));
+		}
 		MessageLog.AddMessage(Message);
 		
+		if (NumRepeats > 0)
+		{
+			// The error was already reported, we do not draw attention to it again
+			return;
+		}
 		if (LogData.Severity == EMessageSeverity::Error && !bWasLogOpened)
 		{
 			MessageLog.Open();
@@ -263,7 +351,7 @@ namespace UE::TouchEngine
 		{
 			Str += GetNameSafe(Component->GetOwner()) + TEXT(" ");
 		}
-		Str += FText::Format(LOCTEXT("TEMessageStringBase", " {0}: {1}"), SeverityStr, FText::FromString(LogData.Message)).ToString();
+		Str += FText::Format(LOCTEXT("TEMessageStringBase", " {0}: {1}"), SeverityStr, FText::FromString(GetLogMessage(LogData))).ToString();
 		if (!LogData.AdditionalDescription.IsEmpty())
 		{
 			Str += FText::Format(INVTEXT(" {0}"), FText::FromString(LogData.AdditionalDescription)).ToString();
@@ -298,6 +386,10 @@ namespace UE::TouchEngine
 		{
 			Str += LOCTEXT("TEMessageStringTox", " (Tox file: ").ToString() + Component->ToxAsset->GetRelativeFilePath() + TEXT(")");
 		}
+		if (NumRepeats > 0)
+		{
+			Str += FText::Format(LOCTEXT("TEMessageStringRepeats", " Repeated {0} times in the last {1} seconds."), NumRepeats, FMath::RoundToInt(RepeatPeriod)).ToString();
+		}
 
 		UE_LOG(LogTouchEngine, Error, TEXT("TouchEngine Error: %s"), *Str);
 #endif
@@ -23,6 +23,7 @@
 #include "TouchEngine/TEInstance.h"
 #include "TouchEngine/TEResult.h"
 #include "Util/TouchEngineStatsGroup.h"
+#include "Util/TouchEngineTrace.h"
 #include "Util/TouchHelpers.h"
 
 namespace UE::TouchEngine
@@ -57,6 +58,8 @@ namespace UE::TouchEngine
 		
 		FPendingFrameCook PendingCook { MoveTemp(CookFrameRequest) };
 		TFuture<FCookFrameResult> Future = PendingCook.PendingCookPromise.GetFuture();
+		INC_DWORD_STAT(STAT_TE_Cook_Requested);
+		CSV_CUSTOM_STAT(TouchEngine, CookRequested, 1, ECsvCustomStatOp::Accumulate);
 
 		{
 			FScopeLock Lock(&PendingFrameMutex);
@@ -80,6 +83,9 @@ namespace UE::TouchEngine
 			Severity = TEResultGetSeverity(Result);
 			CookResult = Severity == TESeverityError ? ECookFrameResult::InternalTouchEngineError : ECookFrameResult::Success; //todo: check with TD team
 		}
+
+		// All the TOP outputs of this cook have been received, so we can enqueue their copies together
+		ResourceProvider.GetImporter().FlushPendingCopies_AnyThread();
 		
 		FScopeLock Lock(&PendingFrameMutex);
 		if (ensure(InProgressCookResult))
@@ -96,6 +102,36 @@ namespace UE::TouchEngine
 			InProgressCookResult->TouchEngineInternalResult = Result;
 			InProgressCookResult->TECookStartTime = CookStartTime;
 			InProgressCookResult->TECookEndTime = CookEndTime;
+			InProgressCookResult->CookFinishedTime = FPlatformTime::Seconds() - GStartTime;
+
+			// We count what happened between the previous frame TouchEngine delivered and this one.
+			// This is only done for the cooks which end up being broadcast as successful, which is also what the component counts them with
+			RequestedTimeSinceLastDelivered += InProgressFrameCook.IsSet() ? InProgressFrameCook->FrameTimeInSeconds : 0.0;
+			if (CookResult == ECookFrameResult::Success && InProgressCookResult->Result == ECookFrameResult::Success)
+			{
+				const int64 FrameID = InProgressCookResult->FrameData.FrameID;
+				if (LastDeliveredFrameID > -1)
+				{
+					InProgressCookResult->NumFramesDiscarded = static_cast<int32>(FMath::Max<int64>(FrameID - LastDeliveredFrameID - 1, 0));
+					const double FrameGap = (CookStartTime - LastDeliveredTECookEndTime) * FrameRate.AsDecimal(); // in TouchEngine frames
+					// When we cook slower than TouchEngine's frame rate (CookRate or a slow tick), TouchEngine is expected to skip the frames in between
+					const double ExpectedFrameGap = FMath::Max(RequestedTimeSinceLastDelivered * FrameRate.AsDecimal() - 1.0, 0.0);
+					if (InProgressCookResult->bWasFrameDropped || FrameGap <= -0.5)
+					{
+						InProgressCookResult->NumFramesDuplicated = 1;
+					}
+					else
+					{
+						InProgressCookResult->NumFramesDropped = FMath::Max(0, FMath::RoundToInt32(FrameGap - ExpectedFrameGap));
+					}
+				}
+				LastDeliveredFrameID = FrameID;
+				RequestedTimeSinceLastDelivered = 0.0;
+				if (!InProgressCookResult->bWasFrameDropped) // a dropped frame has the start time of the previous frame, so the end time is not meaningful
+				{
+					LastDeliveredTECookEndTime = CookEndTime;
+				}
+			}
 		}
 		
 		if ((CookResult == ECookFrameResult::Success || CookResult == ECookFrameResult::Cancelled) && ensure(InProgressCookResult))
@@ -136,6 +172,7 @@ namespace UE::TouchEngine
 		while (!PendingCookQueue.IsEmpty())
 		{
 			FPendingFrameCook NextFrameCook = PendingCookQueue.Pop();
+			DEC_DWORD_STAT(STAT_TE_Cook_PendingQueueDepth);
 			NextFrameCook.PendingCookPromise.SetValue(FCookFrameResult::FromCookFrameRequest(NextFrameCook, ECookFrameResult::Cancelled, FrameLastUpdated));
 		}
 	}
@@ -176,6 +213,8 @@ namespace UE::TouchEngine
 		if (InProgressFrameCook && (FDateTime::Now() - InProgressFrameCook->JobStartTime).GetTotalSeconds() >= CookTimeoutInSeconds) // we check if the frame Timed-out
 		{
 			CancelCurrentFrame_GameThread(InProgressFrameCook->FrameData.FrameID, ECookFrameResult::TouchEngineCookTimeout);
+			INC_DWORD_STAT(STAT_TE_Cook_Timeouts);
+			CSV_CUSTOM_STAT(TouchEngine, CookTimeouts, 1, ECsvCustomStatOp::Accumulate);
 			return true;
 		}
 		return false;
@@ -186,6 +225,8 @@ namespace UE::TouchEngine
 		using namespace UE::TouchEngine;
 		
 		DECLARE_SCOPE_CYCLE_COUNTER(TEXT("  III.A [AT] ProcessLink"), STAT_TE_III_A, STATGROUP_TouchEngine);
+		const FTouchEngineInputFrameData FrameData = InProgressFrameCook.IsSet() ? InProgressFrameCook->FrameData : FTouchEngineInputFrameData();
+		TOUCHENGINE_TRACE_COOK_PHASE(LinkValueCallback, FrameData);
 		// Stash the state, we don't do any actual renderer work from this thread
 		TouchObject<TETexture> Texture = nullptr;
 		const TEResult Result = TEInstanceLinkGetTextureValue(TouchEngineInstance, Identifier, TELinkValueCurrent, Texture.take());
@@ -200,7 +241,7 @@ namespace UE::TouchEngine
 		const FName ParamId(Identifier);
 		VariableManager.AllocateLinkedTop(ParamId); // Avoid system querying this param from generating an output error
 
-		const FTouchImportParameters LinkParams{ TouchEngineInstance, ParamId, Texture, InProgressFrameCook.IsSet() ? InProgressFrameCook->FrameData : FTouchEngineInputFrameData() };
+		const FTouchImportParameters LinkParams{ TouchEngineInstance, ParamId, Texture, FrameData };
 		
 		// below calls FTouchTextureImporter::ImportTexture_AnyThread for DX12
 		const TSharedRef<FTouchFrameCooker> This = SharedThis(this);
@@ -212,8 +253,8 @@ namespace UE::TouchEngine
 				if (TouchLinkResult.ResultType == EImportResultType::Success)
 				{
 					UTexture2D* Texture = TouchLinkResult.ConvertedTextureObject.GetValue();
-					UE_LOG(LogTouchEngine, Verbose, TEXT("[ImportTextureToUnrealEngine_AnyThread.Next[%s]] Calling `UpdateLinkedTOP` for Identifier `%s` for frame %lld"),
-						*GetCurrentThreadStr(), *ParamId.ToString(), FrameID)
+					UE_LOG_TOUCHENGINE_HOT_PATH(Verbose, TEXT("[ImportTextureToUnrealEngine_AnyThread.Next[%s]] Calling `UpdateLinkedTOP` for Identifier `%s` for frame %lld"),
+						*GetCurrentThreadStr(), *ParamId.ToString(), FrameID);
 					ExistingTextureToBePooled = VariableManager.UpdateLinkedTOP(ParamId, Texture);
 				}
 				if (TouchLinkResult.PreviousTextureToBePooledPromise)
@@ -231,15 +272,18 @@ namespace UE::TouchEngine
 	void FTouchFrameCooker::EnqueueCookFrame(FPendingFrameCook&& CookRequest, int32 InputBufferLimit)
 	{
 		InputBufferLimit = FMath::Max(1, InputBufferLimit);
-		UE_LOG(LogTouchEngine, Log, TEXT("[EnqueueCookFrame[%s]] Enqueing Cook for frame %lld (%d cooks currently in the queue, InputBufferLimit is %d )"),
-			*GetCurrentThreadStr(), CookRequest.FrameData.FrameID, PendingCookQueue.Num(), InputBufferLimit)
+		UE_LOG_TOUCHENGINE_HOT_PATH(Log, TEXT("[EnqueueCookFrame[%s]] Enqueing Cook for frame %lld (%d cooks currently in the queue, InputBufferLimit is %d )"),
+			*GetCurrentThreadStr(), CookRequest.FrameData.FrameID, PendingCookQueue.Num(), InputBufferLimit);
 		
 		// here we remove one more item than the buffer limit as we are going to add the given CookRequest
 		while (!PendingCookQueue.IsEmpty() && PendingCookQueue.Num() >= InputBufferLimit)
 		{
 			FPendingFrameCook CookToCancel = PendingCookQueue.Pop();
-			UE_LOG(LogTouchEngine, Log, TEXT("[EnqueueCookFrame[%s]]   Cancelling Cook for frame %lld (%d cooks currently in the queue, InputBufferLimit is %d )"),
-				*GetCurrentThreadStr(), CookToCancel.FrameData.FrameID, PendingCookQueue.Num(), InputBufferLimit)
+			DEC_DWORD_STAT(STAT_TE_Cook_PendingQueueDepth);
+			INC_DWORD_STAT(STAT_TE_Cook_InputsDiscarded);
+			CSV_CUSTOM_STAT(TouchEngine, CookInputsDiscarded, 1, ECsvCustomStatOp::Accumulate);
+			UE_LOG_TOUCHENGINE_HOT_PATH(Log, TEXT("[EnqueueCookFrame[%s]]   Cancelling Cook for frame %lld (%d cooks currently in the queue, InputBufferLimit is %d )"),
+				*GetCurrentThreadStr(), CookToCancel.FrameData.FrameID, PendingCookQueue.Num(), InputBufferLimit);
 
 			// Before dropping the inputs, we are trying to merge them with the next set of inputs,
 			// which will end up sending them to TE unless they are being set by the next set of inputs
@@ -249,10 +293,12 @@ namespace UE::TouchEngine
 				NextFutureCook.VariablesToSend.FindOrAdd(Variable.Key, MoveTemp(Variable.Value));
 			}
 			
+			RequestedTimeSinceLastDelivered += CookToCancel.FrameTimeInSeconds; // The time still elapsed for TouchEngine
 			CookToCancel.PendingCookPromise.SetValue(FCookFrameResult::FromCookFrameRequest(CookToCancel, ECookFrameResult::InputsDiscarded, FrameLastUpdated));
 		}
 		
 		PendingCookQueue.Insert(MoveTemp(CookRequest), 0); // We enqueue at the start so we can easily use Pop to get the last element
+		INC_DWORD_STAT(STAT_TE_Cook_PendingQueueDepth);
 	}
 
 	bool FTouchFrameCooker::ExecuteNextPendingCookFrame_GameThread()
@@ -272,20 +318,25 @@ namespace UE::TouchEngine
 		{
 			DECLARE_SCOPE_CYCLE_COUNTER(TEXT("  I.B [GT] Cook Frame"), STAT_TE_I_B, STATGROUP_TouchEngine);
 			FPendingFrameCook CookRequest = PendingCookQueue.Pop();
+			DEC_DWORD_STAT(STAT_TE_Cook_PendingQueueDepth);
 
-			UE_LOG(LogTouchEngine, Log, TEXT("  --------- [FTouchFrameCooker::ExecuteCurrentCookFrame[%s]] Executing the cook for the frame %lld [Requested during frame %lld, Queue: %d cooks waiting] ---------"),
-			       *GetCurrentThreadStr(), CookRequest.FrameData.FrameID, GetNextFrameID() - 1, PendingCookQueue.Num())
+			UE_LOG_TOUCHENGINE_HOT_PATH(Log, TEXT("  --------- [FTouchFrameCooker::ExecuteCurrentCookFrame[%s]] Executing the cook for the frame %lld [Requested during frame %lld, Queue: %d cooks waiting] ---------"),
+			       *GetCurrentThreadStr(), CookRequest.FrameData.FrameID, GetNextFrameID() - 1, PendingCookQueue.Num());
 
 			// 1. First, we prepare the inputs to send
 			{
 				ResourceProvider.PrepareForNewCook(CookRequest.FrameData);
-				UE_LOG(LogTouchEngine, Verbose, TEXT("[ExecuteCurrentCookFrame[%s]] Calling `VariablesToSend.SendInputs` for frame %lld"),
-				       *GetCurrentThreadStr(), CookRequest.FrameData.FrameID)
-				for (TPair<FString, FTouchEngineDynamicVariableStruct>& Variable : CookRequest.VariablesToSend)
+				UE_LOG_TOUCHENGINE_HOT_PATH(Verbose, TEXT("[ExecuteCurrentCookFrame[%s]] Calling `VariablesToSend.SendInputs` for frame %lld"),
+				       *GetCurrentThreadStr(), CookRequest.FrameData.FrameID);
 				{
-					Variable.Value.SendInput(VariableManager, CookRequest.FrameData);
+					TOUCHENGINE_TRACE_COOK_PHASE(SendInput, CookRequest.FrameData);
+					for (TPair<FString, FTouchEngineDynamicVariableStruct>& Variable : CookRequest.VariablesToSend)
+					{
+						Variable.Value.SendInput(VariableManager, CookRequest.FrameData);
+					}
+					CookRequest.VariablesToSend.Reset();
 				}
-				CookRequest.VariablesToSend.Reset();
+				TOUCHENGINE_TRACE_COOK_PHASE(Export, CookRequest.FrameData);
 				ResourceProvider.FinalizeExportsToTouchEngine_GameThread(CookRequest.FrameData);
 			}
 
@@ -297,11 +348,13 @@ namespace UE::TouchEngine
 			// CookRequest.FrameTimeInSeconds += (FDateTime::Now() - CookRequest.JobCreationTime).GetTotalSeconds(); //todo: check with TE team if this should be added back
 			InProgressFrameCook.Emplace(MoveTemp(CookRequest));
 			InProgressFrameCook->JobStartTime = FDateTime::Now();
+			InProgressCookResult->CookStartedTime = FPlatformTime::Seconds() - GStartTime;
 
 			// This is unlocked before calling TEInstanceStartFrameAtTime in case for whatever reason it finishes cooking the frame instantly. That would cause a deadlock.
 			
 			PendingFrameMutexLock.Unlock();
 			
+			TOUCHENGINE_TRACE_COOK_PHASE(StartFrame, InProgressFrameCook->FrameData);
 			switch (TimeMode)
 			{
 			case TETimeInternal:
@@ -325,8 +378,15 @@ namespace UE::TouchEngine
 		}
 		
 		const bool bSuccess = Result == TEResultSuccess;
-		if (!bSuccess) //if we are successful, FTouchEngine::TouchEventCallback_AnyThread will be called with the event TEEventFrameDidFinish, and OnFrameFinishedCooking_AnyThread will be called
+		if (bSuccess) //if we are successful, FTouchEngine::TouchEventCallback_AnyThread will be called with the event TEEventFrameDidFinish, and OnFrameFinishedCooking_AnyThread will be called
+		{
+			INC_DWORD_STAT(STAT_TE_Cook_Started);
+			CSV_CUSTOM_STAT(TouchEngine, CookStarted, 1, ECsvCustomStatOp::Accumulate);
+		}
+		else
 		{
+			INC_DWORD_STAT(STAT_TE_Cook_FailedToStart);
+			CSV_CUSTOM_STAT(TouchEngine, CookFailedToStart, 1, ECsvCustomStatOp::Accumulate);
 			// This will reacquire a lock - a bit meh but should not happen often
 			InProgressCookResult->Result = ECookFrameResult::FailedToStartCook;
 			FinishCurrentCookFrame_AnyThread();
@@ -336,7 +396,7 @@ namespace UE::TouchEngine
 
 	void FTouchFrameCooker::FinishCurrentCookFrame_AnyThread()
 	{
-		UE_LOG(LogTouchEngine, Log, TEXT("FinishCurrentCookFrame_AnyThread[%s]"), *GetCurrentThreadStr())
+		UE_LOG_TOUCHENGINE_HOT_PATH(Log, TEXT("FinishCurrentCookFrame_AnyThread[%s]"), *GetCurrentThreadStr());
 		FScopeLock Lock(&PendingFrameMutex);
 		if (InProgressFrameCook.IsSet())
 		{
@@ -348,7 +408,9 @@ namespace UE::TouchEngine
 					FScopeLock Lock(&SharedThis->PendingFrameMutex);
 					SharedThis->InProgressFrameCook.Reset();
 					SharedThis->InProgressCookResult.Reset();
-					SharedThis->ResourceProvider.GetImporter().TexturePoolMaintenance(FrameData);
+					FTouchTextureImporter& Importer = SharedThis->ResourceProvider.GetImporter();
+					Importer.FlushPendingCopies_AnyThread(); // in case some TOP outputs were received after the cook was done
+					Importer.TexturePoolMaintenance(FrameData);
 				}
 			});
 			InProgressFrameCook->PendingCookPromise.SetValue(*InProgressCookResult);
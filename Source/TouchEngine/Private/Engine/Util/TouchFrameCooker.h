@@ -16,6 +16,7 @@
 
 #include "CoreMinimal.h"
 #include "Async/Future.h"
+#include "Misc/FrameRate.h"
 #include "Engine/Util/CookFrameData.h"
 #include "Engine/Util/TouchVariableManager.h"
 #include "TouchEngine/TEInstance.h"
@@ -39,6 +40,8 @@ namespace UE::TouchEngine
 		~FTouchFrameCooker();
 
 		void SetTimeMode(TETimeMode InTimeMode) { TimeMode = InTimeMode; }
+		/** Sets the frame rate TouchEngine is running at, used to count the frames dropped between two cooks */
+		void SetFrameRate(FFrameRate InFrameRate) { FrameRate = InFrameRate; }
 
 		TFuture<FCookFrameResult> CookFrame_GameThread(FCookFrameRequest&& CookFrameRequest, int32 InputBufferLimit);
 		bool ExecuteNextPendingCookFrame_GameThread();
@@ -68,6 +71,13 @@ namespace UE::TouchEngine
 		/** returns the FrameID of the current cooking frame, or -1 if no frame is cooking */
 		int64 GetCookingFrameID() const { return InProgressFrameCook.IsSet() ? InProgressFrameCook->FrameData.FrameID : -1; }
 
+		/** Returns the number of cooks waiting for the current cook to be done */
+		int32 GetNumPendingCooks() const
+		{
+			FScopeLock Lock(&PendingCookQueueMutex);
+			return PendingCookQueue.Num();
+		}
+
 		void ProcessLinkTextureValueChanged_AnyThread(const char* Identifier);
 		void ResetTouchEngineInstance();
 
@@ -95,6 +105,14 @@ namespace UE::TouchEngine
 		/** The last frame we receive a successful cook that was not skipped */
 		int64 FrameLastUpdated = -1;
 
+		FFrameRate FrameRate = FFrameRate(60, 1);
+		/** The FrameID of the last cook TouchEngine delivered a frame for, even if it was dropped. -1 if TouchEngine has not delivered any frame yet */
+		int64 LastDeliveredFrameID = -1;
+		/** The TE end time of the last frame TouchEngine delivered which was not dropped, in seconds */
+		double LastDeliveredTECookEndTime = 0.0;
+		/** The sum of the FrameTimeInSeconds of the cooks since the last frame TouchEngine delivered, in seconds */
+		double RequestedTimeSinceLastDelivered = 0.0;
+
 		/** Must be obtained to read or write InProgressFrameCook. */
 		FCriticalSection PendingFrameMutex;
 		/** The cook frame request that is currently in progress if any. */
@@ -104,7 +122,7 @@ namespace UE::TouchEngine
 		
 		/** The next frame cooks to execute after InProgressFrameCook is done. Implemented as Array to have access to size and keep FPendingFrameCook.Promise not shared*/
 		TArray<FPendingFrameCook> PendingCookQueue;
-		FCriticalSection PendingCookQueueMutex;
+		mutable FCriticalSection PendingCookQueueMutex;
 
 		/**
 		 * Enqueue the given Cook Request to be processed. There should be a lock to PendingCookQueueMutex before calling this function.
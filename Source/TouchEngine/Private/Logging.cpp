@@ -13,3 +13,17 @@
 */
 
 #include "Logging.h"
+
+#include "HAL/IConsoleManager.h"
+
+#if WITH_TOUCHENGINE_HOT_PATH_LOG
+namespace UE::TouchEngine
+{
+	bool GEnableHotPathLog = false;
+
+	static FAutoConsoleVariableRef CVarEnableHotPathLog(
+		TEXT("TouchEngine.Log.HotPath"),
+		GEnableHotPathLog,
+		TEXT("If true, the per-frame diagnostics of the cook pipeline (cook start and end, texture imports, link value callbacks...) are logged to LogTouchEngineHotPath. Not available in Shipping and Test builds."));
+}
+#endif
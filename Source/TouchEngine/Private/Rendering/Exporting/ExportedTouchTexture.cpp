@@ -76,7 +76,7 @@ namespace UE::TouchEngine
 			return;
 		}
 
-		UE_LOG(LogTouchEngine, Verbose, TEXT("[FExportedTouchTexture::OnTouchTextureUseUpdate] `%s` for texture `%s`"), *TEObjectEventToString(Event), *DebugName)
+		UE_LOG_TOUCHENGINE_HOT_PATH(Verbose, TEXT("[FExportedTouchTexture::OnTouchTextureUseUpdate] `%s` for texture `%s`"), *TEObjectEventToString(Event), *DebugName);
 		
 		switch (Event)
 		{
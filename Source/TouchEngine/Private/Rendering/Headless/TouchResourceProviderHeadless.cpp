@@ -0,0 +1,145 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#include "Rendering/Headless/TouchResourceProviderHeadless.h"
+
+#include "ITouchEngineModule.h"
+#include "Rendering/TouchResourceProvider.h"
+#include "Rendering/Headless/TouchTextureExporterHeadless.h"
+#include "Rendering/Headless/TouchTextureImporterHeadless.h"
+#include "Util/FutureSyncPoint.h"
+
+namespace UE::TouchEngine::Headless
+{
+	/** Resource provider keeping all the textures in host memory, used when there is no GPU */
+	class FTouchResourceProviderHeadless : public FTouchResourceProvider
+	{
+	public:
+
+		virtual void ConfigureInstance(const TouchObject<TEInstance>& Instance) override {}
+		virtual TEGraphicsContext* GetContext() const override { return nullptr; }
+		virtual FTouchLoadInstanceResult ValidateLoadedTouchEngine(TEInstance& Instance) override { return FTouchLoadInstanceResult::MakeSuccess(); }
+		virtual TSet<EPixelFormat> GetExportablePixelTypes(TEInstance& Instance) override;
+		virtual TouchObject<TETexture> ExportTextureToTouchEngineInternal_AnyThread(const FTouchExportParameters& Params) override;
+		virtual void InitializeExportsToTouchEngine_GameThread(const FTouchEngineInputFrameData& FrameData) override;
+		virtual void FinalizeExportsToTouchEngine_GameThread(const FTouchEngineInputFrameData& FrameData) override;
+		virtual TFuture<FTouchSuspendResult> SuspendAsyncTasks_GameThread() override;
+		virtual bool SetExportedTexturePoolSize(int ExportedTexturePoolSize) override;
+		virtual bool SetImportedTexturePoolSize(int ImportedTexturePoolSize) override;
+		virtual bool SetExportedTexturePoolBudget(int64 ExportedTexturePoolBudgetBytes) override;
+		virtual bool SetImportedTexturePoolBudget(int64 ImportedTexturePoolBudgetBytes) override;
+		virtual bool SetExportedTexturePoolAdaptiveSizing(bool bEnabled, int32 MinPoolSize) override;
+		virtual bool SetImportedTexturePoolAdaptiveSizing(bool bEnabled, int32 MinPoolSize) override;
+		virtual bool PrewarmExportedTexturePool_GameThread(const TArray<FTouchEngineTextureDescriptor>& Descriptors) override;
+		virtual TArray<FTouchEngineTextureDescriptor> GetObservedExportedTextureDescriptors() override;
+		virtual FTouchTextureImporter& GetImporter() override { return TextureImporter.Get(); }
+
+	private:
+
+		TSharedRef<FTouchTextureExporterHeadless> TextureExporter = MakeShared<FTouchTextureExporterHeadless>();
+		TSharedRef<FTouchTextureImporterHeadless> TextureImporter = MakeShared<FTouchTextureImporterHeadless>();
+	};
+
+	TSharedPtr<FTouchResourceProvider> MakeHeadlessResourceProvider(const FResourceProviderInitArgs& InitArgs)
+	{
+		return MakeShared<FTouchResourceProviderHeadless>();
+	}
+
+	TSet<EPixelFormat> FTouchResourceProviderHeadless::GetExportablePixelTypes(TEInstance& Instance)
+	{
+		// Host memory can hold any uncompressed format, we only exclude the ones the other RHIs cannot share either
+		return {
+			PF_B8G8R8A8, PF_R8G8B8A8, PF_G8, PF_R8, PF_R8G8, PF_G16, PF_R16F, PF_G16R16, PF_G16R16F,
+			PF_FloatRGBA, PF_R16G16B16A16_UNORM, PF_R32_FLOAT, PF_G32R32F, PF_A32B32G32R32F, PF_A2B10G10R10
+		};
+	}
+
+	TouchObject<TETexture> FTouchResourceProviderHeadless::ExportTextureToTouchEngineInternal_AnyThread(const FTouchExportParameters& Params)
+	{
+		return TextureExporter->ExportTextureToTouchEngine_AnyThread(Params, GetContext());
+	}
+
+	void FTouchResourceProviderHeadless::InitializeExportsToTouchEngine_GameThread(const FTouchEngineInputFrameData& FrameData)
+	{
+		TextureExporter->InitializeExportsToTouchEngine_GameThread(FrameData);
+	}
+
+	void FTouchResourceProviderHeadless::FinalizeExportsToTouchEngine_GameThread(const FTouchEngineInputFrameData& FrameData)
+	{
+		TextureExporter->FinalizeExportsToTouchEngine_GameThread(FrameData);
+	}
+
+	TFuture<FTouchSuspendResult> FTouchResourceProviderHeadless::SuspendAsyncTasks_GameThread()
+	{
+		TPromise<FTouchSuspendResult> Promise;
+		TFuture<FTouchSuspendResult> Future = Promise.GetFuture();
+		
+		TArray<TFuture<FTouchSuspendResult>> Futures;
+		Futures.Emplace(TextureExporter->SuspendAsyncTasks());
+		Futures.Emplace(TextureImporter->SuspendAsyncTasks());
+		FFutureSyncPoint::SyncFutureCompletion<FTouchSuspendResult>(Futures, [Promise = MoveTemp(Promise)]() mutable
+		{
+			Promise.SetValue(FTouchSuspendResult{});
+		});
+		
+		return Future;
+	}
+
+	bool FTouchResourceProviderHeadless::SetExportedTexturePoolSize(int ExportedTexturePoolSize)
+	{
+		TextureExporter->PoolSize = FMath::Max(ExportedTexturePoolSize, 0);
+		return true;
+	}
+
+	bool FTouchResourceProviderHeadless::SetImportedTexturePoolSize(int ImportedTexturePoolSize)
+	{
+		TextureImporter->PoolSize = FMath::Max(ImportedTexturePoolSize, 0);
+		return true;
+	}
+
+	bool FTouchResourceProviderHeadless::SetExportedTexturePoolBudget(int64 ExportedTexturePoolBudgetBytes)
+	{
+		TextureExporter->PoolBudgetBytes = FMath::Max<int64>(ExportedTexturePoolBudgetBytes, 0);
+		return true;
+	}
+
+	bool FTouchResourceProviderHeadless::SetImportedTexturePoolBudget(int64 ImportedTexturePoolBudgetBytes)
+	{
+		TextureImporter->PoolBudgetBytes = FMath::Max<int64>(ImportedTexturePoolBudgetBytes, 0);
+		return true;
+	}
+
+	bool FTouchResourceProviderHeadless::SetExportedTexturePoolAdaptiveSizing(bool bEnabled, int32 MinPoolSize)
+	{
+		TextureExporter->SetAdaptivePoolSize(bEnabled, MinPoolSize);
+		return true;
+	}
+
+	bool FTouchResourceProviderHeadless::SetImportedTexturePoolAdaptiveSizing(bool bEnabled, int32 MinPoolSize)
+	{
+		TextureImporter->SetAdaptivePoolSize(bEnabled, MinPoolSize);
+		return true;
+	}
+
+	bool FTouchResourceProviderHeadless::PrewarmExportedTexturePool_GameThread(const TArray<FTouchEngineTextureDescriptor>& Descriptors)
+	{
+		TextureExporter->PrewarmPool(Descriptors);
+		return true;
+	}
+
+	TArray<FTouchEngineTextureDescriptor> FTouchResourceProviderHeadless::GetObservedExportedTextureDescriptors()
+	{
+		return TextureExporter->GetObservedDescriptors();
+	}
+}
@@ -0,0 +1,271 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#include "Rendering/Headless/TouchTextureExporterHeadless.h"
+
+#include "Logging.h"
+#include "RenderingThread.h"
+#include "RHICommandList.h"
+#include "Rendering/TouchResourceProvider.h"
+#include "Rendering/TouchSuspendResult.h"
+#include "Rendering/Exporting/TouchExportParams.h"
+#include "Util/TouchEngineStatsGroup.h"
+#include "Util/TouchHelpers.h"
+
+namespace UE::TouchEngine::Headless
+{
+	FTouchTextureExporterHeadless::~FTouchTextureExporterHeadless()
+	{
+		FScopeLock Lock(&PooledTextureMutex);
+		TexturePool.Empty();
+		NumPooledTextures = 0;
+		PooledBytes = 0;
+		UpdatePoolStats(0); // removes this pool from the stats
+	}
+
+	void FTouchTextureExporterHeadless::SetAdaptivePoolSize(bool bEnabled, int32 MinPoolSize)
+	{
+		FScopeLock Lock(&PooledTextureMutex);
+		PoolSizer.SetEnabled(bEnabled, MinPoolSize);
+	}
+
+	void FTouchTextureExporterHeadless::PrewarmPool(const TArray<FTouchEngineTextureDescriptor>& Descriptors)
+	{
+		FScopeLock Lock(&PooledTextureMutex);
+		for (const FTouchEngineTextureDescriptor& EngineDescriptor : Descriptors)
+		{
+			if (EngineDescriptor.SizeX <= 0 || EngineDescriptor.SizeY <= 0 || EngineDescriptor.PixelFormat == PF_Unknown || EngineDescriptor.Count <= 0)
+			{
+				continue;
+			}
+
+			FTouchExportTextureDescriptor Descriptor;
+			Descriptor.Size = FIntPoint(EngineDescriptor.SizeX, EngineDescriptor.SizeY);
+			Descriptor.PixelFormat = EngineDescriptor.PixelFormat;
+			Descriptor.NumMips = FMath::Max(EngineDescriptor.NumMips, 1);
+			Descriptor.NumSamples = 1;
+			Descriptor.bIsSRGB = EngineDescriptor.bIsSRGB;
+			for (int32 i = 0; i < EngineDescriptor.Count; ++i)
+			{
+				TSharedPtr<FHostTexture, ESPMode::ThreadSafe> Texture = MakeShared<FHostTexture, ESPMode::ThreadSafe>();
+				Texture->Descriptor = Descriptor;
+				Texture->Pixels.SetNumUninitialized(Descriptor.GetSizeInBytes());
+				INC_DWORD_STAT(STAT_TE_ExportedTexturePool_NbTexturesTotal)
+				AddTextureToPool(MoveTemp(Texture));
+			}
+		}
+		UpdatePoolStats(PoolSizer.GetPoolSize(PoolSize));
+	}
+
+	TArray<FTouchEngineTextureDescriptor> FTouchTextureExporterHeadless::GetObservedDescriptors()
+	{
+		FScopeLock Lock(&PooledTextureMutex);
+		TArray<FTouchEngineTextureDescriptor> Descriptors;
+		for (const TPair<FTouchExportTextureDescriptor, int32>& Observed : ObservedPeakRequestsPerFrame)
+		{
+			FTouchEngineTextureDescriptor& Descriptor = Descriptors.AddDefaulted_GetRef();
+			Descriptor.SizeX = Observed.Key.Size.X;
+			Descriptor.SizeY = Observed.Key.Size.Y;
+			Descriptor.PixelFormat = Observed.Key.PixelFormat;
+			Descriptor.NumMips = Observed.Key.NumMips;
+			Descriptor.bIsSRGB = Observed.Key.bIsSRGB;
+			// the host textures of the previous cook can still be copied into on the render thread while we export the next ones, so we need two textures per request
+			Descriptor.Count = Observed.Value * 2;
+		}
+		return Descriptors;
+	}
+
+	void FTouchTextureExporterHeadless::InitializeExportsToTouchEngine_GameThread(const FTouchEngineInputFrameData& FrameData)
+	{
+		FScopeLock Lock(&PooledTextureMutex);
+		// The textures of the previous cook go back to the pool. They will only be reused once the render thread is done copying into them
+		for (TSharedPtr<FHostTexture, ESPMode::ThreadSafe>& Texture : TexturesInUse)
+		{
+			AddTextureToPool(MoveTemp(Texture));
+		}
+		TexturesInUse.Reset();
+		TextureExports.Reset();
+		RequestsThisFrame.Reset();
+	}
+
+	void FTouchTextureExporterHeadless::FinalizeExportsToTouchEngine_GameThread(const FTouchEngineInputFrameData& FrameData)
+	{
+		TexturePoolMaintenance();
+		
+		TArray<FExportCopy> Copies;
+		{
+			FScopeLock Lock(&PooledTextureMutex);
+			Copies = MoveTemp(TextureExports);
+		}
+		if (Copies.IsEmpty())
+		{
+			return;
+		}
+		
+		ENQUEUE_RENDER_COMMAND(AccessTexture)([WeakThis = AsWeak(), Copies = MoveTemp(Copies), TaskToken = StartAsyncTask()](FRHICommandListImmediate& RHICmdList)
+		{
+			const TSharedPtr<FTouchTextureExporter> ThisPin = WeakThis.Pin();
+			if (!ThisPin || ThisPin->IsSuspended())
+			{
+				return;
+			}
+			
+			DECLARE_SCOPE_CYCLE_COUNTER(TEXT("    I.B.4 [RT] Cook Frame - Copy To Host Memory"), STAT_TE_I_B_4_Headless, STATGROUP_TouchEngine);
+			for (const FExportCopy& Copy : Copies)
+			{
+				const FTouchExportTextureDescriptor& Descriptor = Copy.Destination->Descriptor;
+				const uint32 BytesPerRow = static_cast<uint32>(Descriptor.Size.X / GPixelFormats[Descriptor.PixelFormat].BlockSizeX) * GPixelFormats[Descriptor.PixelFormat].BlockBytes;
+				const uint32 NumRows = Descriptor.Size.Y / GPixelFormats[Descriptor.PixelFormat].BlockSizeY;
+				
+				uint32 SourceStride = 0;
+				const uint8* Source = static_cast<const uint8*>(RHICmdList.LockTexture2D(Copy.SourceRHI, 0, RLM_ReadOnly, SourceStride, false));
+				if (Source && Copy.Destination->Pixels.Num() >= static_cast<int64>(BytesPerRow) * NumRows)
+				{
+					for (uint32 Row = 0; Row < NumRows; ++Row)
+					{
+						FMemory::Memcpy(Copy.Destination->Pixels.GetData() + Row * BytesPerRow, Source + Row * SourceStride, BytesPerRow);
+					}
+				}
+				RHICmdList.UnlockTexture2D(Copy.SourceRHI, 0, false);
+			}
+		}); // ~ENQUEUE_RENDER_COMMAND(AccessTexture)
+	}
+
+	TFuture<FTouchSuspendResult> FTouchTextureExporterHeadless::SuspendAsyncTasks()
+	{
+		{
+			FScopeLock Lock(&PooledTextureMutex);
+			TextureExports.Reset();
+		}
+		return FTouchTextureExporter::SuspendAsyncTasks();
+	}
+
+	TouchObject<TETexture> FTouchTextureExporterHeadless::ExportTexture_AnyThread(const FTouchExportParameters& Params, TEGraphicsContext* GraphicsContext)
+	{
+		DECLARE_SCOPE_CYCLE_COUNTER(TEXT("    I.B.1 [GT] Cook Frame - GetOrCreateTexture"), STAT_TE_I_B_1_Headless, STATGROUP_TouchEngine);
+		FTextureRHIRef SourceRHI = FTouchResourceProvider::GetStableRHIFromTexture(Params.Texture);
+		if (!SourceRHI)
+		{
+			UE_LOG(LogTouchEngine, Warning, TEXT("[FTouchTextureExporterHeadless::ExportTexture_AnyThread[%s]] Unable to get the RHI of the texture to export. %s"), *GetCurrentThreadStr(), *Params.GetDebugDescription());
+			return nullptr;
+		}
+
+		const FTouchExportTextureDescriptor Descriptor(SourceRHI);
+		{
+			FScopeLock Lock(&PooledTextureMutex);
+			TSharedPtr<FHostTexture, ESPMode::ThreadSafe> HostTexture = GetOrCreateHostTexture(Descriptor);
+			TexturesInUse.Add(HostTexture);
+			TextureExports.Add({ MoveTemp(SourceRHI), MoveTemp(HostTexture) });
+		}
+		UE_LOG_TOUCHENGINE_HOT_PATH(Verbose, TEXT("[FTouchTextureExporterHeadless::ExportTexture_AnyThread[%s]] Copying the texture to host memory. %s"), *GetCurrentThreadStr(), *Params.GetDebugDescription());
+		
+		// There is no texture TouchEngine could use, so the TOP input is set to null
+		return nullptr;
+	}
+
+	TSharedPtr<FTouchTextureExporterHeadless::FHostTexture, ESPMode::ThreadSafe> FTouchTextureExporterHeadless::GetOrCreateHostTexture(const FTouchExportTextureDescriptor& Descriptor)
+	{
+		// 1. We keep track of the number of textures needed per frame, to be returned by GetObservedDescriptors
+		int32& NumRequests = RequestsThisFrame.FindOrAdd(Descriptor);
+		++NumRequests;
+		int32& PeakRequests = ObservedPeakRequestsPerFrame.FindOrAdd(Descriptor);
+		PeakRequests = FMath::Max(PeakRequests, NumRequests);
+
+		// 2. We reuse the oldest pooled texture the render thread is done with
+		if (TArray<TSharedPtr<FHostTexture, ESPMode::ThreadSafe>>* Bucket = TexturePool.Find(Descriptor))
+		{
+			const int32 Index = Bucket->IndexOfByPredicate([](const TSharedPtr<FHostTexture, ESPMode::ThreadSafe>& Texture) { return Texture.IsUnique(); });
+			if (Index != INDEX_NONE)
+			{
+				TSharedPtr<FHostTexture, ESPMode::ThreadSafe> Texture = (*Bucket)[Index];
+				Bucket->RemoveAt(Index);
+				if (Bucket->IsEmpty())
+				{
+					TexturePool.Remove(Descriptor);
+				}
+				--NumPooledTextures;
+				PooledBytes -= Texture->Pixels.Num();
+				INC_DWORD_STAT(STAT_TE_ExportedTexturePool_Hits)
+				PoolSizer.RecordRequest(true);
+				return Texture;
+			}
+		}
+
+		// 3. Otherwise we allocate a new one
+		INC_DWORD_STAT(STAT_TE_ExportedTexturePool_Misses)
+		INC_DWORD_STAT(STAT_TE_ExportedTexturePool_NbTexturesTotal)
+		PoolSizer.RecordRequest(false);
+		TSharedPtr<FHostTexture, ESPMode::ThreadSafe> Texture = MakeShared<FHostTexture, ESPMode::ThreadSafe>();
+		Texture->Descriptor = Descriptor;
+		Texture->Pixels.SetNumUninitialized(Descriptor.GetSizeInBytes());
+		return Texture;
+	}
+
+	void FTouchTextureExporterHeadless::AddTextureToPool(TSharedPtr<FHostTexture, ESPMode::ThreadSafe> Texture)
+	{
+		Texture->PooledOrder = NextPooledOrder++;
+		++NumPooledTextures;
+		PooledBytes += Texture->Pixels.Num();
+		TexturePool.FindOrAdd(Texture->Descriptor).Add(MoveTemp(Texture));
+	}
+
+	void FTouchTextureExporterHeadless::TexturePoolMaintenance()
+	{
+		FScopeLock Lock(&PooledTextureMutex);
+		PoolSizer.RecordFrame(NumPooledTextures, PoolSize);
+		const int32 TargetPoolSize = PoolSizer.GetPoolSize(PoolSize);
+		while (NumPooledTextures > TargetPoolSize || (PoolBudgetBytes > 0 && PooledBytes > PoolBudgetBytes))
+		{
+			// we evict the texture which has been in the pool the longest. Each bucket is ordered from the oldest to the newest texture
+			TPair<FTouchExportTextureDescriptor, TArray<TSharedPtr<FHostTexture, ESPMode::ThreadSafe>>>* OldestBucket = nullptr;
+			for (TPair<FTouchExportTextureDescriptor, TArray<TSharedPtr<FHostTexture, ESPMode::ThreadSafe>>>& Bucket : TexturePool)
+			{
+				if (!Bucket.Value.IsEmpty() && (!OldestBucket || Bucket.Value[0]->PooledOrder < OldestBucket->Value[0]->PooledOrder))
+				{
+					OldestBucket = &Bucket;
+				}
+			}
+			if (!OldestBucket)
+			{
+				break;
+			}
+			// the render thread might still be copying into it, in which case it keeps it alive until it is done
+			PooledBytes -= OldestBucket->Value[0]->Pixels.Num();
+			--NumPooledTextures;
+			OldestBucket->Value.RemoveAt(0);
+			if (OldestBucket->Value.IsEmpty())
+			{
+				const FTouchExportTextureDescriptor Descriptor = OldestBucket->Key; // copied as the pair is destroyed while being removed
+				TexturePool.Remove(Descriptor);
+			}
+			INC_DWORD_STAT(STAT_TE_ExportedTexturePool_Evictions)
+			DEC_DWORD_STAT(STAT_TE_ExportedTexturePool_NbTexturesTotal)
+		}
+
+		UpdatePoolStats(TargetPoolSize);
+	}
+
+	void FTouchTextureExporterHeadless::UpdatePoolStats(int32 TargetPoolSize)
+	{
+		DEC_DWORD_STAT_BY(STAT_TE_ExportedTexturePool_NbTexturesPool, ReportedNumPooledTextures)
+		DEC_DWORD_STAT_BY(STAT_TE_ExportedTexturePool_TargetSize, ReportedTargetPoolSize)
+		DEC_MEMORY_STAT_BY(STAT_TE_ExportedTexturePool_ResidentBytes, ReportedPooledBytes)
+		ReportedNumPooledTextures = NumPooledTextures;
+		ReportedTargetPoolSize = TargetPoolSize;
+		ReportedPooledBytes = PooledBytes;
+		INC_DWORD_STAT_BY(STAT_TE_ExportedTexturePool_NbTexturesPool, ReportedNumPooledTextures)
+		INC_DWORD_STAT_BY(STAT_TE_ExportedTexturePool_TargetSize, ReportedTargetPoolSize)
+		INC_MEMORY_STAT_BY(STAT_TE_ExportedTexturePool_ResidentBytes, ReportedPooledBytes)
+	}
+}
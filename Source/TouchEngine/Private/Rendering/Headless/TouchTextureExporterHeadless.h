@@ -0,0 +1,100 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Blueprint/TouchEngineTextureDescriptor.h"
+#include "Rendering/Exporting/ExportedTouchTextureCache.h"
+#include "Rendering/Exporting/TouchTextureExporter.h"
+#include "Util/TouchTexturePoolSizer.h"
+
+namespace UE::TouchEngine::Headless
+{
+	/**
+	 * Exports the Unreal textures to host memory instead of sharing them with TouchEngine.
+	 * The host textures are pooled and trimmed the same way as the shared textures of the other RHIs, so the export pool settings and stats apply.
+	 */
+	class FTouchTextureExporterHeadless : public FTouchTextureExporter
+	{
+	public:
+		/** The maximum size of the Exporting texture pool */
+		int32 PoolSize = 20;
+		/** The maximum host memory, in bytes, the textures of the pool can take. 0 means the pool is only bounded by PoolSize */
+		int64 PoolBudgetBytes = 0;
+
+		virtual ~FTouchTextureExporterHeadless() override;
+
+		void SetAdaptivePoolSize(bool bEnabled, int32 MinPoolSize);
+		/** Creates host textures matching the given descriptors and adds them to the pool, so the first cooks do not need to allocate them */
+		void PrewarmPool(const TArray<FTouchEngineTextureDescriptor>& Descriptors);
+		/** Returns the descriptors of the textures exported so far, with the number of textures needed to export them without having to allocate new ones */
+		TArray<FTouchEngineTextureDescriptor> GetObservedDescriptors();
+
+		void InitializeExportsToTouchEngine_GameThread(const FTouchEngineInputFrameData& FrameData);
+		void FinalizeExportsToTouchEngine_GameThread(const FTouchEngineInputFrameData& FrameData);
+		
+		//~ Begin FTouchTextureExporter Interface
+		virtual TFuture<FTouchSuspendResult> SuspendAsyncTasks() override;
+		//~ End FTouchTextureExporter Interface
+
+	protected:
+
+		//~ Begin FTouchTextureExporter Interface
+		virtual TouchObject<TETexture> ExportTexture_AnyThread(const FTouchExportParameters& Params, TEGraphicsContext* GraphicsContext) override;
+		//~ End FTouchTextureExporter Interface
+
+	private:
+
+		struct FHostTexture
+		{
+			FTouchExportTextureDescriptor Descriptor;
+			TArray64<uint8> Pixels;
+			/** Incremented each time a texture is added to the pool, used to evict the textures which have been in the pool the longest */
+			uint64 PooledOrder = 0;
+		};
+		struct FExportCopy
+		{
+			FTextureRHIRef SourceRHI;
+			/** Also keeps the host texture out of the pool until the copy is done */
+			TSharedPtr<FHostTexture, ESPMode::ThreadSafe> Destination;
+		};
+		
+		FCriticalSection PooledTextureMutex;
+		/** The pool of available host textures, bucketed by descriptor. A texture is only reused once the render thread released it */
+		TMap<FTouchExportTextureDescriptor, TArray<TSharedPtr<FHostTexture, ESPMode::ThreadSafe>>> TexturePool;
+		int32 NumPooledTextures = 0;
+		int64 PooledBytes = 0;
+		uint64 NextPooledOrder = 0;
+		/** The maximum number of textures requested during a single frame for each descriptor */
+		TMap<FTouchExportTextureDescriptor, int32> ObservedPeakRequestsPerFrame;
+		TMap<FTouchExportTextureDescriptor, int32> RequestsThisFrame;
+		FTouchTexturePoolSizer PoolSizer;
+		/** What this pool last added to the stats. Each instance only adds its own changes so the stats sum the pools of all the instances */
+		int32 ReportedNumPooledTextures = 0;
+		int32 ReportedTargetPoolSize = 0;
+		int64 ReportedPooledBytes = 0;
+		
+		/** The copies requested during the current cook, enqueued in FinalizeExportsToTouchEngine_GameThread */
+		TArray<FExportCopy> TextureExports;
+		/** The host textures used by the previous cook, returned to the pool at the start of the next one */
+		TArray<TSharedPtr<FHostTexture, ESPMode::ThreadSafe>> TexturesInUse;
+
+		TSharedPtr<FHostTexture, ESPMode::ThreadSafe> GetOrCreateHostTexture(const FTouchExportTextureDescriptor& Descriptor);
+		void AddTextureToPool(TSharedPtr<FHostTexture, ESPMode::ThreadSafe> Texture);
+		void TexturePoolMaintenance();
+		/** Updates the stats tracking the content of the pool. Expects the PooledTextureMutex to be locked */
+		void UpdatePoolStats(int32 TargetPoolSize);
+	};
+}
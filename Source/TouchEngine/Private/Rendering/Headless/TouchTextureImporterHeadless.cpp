@@ -0,0 +1,82 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#include "Rendering/Headless/TouchTextureImporterHeadless.h"
+
+#include "HAL/IConsoleManager.h"
+#include "RHICommandList.h"
+
+namespace UE::TouchEngine::Headless
+{
+	static TAutoConsoleVariable<FString> CVarHeadlessImportedTextureSize(
+		TEXT("TouchEngine.Headless.ImportedTextureSize"),
+		TEXT("256x256"),
+		TEXT("The size, as WidthxHeight, of the textures imported from TouchEngine when running without a GPU."));
+
+	ECopyTouchToUnrealResult FTouchImportTextureHeadless::CopyNativeToUnrealRHI_RenderThread(const FTouchCopyTextureArgs& CopyArgs, TSharedRef<FTouchTextureImporter> Importer)
+	{
+		if (!CanCopyInto(CopyArgs.TargetRHI))
+		{
+			return ECopyTouchToUnrealResult::Failure;
+		}
+
+		const uint32 SourcePitch = MetaData.SizeX * GPixelFormats[MetaData.PixelFormat].BlockBytes;
+		const FUpdateTextureRegion2D Region(0, 0, 0, 0, MetaData.SizeX, MetaData.SizeY);
+		CopyArgs.RHICmdList.UpdateTexture2D(CopyArgs.TargetRHI, 0, Region, SourcePitch, Pixels->GetData());
+		return ECopyTouchToUnrealResult::Success;
+	}
+
+	void FTouchImportTextureHeadless::OnCurrentCopyDone_RenderThread(FRHICommandListImmediate& RHICmdList, TUniqueFunction<void()>&& Callback)
+	{
+		// The upload is done once the RHI thread executed it, there is no GPU work to wait for
+		RHICmdList.EnqueueLambda([Callback = MoveTemp(Callback)](FRHICommandListImmediate&)
+		{
+			Callback();
+		});
+	}
+
+	TSharedPtr<ITouchImportTexture> FTouchTextureImporterHeadless::CreatePlatformTexture_RenderThread(const TouchObject<TEInstance>& Instance, const TouchObject<TETexture>& SharedTexture)
+	{
+		const FTextureMetaData MetaData = GetTextureMetaData(SharedTexture);
+		const FTouchImportTextureDescriptor Descriptor(MetaData);
+		const TSharedRef<TArray64<uint8>, ESPMode::ThreadSafe>* Pixels = SourcePixels.Find(Descriptor);
+		if (!Pixels)
+		{
+			TSharedRef<TArray64<uint8>, ESPMode::ThreadSafe> NewPixels = MakeShared<TArray64<uint8>, ESPMode::ThreadSafe>();
+			NewPixels->SetNumZeroed(static_cast<int64>(MetaData.SizeX) * MetaData.SizeY * GPixelFormats[MetaData.PixelFormat].BlockBytes);
+			Pixels = &SourcePixels.Add(Descriptor, MoveTemp(NewPixels));
+		}
+		return MakeShared<FTouchImportTextureHeadless>(MetaData, *Pixels);
+	}
+
+	FTextureMetaData FTouchTextureImporterHeadless::GetTextureMetaData(const TouchObject<TETexture>& Texture) const
+	{
+		FTextureMetaData MetaData { 256, 256, PF_B8G8R8A8, false };
+		FString Width, Height;
+		if (CVarHeadlessImportedTextureSize.GetValueOnAnyThread().Split(TEXT("x"), &Width, &Height))
+		{
+			MetaData.SizeX = FMath::Max(FCString::Atoi(*Width), 1);
+			MetaData.SizeY = FMath::Max(FCString::Atoi(*Height), 1);
+		}
+		return MetaData;
+	}
+
+	FTouchTextureTransfer FTouchTextureImporterHeadless::GetTextureTransfer(const FTouchImportParameters& ImportParams)
+	{
+		// TouchEngine does not write to host memory, so there is no transfer to wait on
+		FTouchTextureTransfer Transfer;
+		Transfer.Result = TEResultNoMatchingEntity;
+		return Transfer;
+	}
+}
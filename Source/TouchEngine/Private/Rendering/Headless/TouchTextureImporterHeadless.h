@@ -0,0 +1,64 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Rendering/Importing/ITouchImportTexture.h"
+#include "Rendering/Importing/TouchTextureImporter.h"
+
+namespace UE::TouchEngine::Headless
+{
+	/** A TouchEngine texture held in host memory, uploaded into the Unreal texture */
+	class FTouchImportTextureHeadless : public ITouchImportTexture
+	{
+	public:
+
+		FTouchImportTextureHeadless(const FTextureMetaData& MetaData, TSharedRef<TArray64<uint8>, ESPMode::ThreadSafe> Pixels)
+			: MetaData(MetaData)
+			, Pixels(MoveTemp(Pixels))
+		{}
+
+		//~ Begin ITouchImportTexture Interface
+		virtual FTextureMetaData GetTextureMetaData() const override { return MetaData; }
+		virtual ECopyTouchToUnrealResult CopyNativeToUnrealRHI_RenderThread(const FTouchCopyTextureArgs& CopyArgs, TSharedRef<FTouchTextureImporter> Importer) override;
+		virtual void OnCurrentCopyDone_RenderThread(FRHICommandListImmediate& RHICmdList, TUniqueFunction<void()>&& Callback) override;
+		//~ End ITouchImportTexture Interface
+
+	private:
+
+		FTextureMetaData MetaData;
+		TSharedRef<TArray64<uint8>, ESPMode::ThreadSafe> Pixels;
+	};
+	
+	/**
+	 * Imports the TouchEngine textures from host memory. Without a graphics context, TouchEngine cannot tell us the size of its textures,
+	 * so the imported textures all use the size set by the TouchEngine.Headless.ImportedTextureSize console variable.
+	 */
+	class FTouchTextureImporterHeadless : public FTouchTextureImporter
+	{
+	protected:
+
+		//~ Begin FTouchTextureImporter Interface
+		virtual TSharedPtr<ITouchImportTexture> CreatePlatformTexture_RenderThread(const TouchObject<TEInstance>& Instance, const TouchObject<TETexture>& SharedTexture) override;
+		virtual FTextureMetaData GetTextureMetaData(const TouchObject<TETexture>& Texture) const override;
+		virtual FTouchTextureTransfer GetTextureTransfer(const FTouchImportParameters& ImportParams) override;
+		//~ End FTouchTextureImporter Interface
+
+	private:
+
+		/** The host memory the textures are uploaded from, shared by all the textures of the same descriptor. Only accessed on the render thread */
+		TMap<FTouchImportTextureDescriptor, TSharedRef<TArray64<uint8>, ESPMode::ThreadSafe>> SourcePixels;
+	};
+}
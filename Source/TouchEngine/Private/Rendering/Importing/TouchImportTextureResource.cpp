@@ -0,0 +1,86 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#include "Rendering/Importing/TouchImportTextureResource.h"
+
+#include "RenderingThread.h"
+#include "RHICommandList.h"
+#include "Engine/Texture2D.h"
+#include "UObject/Package.h"
+#include "Util/TouchEngineStatsGroup.h"
+
+namespace UE::TouchEngine
+{
+	UTexture2D* FTouchImportTextureResource::CreateTexture_AnyThread(const FTouchImportTextureDescriptor& Descriptor)
+	{
+		DECLARE_SCOPE_CYCLE_COUNTER(TEXT("    III.A.1.1 [AT] Link Texture Import - Create UTexture"), STAT_TE_III_A_1_1, STATGROUP_TouchEngine);
+		
+		// 1. We let UObject generate the name, which is cheaper than making a unique name from the parameter name
+		UTexture2D* Texture = NewObject<UTexture2D>(GetTransientPackage(), NAME_None, RF_Transient);
+		if (!ensure(Texture))
+		{
+			return nullptr;
+		}
+		Texture->NeverStream = true;
+		Texture->SRGB = Descriptor.IsSRGB;
+		Texture->AddToRoot();
+
+		// 2. The platform data is only describing the texture, so that functions like GetSizeX or GetPixelFormat work as expected. We do not allocate any mip data
+		FTexturePlatformData* PlatformData = new FTexturePlatformData();
+		PlatformData->SizeX = Descriptor.SizeX;
+		PlatformData->SizeY = Descriptor.SizeY;
+		PlatformData->PixelFormat = Descriptor.PixelFormat;
+		PlatformData->SetNumSlices(1);
+		PlatformData->Mips.Add(new FTexture2DMipMap(Descriptor.SizeX, Descriptor.SizeY));
+		Texture->SetPlatformData(PlatformData);
+
+		// 3. We set our own resource instead of calling UpdateResource, which would need to be called from the GameThread
+		FTouchImportTextureResource* Resource = new FTouchImportTextureResource(Descriptor, Texture->TextureReference);
+		Texture->SetResource(Resource);
+		BeginInitResource(Resource);
+		INC_DWORD_STAT(STAT_TE_Import_NbTexture2dCreated)
+		return Texture;
+	}
+
+	void FTouchImportTextureResource::InitRHI(FRHICommandListBase& RHICmdList)
+	{
+		DECLARE_SCOPE_CYCLE_COUNTER(TEXT("    III.A.1.2 [RT] Link Texture Import - Create RHI"), STAT_TE_III_A_1_2, STATGROUP_TouchEngine);
+		const FRHITextureCreateDesc Desc = FRHITextureCreateDesc::Create2D(TEXT("TouchEngineImportTexture"), Descriptor.SizeX, Descriptor.SizeY, Descriptor.PixelFormat)
+			.SetFlags(ETextureCreateFlags::ShaderResource | (Descriptor.IsSRGB ? ETextureCreateFlags::SRGB : ETextureCreateFlags::None))
+			.SetInitialState(ERHIAccess::SRVMask);
+		TextureRHI = RHICreateTexture(Desc);
+		SamplerStateRHI = GetOrCreateSamplerState(FSamplerStateInitializerRHI(SF_Bilinear, AM_Clamp, AM_Clamp, AM_Clamp));
+		
+		// UTexture::UpdateResource would have created the TextureReferenceRHI from the GameThread with FTextureReference::BeginInit_GameThread.
+		// As we never call it, we create it here so that FTouchResourceProvider::GetStableRHIFromTexture works with the imported textures too
+		// (i.e. when they are sent back to TouchEngine as inputs), and only update it like FStreamableTextureResource::InitRHI when it already exists.
+		if (TextureReference.TextureReferenceRHI)
+		{
+			RHIUpdateTextureReference(TextureReference.TextureReferenceRHI, TextureRHI);
+		}
+		else
+		{
+			TextureReference.TextureReferenceRHI = RHICreateTextureReference(TextureRHI);
+		}
+	}
+
+	void FTouchImportTextureResource::ReleaseRHI()
+	{
+		if (TextureReference.TextureReferenceRHI)
+		{
+			RHIUpdateTextureReference(TextureReference.TextureReferenceRHI, nullptr);
+		}
+		FTextureResource::ReleaseRHI();
+	}
+}
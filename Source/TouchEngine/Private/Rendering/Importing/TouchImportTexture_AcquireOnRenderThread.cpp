@@ -51,7 +51,7 @@ namespace UE::TouchEngine
 
 			if (CopyArgs.RequestParams.TETextureTransfer.Result == TEResultSuccess)
 			{
-				ReleaseMutex_RenderThread(CopyArgs, CopyArgs.RequestParams.TETextureTransfer.Semaphore, SourceTexture);
+				ReleaseMutex_RenderThread(CopyArgs, CopyArgs.RequestParams.TETextureTransfer.Semaphore, SourceTexture, Importer);
 			}
 			
 			return ECopyTouchToUnrealResult::Success;
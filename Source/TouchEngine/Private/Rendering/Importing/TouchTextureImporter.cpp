@@ -16,13 +16,16 @@
 #include "RenderingThread.h"
 #include "Logging.h"
 #include "Rendering/Importing/ITouchImportTexture.h"
+#include "Rendering/Importing/TouchImportTextureResource.h"
 #include "Rendering/TouchResourceProvider.h"
 
+#include "Engine/TEDebug.h"
 #include "Engine/Util/TouchFrameCooker.h"
 #include "Tasks/Task.h"
 #include "UObject/UObjectGlobals.h"
 #include "UObject/Package.h"
 #include "Util/TouchEngineStatsGroup.h"
+#include "Util/TouchEngineTrace.h"
 #include "Util/TouchHelpers.h"
 
 namespace UE::TouchEngine
@@ -47,10 +50,17 @@ namespace UE::TouchEngine
 		}
 		{
 			FScopeLock PoolLock(&TexturePoolMutex);
-			for (FImportedTexturePoolData& Data : TexturePool)
+			for (const TPair<FTouchImportTextureDescriptor, FImportedTexturePoolBucket>& Bucket : TexturePool)
 			{
-				TexturesToCleanUp.Add(Data.UETexture);
+				for (const FImportedTexturePoolData& Data : Bucket.Value.Textures)
+				{
+					TexturesToCleanUp.Add(Data.UETexture);
+				}
 			}
+			TexturePool.Empty();
+			NumPooledTextures = 0;
+			PooledBytes = 0;
+			UpdatePoolStats(0); // removes this pool from the stats
 		}
 
 		ExecuteOnGameThread<void>([TexturesToCleanUp = MoveTemp(TexturesToCleanUp)]()
@@ -109,70 +119,127 @@ namespace UE::TouchEngine
 		TFuture<FTouchSuspendResult> Future = Promise.GetFuture();
 		TFuture<FTouchSuspendResult> TaskSuspenderFuture = TaskSuspender.Suspend();
 
+		// The copies which have not been flushed yet will never be executed, so we give their texture transfers back to TouchEngine
+		TArray<FPendingTextureCopy> CancelledCopies;
+		{
+			FScopeLock Lock(&PendingCopiesMutex);
+			CancelledCopies = MoveTemp(PendingCopies);
+			PendingCopies.Reset();
+		}
+		for (const FPendingTextureCopy& Copy : CancelledCopies)
+		{
+			ReturnTextureTransfer(Copy.LinkParams);
+		}
+		UE_CLOG(!CancelledCopies.IsEmpty(), LogTouchEngine, Log, TEXT("[FTouchTextureImporter::SuspendAsyncTasks] Cancelled %d texture copies which were not enqueued yet"), CancelledCopies.Num());
+
 		ENQUEUE_RENDER_COMMAND(FinishRemainingTasks)([ThisPin = SharedThis(this), Promise = MoveTemp(Promise), TaskSuspenderFuture = MoveTemp(TaskSuspenderFuture)](FRHICommandListImmediate& RHICmdList) mutable
 		{
-			// We only wait in the render thread to be sure that all the previously enqueued render copies are started or cancelled
+			// We only go through the render thread to be sure that all the previously enqueued render copies are started or cancelled
 			TaskSuspenderFuture.Next([ThisPin, Promise = MoveTemp(Promise)](auto) mutable
 			{
 				// At this point, all the copies - if any - are started and enqueued on the RHI thread (they might be done already).
-				// The variable KeepTexturesAliveForCopy holds all the remaining texture pending to be copied, so we now need to wait for them to be all done by checking if their fences have been signaled
-				FScopeLock Lock(&ThisPin->KeepTexturesAliveMutex);
-				ThisPin->RemoveUnusedAliveTextures();
-				if (ThisPin->KeepTexturesAliveForCopy.IsEmpty())
+				// Each of them will call OnCopyDone_AnyThread once the GPU is done with it, and the last one will fulfill the promise.
+				FScopeLock Lock(&ThisPin->CopiesInFlightMutex);
+				if (ThisPin->NumCopiesInFlight == 0)
 				{
 					Promise.SetValue({});
 				}
 				else
 				{
-					UE_LOG(LogTouchEngine, Log, TEXT("[FTouchTextureImporter::SuspendAsyncTasks] About to start waiting for %d texture copies..."), ThisPin->KeepTexturesAliveForCopy.Num())
-					// If we are waiting on an export, start a background task to wait for it
-					UE::Tasks::Launch(UE_SOURCE_LOCATION, [ThisPin, Promise = MoveTemp(Promise)]() mutable
-					{
-						double StartTime = FPlatformTime::Seconds(); 
-						FPlatformProcess::ConditionalSleep([ThisPin, StartTime]()
-						{
-							if (FPlatformTime::Seconds() < StartTime + 5.0) // 5s should be more than enough time, we would be expecting this next tick
-							{
-								FScopeLock Lock(&ThisPin->KeepTexturesAliveMutex);
-								ThisPin->RemoveUnusedAliveTextures();
-								return ThisPin->KeepTexturesAliveForCopy.IsEmpty();
-							}
-							return true; // stop sleeping if any of those is invalid or if we timed out
-						}, 0.1f);
-						{
-							FScopeLock Lock(&ThisPin->KeepTexturesAliveMutex);
-							UE_LOG(LogTouchEngine, Log, TEXT("[FTouchTextureImporter::SuspendAsyncTasks::ConditionalSleep] Done waiting. Remaining copies: %d"), ThisPin->KeepTexturesAliveForCopy.Num());
-							ThisPin->KeepTexturesAliveForCopy.Empty(); //to be sure we clear them, if ended up with a timeout
-							Promise.SetValue({});
-						}
-					}, LowLevelTasks::ETaskPriority::BackgroundLow);
+					UE_LOG(LogTouchEngine, Log, TEXT("[FTouchTextureImporter::SuspendAsyncTasks] Waiting for %d texture copies to be done..."), ThisPin->NumCopiesInFlight)
+					ThisPin->CopiesDonePromise = MoveTemp(Promise);
 				}
 			});
 		});
-		return Future; ;
+		return Future;
 	}
 
 	void FTouchTextureImporter::TexturePoolMaintenance(const FTouchEngineInputFrameData& FrameData)
 	{
 		FScopeLock PoolLock(&TexturePoolMutex);
-		while (TexturePool.Num() > PoolSize)
+		PoolSizer.RecordFrame(NumPooledTextures, PoolSize);
+		while (IsPoolOverBudget())
+		{
+			FImportedTexturePoolBucket* Bucket = FindBucketToEvictFrom(FrameData);
+			if (!Bucket)
+			{
+				break; // all the remaining textures have been added this frame, so we stop removing from the pool
+			}
+			// we remove from the front as they have been in this bucket the longest
+			const FImportedTexturePoolData TextureData = RemoveTextureFromBucket(*Bucket, 0);
+			DestroyPooledTexture(TextureData.UETexture);
+			INC_DWORD_STAT(STAT_TE_ImportedTexturePool_Evictions)
+			++PoolCounters.Evictions;
+		}
+
+		// Drop the empty buckets which have not been requested this frame to keep the lookups cheap
+		for (TMap<FTouchImportTextureDescriptor, FImportedTexturePoolBucket>::TIterator It = TexturePool.CreateIterator(); It; ++It)
 		{
-			FImportedTexturePoolData& TextureData = TexturePool[0]; // we would remove from the front as they have been here the longest
-			if (IsValid(TextureData.UETexture))
+			if (It.Value().Textures.IsEmpty() && It.Value().LastRequestedFrameID < FrameData.FrameID)
 			{
-				if (TextureData.PooledFrameID == FrameData.FrameID)
+				It.RemoveCurrent();
+			}
+		}
+		UpdatePoolStats(PoolSizer.GetPoolSize(PoolSize));
+	}
+
+	void FTouchTextureImporter::PrewarmPool_GameThread(const TArray<FTouchEngineTextureDescriptor>& Descriptors)
+	{
+		check(IsInGameThread());
+		for (const FTouchEngineTextureDescriptor& Descriptor : Descriptors)
+		{
+			if (Descriptor.SizeX <= 0 || Descriptor.SizeY <= 0 || Descriptor.PixelFormat == PF_Unknown)
+			{
+				UE_LOG(LogTouchEngine, Warning, TEXT("[FTouchTextureImporter::PrewarmPool_GameThread] Ignoring invalid texture descriptor %dx%d [%s]"),
+					Descriptor.SizeX, Descriptor.SizeY, GetPixelFormatString(Descriptor.PixelFormat));
+				continue;
+			}
+			
+			// The imported textures only ever have one mip (see FTouchImportTextureResource::CreateTexture_AnyThread), so NumMips is ignored here
+			FTouchImportTextureDescriptor ImportDescriptor;
+			ImportDescriptor.SizeX = Descriptor.SizeX;
+			ImportDescriptor.SizeY = Descriptor.SizeY;
+			ImportDescriptor.PixelFormat = Descriptor.PixelFormat;
+			ImportDescriptor.IsSRGB = Descriptor.bIsSRGB;
+			for (int32 i = 0; i < Descriptor.Count; ++i)
+			{
+				UTexture2D* Texture = FTouchImportTextureResource::CreateTexture_AnyThread(ImportDescriptor);
+				if (!Texture)
 				{
-					break; //if we reach a texture added this frame, we know the next textures will also have been added this frame so we stop removing from the pool
+					break;
 				}
-				// as we might create a lot of textures and the GC might take some time to kick in, we expedite some of the cleaning
-				TextureData.UETexture->RemoveFromRoot();
-				TextureData.UETexture->TextureReference.TextureReferenceRHI.SafeRelease();
-				TextureData.UETexture->ReleaseResource(); 
-				TextureData.UETexture->ConditionalBeginDestroy();
+
+				FScopeLock PoolLock(&TexturePoolMutex);
+				AddTextureToPool(Texture, -1); // a FrameID of -1 allows the texture to be used from the first frame
 			}
-			TexturePool.RemoveAt(0);
 		}
-		SET_DWORD_STAT(STAT_TE_ImportedTexturePool_NbTexturesPool, TexturePool.Num())
+	}
+
+	TArray<FTouchEngineTextureDescriptor> FTouchTextureImporter::GetObservedDescriptors()
+	{
+		TArray<FTouchEngineTextureDescriptor> Descriptors;
+		FScopeLock PoolLock(&TexturePoolMutex);
+		for (const TPair<FTouchImportTextureDescriptor, int32>& Observed : ObservedPeakRequestsPerFrame)
+		{
+			FTouchEngineTextureDescriptor& Descriptor = Descriptors.AddDefaulted_GetRef();
+			Descriptor.SizeX = Observed.Key.SizeX;
+			Descriptor.SizeY = Observed.Key.SizeY;
+			Descriptor.PixelFormat = Observed.Key.PixelFormat;
+			Descriptor.NumMips = Observed.Key.NumMips;
+			Descriptor.bIsSRGB = Observed.Key.IsSRGB;
+			// A texture is only returned to the pool once the next one has been imported, so we need two textures per request
+			Descriptor.Count = Observed.Value * 2;
+		}
+		return Descriptors;
+	}
+
+	FTouchTexturePoolCounters FTouchTextureImporter::GetPoolCounters()
+	{
+		FScopeLock PoolLock(&TexturePoolMutex);
+		FTouchTexturePoolCounters Counters = PoolCounters;
+		Counters.NumPooledTextures = NumPooledTextures;
+		Counters.NumBuckets = TexturePool.Num();
+		return Counters;
 	}
 
 	bool FTouchTextureImporter::RemoveUTextureFromPool(UTexture2D* Texture)
@@ -183,10 +250,11 @@ namespace UE::TouchEngine
 		}
 		
 		FScopeLock Lock(&LinkDataMutex);
-		for(const TTuple<FName, FTouchTextureLinkData>& Data : LinkData)
+		for(TTuple<FName, FTouchTextureLinkData>& Data : LinkData)
 		{
-			if (Data.Value.UnrealTexture == Texture)
+			if (Data.Value.UnrealTexture == Texture || Data.Value.LastImportDestination == Texture)
 			{
+				Data.Value.LastImportDestination = nullptr; // the texture now belongs to the caller, so the next import of this parameter needs its own texture
 				Texture->RemoveFromRoot(); // this is enough to ensure it will not be put back in the pool, as we are checking for this
 				return true;
 			}
@@ -201,6 +269,17 @@ namespace UE::TouchEngine
 		Transfer.Result = TEInstanceGetTextureTransfer(ImportParams.Instance, ImportParams.TETexture, Transfer.Semaphore.take(), &Transfer.WaitValue);
 		return Transfer;
 	}
+
+	void FTouchTextureImporter::ReturnTextureTransfer(const FTouchImportParameters& ImportParams)
+	{
+		if (ImportParams.TETextureTransfer.Result == TEResultSuccess && ImportParams.TETextureTransfer.Semaphore)
+		{
+			// We did not access the texture, so TouchEngine can use it again as soon as its own semaphore reaches the value it gave us
+			const TEResult Result = TEInstanceAddTextureTransfer(ImportParams.Instance, ImportParams.TETexture, ImportParams.TETextureTransfer.Semaphore, ImportParams.TETextureTransfer.WaitValue);
+			UE_CLOG(Result != TEResultSuccess, LogTouchEngineTECalls, Error, TEXT("[FTouchTextureImporter::ReturnTextureTransfer[%s]] TEInstanceAddTextureTransfer returned `%s` for parameter `%s`"),
+				*GetCurrentThreadStr(), *TEResultToString(Result), *ImportParams.Identifier.ToString());
+		}
+	}
 	
 	void FTouchTextureImporter::ExecuteLinkTextureRequest_AnyThread(TPromise<FTouchTextureImportResult>&& Promise, const FTouchImportParameters& LinkParams, const TSharedPtr<FTouchFrameCooker>& FrameCooker)
 	{
@@ -211,61 +290,49 @@ namespace UE::TouchEngine
 		}
 		
 		DECLARE_SCOPE_CYCLE_COUNTER(TEXT("    III.A.1 [AT] Link Texture Import"), STAT_TE_III_A_1, STATGROUP_TouchEngine);
+		// 0. If the content of the TouchEngine texture has not changed since the last import, we keep the UTexture we copied it into
+		if (UTexture2D* UnchangedTexture = FindUnchangedImport(LinkParams))
+		{
+			INC_DWORD_STAT(STAT_TE_Import_NbUnchangedTexturesSkipped)
+			UE_LOG_TOUCHENGINE_HOT_PATH(Verbose, TEXT("[FTouchTextureImporter::ExecuteLinkTextureRequest_AnyThread[%s]] Skipping the import of the unchanged texture for parameter `%s` for frame `%lld`"),
+				*GetCurrentThreadStr(), *LinkParams.Identifier.ToString(), LinkParams.FrameData.FrameID);
+			ReturnTextureTransfer(LinkParams); // GetTextureTransfer took the ownership of the texture, which we need to give back as we are not copying it
+			Promise.SetValue(FTouchTextureImportResult::MakeSuccessful(UnchangedTexture, nullptr)); // no previous texture to pool as we are keeping it
+			return;
+		}
+
 		// At this point, we are neither on the GameThread nor on the RenderThread, we are on a parallel thread.
 		// A UTexture2D can be created on any thread but the call to UTexture2D::UpdateResource need to be on GameThread.
-		// As we are creating the texture here, we use an FTaskTagScope to allow us to call UTexture2D::UpdateResource from this thread.
-		// There should be no issues as the texture is not used anywhere else at this point.
+		// This is why the textures we create use a FTouchImportTextureResource, which creates its RHI on the render thread without needing UpdateResource.
 		
 		const FTextureMetaData TETextureMetadata = GetTextureMetaData(LinkParams.TETexture);
 		
 		// 1. Check if we already have a UTexture that could hold the data from TouchEngine, or create one
-		bool bAccessRHIViaReferenceTexture = false;
-		UTexture2D* UEDestinationTexture = GetOrCreateUTextureMatchingMetaData(TETextureMetadata, LinkParams, bAccessRHIViaReferenceTexture);
+		UTexture2D* UEDestinationTexture = GetOrCreateUTextureMatchingMetaData(TETextureMetadata, LinkParams);
 		if (!ensure(IsValid(UEDestinationTexture)))
 		{
 			Promise.SetValue(FTouchTextureImportResult::MakeFailure());
 			return;
 		}
 
-		// 2. Enqueue the copy of the Texture
-		ENQUEUE_RENDER_COMMAND(CopyRHI)([WeakThis = AsWeak(), LinkParams, UEDestinationTexture, bAccessRHIViaReferenceTexture](FRHICommandListImmediate& RHICmdList) mutable
+		// 2. Add the copy of the Texture to the copies of this cook, which will all be enqueued in a single render command when the cook is done.
+		// If we are not in a cook, there is nothing to batch it with so we enqueue it straight away
 		{
-			const TSharedPtr<FTouchTextureImporter> ThisPin = WeakThis.Pin();
-			if (!ThisPin || ThisPin->TaskSuspender.IsSuspended())
-			{
-				return;
-			}
-			
-			TSharedPtr<ITouchImportTexture> PlatformTexture;
-			{
-				DECLARE_SCOPE_CYCLE_COUNTER(TEXT("    III.A.2 [RT] Link Texture Import - CreateSharedTETexture"), STAT_TE_III_A_2, STATGROUP_TouchEngine);
-			   // 1. We get the source texture sent by TouchEngine
-			   PlatformTexture = ThisPin->CreatePlatformTexture_RenderThread(LinkParams.Instance, LinkParams.TETexture);
-			}
-
-			TRefCountPtr<FRHITexture> UEDestinationTextureRHI;
-			if (IsValid(UEDestinationTexture))
-			{
-				UEDestinationTextureRHI = bAccessRHIViaReferenceTexture && UEDestinationTexture->TextureReference.TextureReferenceRHI ?
-					FTextureRHIRef{UEDestinationTexture->TextureReference.TextureReferenceRHI->GetReferencedTexture()} :
-					UEDestinationTexture->GetResource() ? UEDestinationTexture->GetResource()->TextureRHI : nullptr;
-			}
-
-			if (PlatformTexture && UEDestinationTextureRHI)
-			{
-				DECLARE_SCOPE_CYCLE_COUNTER(TEXT("    III.A.3 [RT] Link Texture Import - CopyRHI"), STAT_TE_III_A_3, STATGROUP_TouchEngine);
-				// 2. We create a destination UTexture RHI if we don't have one already
-				const FTouchCopyTextureArgs CopyArgs { LinkParams, RHICmdList, UEDestinationTextureRHI};
-				ThisPin->CopyNativeToUnreal_RenderThread(PlatformTexture, CopyArgs);
-
-				{
-					FScopeLock Lock(&ThisPin->LinkDataMutex);
-					FTouchTextureLinkData& TextureLinkData = ThisPin->LinkData.FindOrAdd(LinkParams.Identifier);
-					TextureLinkData.UnrealTexture = UEDestinationTexture;
-					TextureLinkData.bIsInProgress = false;
-				}
-			}
-		}); // ~ENQUEUE_RENDER_COMMAND(CopyRHI)
+			FScopeLock Lock(&PendingCopiesMutex);
+			PendingCopies.Add({LinkParams, UEDestinationTexture});
+		}
+		{
+			FScopeLock Lock(&LinkDataMutex);
+			FTouchTextureLinkData& TextureLinkData = LinkData.FindOrAdd(LinkParams.Identifier);
+			TextureLinkData.LastImportedTETexture = LinkParams.TETexture;
+			TextureLinkData.LastReturnedSemaphore.reset(); // set by OnTextureTransferReturned_AnyThread once the copy gives the texture back to TouchEngine
+			TextureLinkData.LastReturnedWaitValue = 0;
+			TextureLinkData.LastImportDestination = UEDestinationTexture;
+		}
+		if (LinkParams.FrameData.FrameID < 0)
+		{
+			FlushPendingCopies_AnyThread();
+		}
 		
 		//3. Here, we want to make sure the previous texture would be put back in the pool, so we create a promise to be filled
 		TSharedPtr<TPromise<UTexture2D*>> PreviousTextureToBePooledPromise = MakeShared<TPromise<UTexture2D*>>();
@@ -283,7 +350,7 @@ namespace UE::TouchEngine
 				if (PreviousTextureToBePooled->IsRooted()) // if the texture is not rooted, we have been asked to remove it from the set, see RemoveUTextureFromPool
 				{
 					FScopeLock PoolLock(&ThisPin->TexturePoolMutex);
-					ThisPin->TexturePool.Add({LinkParams.FrameData.FrameID, PreviousTextureToBePooled});
+					ThisPin->AddTextureToPool(PreviousTextureToBePooled, LinkParams.FrameData.FrameID);
 				}
 			}
 			else
@@ -295,47 +362,132 @@ namespace UE::TouchEngine
 		Promise.SetValue( FTouchTextureImportResult::MakeSuccessful(UEDestinationTexture, MoveTemp(PreviousTextureToBePooledPromise)));
 	}
 	
-	UTexture2D* FTouchTextureImporter::GetOrCreateUTextureMatchingMetaData(const FTextureMetaData& TETextureMetadata, const FTouchImportParameters& LinkParams, bool& bOutAccessRHIViaReferenceTexture)
+	void FTouchTextureImporter::FlushPendingCopies_AnyThread()
+	{
+		TArray<FPendingTextureCopy> Copies;
+		{
+			FScopeLock Lock(&PendingCopiesMutex);
+			if (PendingCopies.IsEmpty())
+			{
+				return;
+			}
+			Copies = MoveTemp(PendingCopies);
+		}
+		
+		ENQUEUE_RENDER_COMMAND(CopyRHI)([WeakThis = AsWeak(), Copies = MoveTemp(Copies)](FRHICommandListImmediate& RHICmdList)
+		{
+			const TSharedPtr<FTouchTextureImporter> ThisPin = WeakThis.Pin();
+			if (!ThisPin)
+			{
+				return;
+			}
+			if (ThisPin->TaskSuspender.IsSuspended())
+			{
+				for (const FPendingTextureCopy& Copy : Copies)
+				{
+					ThisPin->ReturnTextureTransfer(Copy.LinkParams); // these copies are cancelled, so TouchEngine can use the textures again
+				}
+				return;
+			}
+			ThisPin->ExecuteCopies_RenderThread(RHICmdList, Copies);
+		}); // ~ENQUEUE_RENDER_COMMAND(CopyRHI)
+	}
+
+	void FTouchTextureImporter::ExecuteCopies_RenderThread(FRHICommandListImmediate& RHICmdList, const TArray<FPendingTextureCopy>& Copies)
+	{
+		DECLARE_SCOPE_CYCLE_COUNTER(TEXT("    III.A.2-3 [RT] Link Texture Import - Copy Batch"), STAT_TE_III_A_2_Batch, STATGROUP_TouchEngine);
+		// 0. We deliver the readbacks of the previous cooks which are done, without waiting for the ones still in flight
+		Readback.ProcessReadbacks_RenderThread();
+		
+		TArray<const FPendingTextureCopy*, TInlineAllocator<16>> SuccessfulCopies;
+		for (const FPendingTextureCopy& Copy : Copies)
+		{
+			TOUCHENGINE_TRACE_COOK_PHASE(ImportCopy, Copy.LinkParams.FrameData);
+			TSharedPtr<ITouchImportTexture> PlatformTexture;
+			{
+				DECLARE_SCOPE_CYCLE_COUNTER(TEXT("    III.A.2 [RT] Link Texture Import - CreateSharedTETexture"), STAT_TE_III_A_2, STATGROUP_TouchEngine);
+				// 1. We get the source texture sent by TouchEngine
+				PlatformTexture = CreatePlatformTexture_RenderThread(Copy.LinkParams.Instance, Copy.LinkParams.TETexture);
+			}
+
+			// 2. We get the RHI of the destination UTexture. Its FTouchImportTextureResource was initialised by a previous render command, which also pointed its texture reference to it
+			TRefCountPtr<FRHITexture> UEDestinationTextureRHI;
+			if (IsValid(Copy.UEDestinationTexture))
+			{
+				UEDestinationTextureRHI = FTouchResourceProvider::GetStableRHIFromTexture(Copy.UEDestinationTexture);
+			}
+
+			if (PlatformTexture && UEDestinationTextureRHI)
+			{
+				DECLARE_SCOPE_CYCLE_COUNTER(TEXT("    III.A.3 [RT] Link Texture Import - CopyRHI"), STAT_TE_III_A_3, STATGROUP_TouchEngine);
+				// 3. We copy the TouchEngine texture into the UTexture
+				const FTouchCopyTextureArgs CopyArgs { Copy.LinkParams, RHICmdList, UEDestinationTextureRHI};
+				CopyNativeToUnreal_RenderThread(PlatformTexture, CopyArgs);
+				SuccessfulCopies.Add(&Copy);
+
+				// 3.1 If requested, we read the UTexture back to the CPU once the copy is done
+				Readback.EnqueueReadback_RenderThread(RHICmdList, Copy.LinkParams.Identifier, Copy.LinkParams.FrameData.FrameID, UEDestinationTextureRHI);
+			}
+		}
+
+		// 4. We update the link data of all the copies at once
+		FScopeLock Lock(&LinkDataMutex);
+		for (const FPendingTextureCopy* Copy : SuccessfulCopies)
+		{
+			FTouchTextureLinkData& TextureLinkData = LinkData.FindOrAdd(Copy->LinkParams.Identifier);
+			TextureLinkData.UnrealTexture = Copy->UEDestinationTexture;
+			TextureLinkData.bIsInProgress = false;
+		}
+	}
+	
+	UTexture2D* FTouchTextureImporter::FindUnchangedImport(const FTouchImportParameters& LinkParams)
+	{
+		FScopeLock Lock(&LinkDataMutex);
+		const FTouchTextureLinkData* TextureLinkData = LinkData.Find(LinkParams.Identifier);
+		if (!TextureLinkData || !IsValid(TextureLinkData->LastImportDestination) || !LinkParams.TETexture || TextureLinkData->LastImportedTETexture.get() != LinkParams.TETexture.get())
+		{
+			return nullptr;
+		}
+
+		// TouchEngine adds its own transfer every time it writes to the texture, so we only skip the copy when we get back the exact transfer we gave it after the last copy.
+		// Without a transfer, or if the platform did not report the transfer it gave back (i.e. D3D11 keyed mutexes, which reuse the same values), we cannot prove anything and we copy.
+		const bool bHasTransfer = LinkParams.TETextureTransfer.Result == TEResultSuccess && LinkParams.TETextureTransfer.Semaphore;
+		const bool bIsReturnedTransfer = bHasTransfer && TextureLinkData->LastReturnedSemaphore
+			&& TextureLinkData->LastReturnedSemaphore.get() == LinkParams.TETextureTransfer.Semaphore.get()
+			&& TextureLinkData->LastReturnedWaitValue == LinkParams.TETextureTransfer.WaitValue;
+		return bIsReturnedTransfer ? TextureLinkData->LastImportDestination : nullptr;
+	}
+
+	void FTouchTextureImporter::OnTextureTransferReturned_AnyThread(const FTouchImportParameters& ImportParams, const TouchObject<TESemaphore>& Semaphore, uint64 WaitValue)
+	{
+		FScopeLock Lock(&LinkDataMutex);
+		FTouchTextureLinkData* TextureLinkData = LinkData.Find(ImportParams.Identifier);
+		if (TextureLinkData && TextureLinkData->LastImportedTETexture.get() == ImportParams.TETexture.get())
+		{
+			TextureLinkData->LastReturnedSemaphore = Semaphore;
+			TextureLinkData->LastReturnedWaitValue = WaitValue;
+		}
+	}
+	
+	UTexture2D* FTouchTextureImporter::GetOrCreateUTextureMatchingMetaData(const FTextureMetaData& TETextureMetadata, const FTouchImportParameters& LinkParams)
 	{
 		UTexture2D* UEDestinationTexture = nullptr;
 		if (!ensure(TETextureMetadata.PixelFormat != PF_Unknown))
 		{
-			bOutAccessRHIViaReferenceTexture = false;
 			UE_LOG(LogTouchEngine, Error, TEXT("[FTouchTextureImporter::ExecuteLinkTextureRequest_AnyThread[%s]] The PlatformMetadata has an unknown Pixel format `%s` for parameter `%s` for frame `%lld`"),
 				   *GetCurrentThreadStr(), GetPixelFormatString(TETextureMetadata.PixelFormat), *LinkParams.Identifier.ToString(), LinkParams.FrameData.FrameID);
 		}
 		else if (UTexture2D* PoolTexture = FindPoolTextureMatchingMetadata(TETextureMetadata, LinkParams.FrameData)) // if the UTexture and the TE Texture matches size and format, copy straight into the UTexture resource
 		{
-			bOutAccessRHIViaReferenceTexture = true;
+			INC_DWORD_STAT(STAT_TE_ImportedTexturePool_Hits)
 			UEDestinationTexture = PoolTexture;
 		}
 		else // otherwise we need to create a new resource
 		{
-			
-			UE_LOG(LogTouchEngine, Log, TEXT("[FTouchTextureImporter::ExecuteLinkTextureRequest_AnyThread[%s]] Need to create new UTexture for parameter `%s`: %dx%d [%s] for frame `%lld`"),
+			INC_DWORD_STAT(STAT_TE_ImportedTexturePool_Misses)
+			UE_LOG_TOUCHENGINE_HOT_PATH(Log, TEXT("[FTouchTextureImporter::ExecuteLinkTextureRequest_AnyThread[%s]] Need to create new UTexture for parameter `%s`: %dx%d [%s] for frame `%lld`"),
 				   *GetCurrentThreadStr(), *LinkParams.Identifier.ToString(), TETextureMetadata.SizeX, TETextureMetadata.SizeY, GetPixelFormatString(TETextureMetadata.PixelFormat), LinkParams.FrameData.FrameID);
-			{
-				DECLARE_SCOPE_CYCLE_COUNTER(TEXT("    III.A.1.1 [AT] Link Texture Import - Create UTexture"), STAT_TE_III_A_1_1, STATGROUP_TouchEngine);
-				const FString Name = FString::Printf(TEXT("%s [%lld:%f]"), *LinkParams.Identifier.ToString(), LinkParams.FrameData.FrameID, FPlatformTime::Seconds() - GStartTime);
-				const FName UniqueName = MakeUniqueObjectName(GetTransientPackage(), UTexture2D::StaticClass(), FName(Name));
-				UEDestinationTexture = UTexture2D::CreateTransient(TETextureMetadata.SizeX, TETextureMetadata.SizeY, TETextureMetadata.PixelFormat, UniqueName);
-				UEDestinationTexture->NeverStream = true;
-				UEDestinationTexture->SRGB = TETextureMetadata.IsSRGB;
-				UEDestinationTexture->AddToRoot();
-			}
-			{
-				DECLARE_SCOPE_CYCLE_COUNTER(TEXT("    III.A.1.2 [AT] Link Texture Import - Update Resource"), STAT_TE_III_A_1_2, STATGROUP_TouchEngine);
-				// Hack to allow us to call UpdateResource from this thread. This should be safe because we just created it, and we are returning it after it has been initialised
-				const ETaskTag PreviousTagScope = FTaskTagScope::SwapTag(ETaskTag::ENone);
-				{
-					FOptionalTaskTagScope Scope(ETaskTag::EParallelGameThread);
-					UEDestinationTexture->UpdateResource();
-				}
-				FTaskTagScope::SwapTag(PreviousTagScope);
-			}
-			bOutAccessRHIViaReferenceTexture = false;
-			// Here, accessing the reference texture will not give the expected result as it is not yet pointing to the right RHI
-			// so we access directly Texture->GetResource()->TextureRHI which is the RHI that will be referenced, as seen in FStreamableTextureResource::InitRHI()
+			UEDestinationTexture = FTouchImportTextureResource::CreateTexture_AnyThread(FTouchImportTextureDescriptor(TETextureMetadata));
 		}
 		
 		return UEDestinationTexture;
@@ -343,26 +495,100 @@ namespace UE::TouchEngine
 	
 	UTexture2D* FTouchTextureImporter::FindPoolTextureMatchingMetadata(const FTextureMetaData& TETextureMetadata, const FTouchEngineInputFrameData& FrameData)
 	{
-		UTexture2D* PooledTexture = nullptr;
-		
 		FScopeLock PoolLock(&TexturePoolMutex);
-		for (int i = 0; i < TexturePool.Num(); ++i)
+		const FTouchImportTextureDescriptor Descriptor(TETextureMetadata);
+		FImportedTexturePoolBucket& Bucket = TexturePool.FindOrAdd(Descriptor);
+		Bucket.NumRequestsThisFrame = Bucket.LastRequestedFrameID == FrameData.FrameID ? Bucket.NumRequestsThisFrame + 1 : 1;
+		Bucket.LastRequestedFrameID = FMath::Max(Bucket.LastRequestedFrameID, FrameData.FrameID);
+		int32& PeakRequests = ObservedPeakRequestsPerFrame.FindOrAdd(Descriptor);
+		PeakRequests = FMath::Max(PeakRequests, Bucket.NumRequestsThisFrame);
+		
+		for (int32 i = 0; i < Bucket.Textures.Num(); ++i)
 		{
-			FImportedTexturePoolData& TextureData = TexturePool[i];
-			if (TextureData.PooledFrameID >= FrameData.FrameID || !IsValid(TextureData.UETexture))
+			const FImportedTexturePoolData& TextureData = Bucket.Textures[i];
+			if (!IsValid(TextureData.UETexture))
+			{
+				RemoveTextureFromBucket(Bucket, i--);
+				continue;
+			}
+			if (TextureData.PooledFrameID >= FrameData.FrameID)
 			{
 				// if the texture was pooled this frame, we do not return it as it could still be in use
 				continue;
 			}
-			if (CanCopyIntoUTexture(TETextureMetadata, TextureData.UETexture))
+			PoolSizer.RecordRequest(true);
+			++PoolCounters.Hits;
+			return RemoveTextureFromBucket(Bucket, i).UETexture;
+		}
+
+		PoolSizer.RecordRequest(false);
+		++PoolCounters.Misses;
+		return nullptr;
+	}
+
+	void FTouchTextureImporter::AddTextureToPool(UTexture2D* Texture, int64 FrameID)
+	{
+		const FTouchImportTextureDescriptor Descriptor = FTouchImportTextureDescriptor::FromTexture(Texture);
+		const int64 SizeInBytes = Descriptor.GetSizeInBytes();
+		TexturePool.FindOrAdd(Descriptor).Textures.Add({FrameID, Texture, SizeInBytes});
+		++NumPooledTextures;
+		PooledBytes += SizeInBytes;
+		UpdatePoolStats(PoolSizer.GetPoolSize(PoolSize));
+	}
+
+	FTouchTextureImporter::FImportedTexturePoolData FTouchTextureImporter::RemoveTextureFromBucket(FImportedTexturePoolBucket& Bucket, int32 Index)
+	{
+		const FImportedTexturePoolData TextureData = Bucket.Textures[Index];
+		Bucket.Textures.RemoveAt(Index);
+		--NumPooledTextures;
+		PooledBytes -= TextureData.SizeInBytes;
+		return TextureData;
+	}
+
+	void FTouchTextureImporter::UpdatePoolStats(int32 TargetPoolSize)
+	{
+		DEC_DWORD_STAT_BY(STAT_TE_ImportedTexturePool_NbTexturesPool, ReportedNumPooledTextures)
+		DEC_DWORD_STAT_BY(STAT_TE_ImportedTexturePool_TargetSize, ReportedTargetPoolSize)
+		DEC_MEMORY_STAT_BY(STAT_TE_ImportedTexturePool_ResidentBytes, ReportedPooledBytes)
+		ReportedNumPooledTextures = NumPooledTextures;
+		ReportedTargetPoolSize = TargetPoolSize;
+		ReportedPooledBytes = PooledBytes;
+		INC_DWORD_STAT_BY(STAT_TE_ImportedTexturePool_NbTexturesPool, ReportedNumPooledTextures)
+		INC_DWORD_STAT_BY(STAT_TE_ImportedTexturePool_TargetSize, ReportedTargetPoolSize)
+		INC_MEMORY_STAT_BY(STAT_TE_ImportedTexturePool_ResidentBytes, ReportedPooledBytes)
+	}
+
+	FTouchTextureImporter::FImportedTexturePoolBucket* FTouchTextureImporter::FindBucketToEvictFrom(const FTouchEngineInputFrameData& FrameData)
+	{
+		FImportedTexturePoolBucket* BucketToEvictFrom = nullptr;
+		for (TPair<FTouchImportTextureDescriptor, FImportedTexturePoolBucket>& Pair : TexturePool)
+		{
+			FImportedTexturePoolBucket& Bucket = Pair.Value;
+			if (Bucket.Textures.IsEmpty() || Bucket.Textures[0].PooledFrameID >= FrameData.FrameID)
+			{
+				continue; // textures added this frame are never evicted
+			}
+			// 1. Evict first from the buckets which have not been requested for the longest, 2. and then from the one holding the oldest texture
+			if (!BucketToEvictFrom
+				|| Bucket.LastRequestedFrameID < BucketToEvictFrom->LastRequestedFrameID
+				|| (Bucket.LastRequestedFrameID == BucketToEvictFrom->LastRequestedFrameID && Bucket.Textures[0].PooledFrameID < BucketToEvictFrom->Textures[0].PooledFrameID))
 			{
-				PooledTexture = TextureData.UETexture;
-				TexturePool.RemoveAt(i);
-				break;
+				BucketToEvictFrom = &Bucket;
 			}
 		}
+		return BucketToEvictFrom;
+	}
 
-		return PooledTexture;
+	void FTouchTextureImporter::DestroyPooledTexture(UTexture2D* Texture)
+	{
+		if (IsValid(Texture))
+		{
+			// as we might create a lot of textures and the GC might take some time to kick in, we expedite some of the cleaning
+			Texture->RemoveFromRoot();
+			Texture->TextureReference.TextureReferenceRHI.SafeRelease();
+			Texture->ReleaseResource(); 
+			Texture->ConditionalBeginDestroy();
+		}
 	}
 
 	void FTouchTextureImporter::CopyNativeToUnreal_RenderThread(const TSharedPtr<ITouchImportTexture>& TETexture, const FTouchCopyTextureArgs& CopyArgs)
@@ -370,21 +596,36 @@ namespace UE::TouchEngine
 		const ECopyTouchToUnrealResult Result = TETexture->CopyNativeToUnrealRHI_RenderThread(CopyArgs, AsShared());
 		
 		const bool bSuccessfulCopy = Result == ECopyTouchToUnrealResult::Success;
-		UE_CLOG(bSuccessfulCopy, LogTouchEngine, Verbose, TEXT("   [FTouchTextureImporter::CopyTexture_AnyThread] Successfully copied Texture to Unreal Engine for parameter [%s] for frame `%lld`"),*CopyArgs.RequestParams.Identifier.ToString(), CopyArgs.RequestParams.FrameData.FrameID)
+		UE_CLOG_TOUCHENGINE_HOT_PATH(bSuccessfulCopy, Verbose, TEXT("   [FTouchTextureImporter::CopyTexture_AnyThread] Successfully copied Texture to Unreal Engine for parameter [%s] for frame `%lld`"),*CopyArgs.RequestParams.Identifier.ToString(), CopyArgs.RequestParams.FrameData.FrameID);
 		UE_CLOG(!bSuccessfulCopy, LogTouchEngine, Error, TEXT("   [FTouchTextureImporter::CopyTexture_AnyThread] UNSUCCESSFULLY copied Texture to Unreal Engine for parameter [%s] for frame `%lld`"),*CopyArgs.RequestParams.Identifier.ToString(), CopyArgs.RequestParams.FrameData.FrameID)
 		if (bSuccessfulCopy)
 		{
-			FScopeLock Lock(&KeepTexturesAliveMutex);
-			KeepTexturesAliveForCopy.Add({TETexture, CopyArgs.TargetRHI});
+			{
+				FScopeLock Lock(&CopiesInFlightMutex);
+				++NumCopiesInFlight;
+				INC_DWORD_STAT(STAT_TE_Import_NbCopiesInFlight)
+			}
+			// The callback keeps both textures alive until the GPU is done with the copy, and releases them right after
+			TETexture->OnCurrentCopyDone_RenderThread(CopyArgs.RHICmdList, [WeakThis = AsWeak(), TETexture, TargetRHI = CopyArgs.TargetRHI]()
+			{
+				if (const TSharedPtr<FTouchTextureImporter> ThisPin = WeakThis.Pin())
+				{
+					ThisPin->OnCopyDone_AnyThread();
+				}
+			});
 		}
 	}
 
-	void FTouchTextureImporter::RemoveUnusedAliveTextures()
+	void FTouchTextureImporter::OnCopyDone_AnyThread()
 	{
-		FScopeLock Lock(&KeepTexturesAliveMutex);
-		KeepTexturesAliveForCopy.RemoveAll([](const TPair<TSharedPtr<ITouchImportTexture>, FTexture2DRHIRef>& TexturePair)
+		FScopeLock Lock(&CopiesInFlightMutex);
+		--NumCopiesInFlight;
+		DEC_DWORD_STAT(STAT_TE_Import_NbCopiesInFlight)
+		if (NumCopiesInFlight == 0 && CopiesDonePromise.IsSet())
 		{
-			return !TexturePair.Key || TexturePair.Key->IsCurrentCopyDone();
-		});
+			UE_LOG(LogTouchEngine, Log, TEXT("[FTouchTextureImporter::OnCopyDone_AnyThread[%s]] All the texture copies are done, the importer is now suspended"), *GetCurrentThreadStr());
+			CopiesDonePromise->SetValue({});
+			CopiesDonePromise.Reset();
+		}
 	}
 }
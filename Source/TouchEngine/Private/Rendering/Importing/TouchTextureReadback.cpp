@@ -0,0 +1,262 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#include "Rendering/Importing/TouchTextureReadback.h"
+
+#include "Logging.h"
+#include "RenderingThread.h"
+#include "RHICommandList.h"
+#include "RHIGPUReadback.h"
+#include "RHIResources.h"
+#include "Misc/CoreDelegates.h"
+#include "Util/TouchEngineStatsGroup.h"
+
+namespace UE::TouchEngine
+{
+	namespace Private
+	{
+		/** The readbacks currently alive. The lock is held while they are polled, so a readback cannot be destroyed while it is being processed */
+		static FCriticalSection ActiveReadbacksMutex;
+		static TArray<FTouchTextureReadback*> ActiveReadbacks;
+		/** Only accessed on the render thread */
+		static FDelegateHandle BeginFrameRTHandle;
+	}
+	
+	FTouchTextureReadback::FTouchTextureReadback()
+	{
+		FScopeLock Lock(&Private::ActiveReadbacksMutex);
+		Private::ActiveReadbacks.Add(this);
+	}
+
+	FTouchTextureReadback::~FTouchTextureReadback()
+	{
+		{
+			FScopeLock Lock(&Private::ActiveReadbacksMutex);
+			Private::ActiveReadbacks.RemoveSingleSwap(this);
+		}
+		FScopeLock Lock(&RingsMutex);
+		Rings.Empty(); // the pending readbacks are discarded, the staging textures are released by the RHI
+	}
+
+	void FTouchTextureReadback::SetReadbackEnabled(FName Identifier, bool bEnabled, int32 RingSize)
+	{
+		FScopeLock Lock(&RingsMutex);
+		if (!bEnabled)
+		{
+			Rings.Remove(Identifier);
+			return;
+		}
+		
+		FReadbackRing& Ring = Rings.FindOrAdd(Identifier);
+		const int32 NumSlots = FMath::Max(RingSize, 1);
+		if (Ring.Slots.Num() != NumSlots)
+		{
+			Ring.Slots.Reset();
+			Ring.Slots.SetNum(NumSlots);
+			Ring.NextSlot = 0;
+		}
+	}
+
+	void FTouchTextureReadback::RegisterFrameHook()
+	{
+		// FCoreDelegates::OnBeginFrameRT is broadcast on the render thread, so it is only modified there
+		ENQUEUE_RENDER_COMMAND(TouchEngineRegisterReadbacks)([](FRHICommandListImmediate&)
+		{
+			if (!Private::BeginFrameRTHandle.IsValid())
+			{
+				Private::BeginFrameRTHandle = FCoreDelegates::OnBeginFrameRT.AddStatic(&FTouchTextureReadback::ProcessAllReadbacks_RenderThread);
+			}
+		});
+	}
+
+	void FTouchTextureReadback::UnregisterFrameHook()
+	{
+		ENQUEUE_RENDER_COMMAND(TouchEngineUnregisterReadbacks)([](FRHICommandListImmediate&)
+		{
+			FCoreDelegates::OnBeginFrameRT.Remove(Private::BeginFrameRTHandle);
+			Private::BeginFrameRTHandle.Reset();
+		});
+		FlushRenderingCommands(); // the module is about to be unloaded, so the binding must be gone before we return
+	}
+
+	void FTouchTextureReadback::ProcessAllReadbacks_RenderThread()
+	{
+		FScopeLock Lock(&Private::ActiveReadbacksMutex);
+		for (FTouchTextureReadback* Readback : Private::ActiveReadbacks)
+		{
+			Readback->ProcessReadbacks_RenderThread();
+		}
+	}
+
+	void FTouchTextureReadback::FlushAllReadbacks_RenderThread(FRHICommandListImmediate& RHICmdList)
+	{
+		// A single wait for the GPU is enough for all the readbacks
+		RHICmdList.SubmitCommandsAndFlushGPU();
+		RHICmdList.BlockUntilGPUIdle();
+		
+		FScopeLock Lock(&Private::ActiveReadbacksMutex);
+		for (FTouchTextureReadback* Readback : Private::ActiveReadbacks)
+		{
+			Readback->DeliverReadbacks_RenderThread(true);
+		}
+	}
+
+	bool FTouchTextureReadback::IsReadbackEnabled(FName Identifier) const
+	{
+		FScopeLock Lock(&RingsMutex);
+		return Rings.Contains(Identifier);
+	}
+
+	FDelegateHandle FTouchTextureReadback::AddListener(FOnTouchTextureReadback::FDelegate&& Listener)
+	{
+		FScopeLock Lock(&ListenersMutex);
+		return OnReadback.Add(MoveTemp(Listener));
+	}
+
+	void FTouchTextureReadback::RemoveListener(FDelegateHandle Handle)
+	{
+		FScopeLock Lock(&ListenersMutex);
+		OnReadback.Remove(Handle);
+	}
+
+	void FTouchTextureReadback::EnqueueReadback_RenderThread(FRHICommandListImmediate& RHICmdList, FName Identifier, int64 FrameID, FRHITexture* Texture)
+	{
+		if (!Texture)
+		{
+			return;
+		}
+		
+		FScopeLock Lock(&RingsMutex);
+		FReadbackRing* Ring = Rings.Find(Identifier);
+		if (!Ring)
+		{
+			return;
+		}
+
+		FReadbackSlot& Slot = Ring->Slots[Ring->NextSlot];
+		if (Slot.bInFlight)
+		{
+			// The oldest readback is still not done, we drop this one instead of waiting for the GPU
+			INC_DWORD_STAT(STAT_TE_Import_ReadbacksDropped)
+			UE_LOG_TOUCHENGINE_HOT_PATH(Verbose, TEXT("[FTouchTextureReadback::EnqueueReadback_RenderThread[%s]] Dropping the readback of `%s` for frame `%lld` as all the readbacks are in flight"),
+				*GetCurrentThreadStr(), *Identifier.ToString(), FrameID);
+			return;
+		}
+
+		const EPixelFormat PixelFormat = Texture->GetDesc().Format;
+		if (GPixelFormats[PixelFormat].BlockSizeX != 1 || GPixelFormats[PixelFormat].BlockSizeY != 1 || GPixelFormats[PixelFormat].BlockBytes <= 0)
+		{
+			// The rows of block compressed formats are not made of pixels, which the listeners expect
+			UE_CLOG(!Ring->bHasWarnedUnsupportedFormat, LogTouchEngine, Warning, TEXT("[FTouchTextureReadback::EnqueueReadback_RenderThread[%s]] The TOP output `%s` cannot be read back as its format `%s` is block compressed"),
+				*GetCurrentThreadStr(), *Identifier.ToString(), GetPixelFormatString(PixelFormat));
+			Ring->bHasWarnedUnsupportedFormat = true;
+			return;
+		}
+
+		DECLARE_SCOPE_CYCLE_COUNTER(TEXT("    III.A.5 [RT] Link Texture Import - Enqueue Readback"), STAT_TE_III_A_5, STATGROUP_TouchEngine);
+		if (!Slot.Readback)
+		{
+			Slot.Readback = MakeUnique<FRHIGPUTextureReadback>(FName(TEXT("TouchEngineTOPReadback")));
+		}
+		// The texture was left readable by the shaders after the import copy
+		RHICmdList.Transition(FRHITransitionInfo(Texture, ERHIAccess::SRVMask, ERHIAccess::CopySrc));
+		Slot.Readback->EnqueueCopy(RHICmdList, Texture);
+		RHICmdList.Transition(FRHITransitionInfo(Texture, ERHIAccess::CopySrc, ERHIAccess::SRVMask));
+		Slot.FrameID = FrameID;
+		Slot.Size = FIntPoint(Texture->GetDesc().Extent.X, Texture->GetDesc().Extent.Y);
+		Slot.PixelFormat = PixelFormat;
+		Slot.bInFlight = true;
+		Ring->NextSlot = (Ring->NextSlot + 1) % Ring->Slots.Num();
+	}
+
+	void FTouchTextureReadback::DeliverReadbacks_RenderThread(bool bGPUIsIdle)
+	{
+		TArray<FTouchTextureReadbackData> ReadyReadbacks;
+		{
+			FScopeLock Lock(&RingsMutex);
+			for (TPair<FName, FReadbackRing>& Ring : Rings)
+			{
+				// The readbacks complete in order, so we start from the oldest one and stop at the first one not ready
+				for (int32 i = 0; i < Ring.Value.Slots.Num(); ++i)
+				{
+					FReadbackSlot& Slot = Ring.Value.Slots[(Ring.Value.NextSlot + i) % Ring.Value.Slots.Num()];
+					if (!Slot.bInFlight)
+					{
+						continue;
+					}
+					if (!bGPUIsIdle && !Slot.Readback->IsReady())
+					{
+						break;
+					}
+					FTouchTextureReadbackData Data;
+					if (ReadPixels_RenderThread(Ring.Key, Slot, Ring.Value, Data))
+					{
+						ReadyReadbacks.Add(MoveTemp(Data));
+					}
+				}
+			}
+		}
+
+		if (!ReadyReadbacks.IsEmpty())
+		{
+			FScopeLock Lock(&ListenersMutex);
+			for (const FTouchTextureReadbackData& Readback : ReadyReadbacks)
+			{
+				OnReadback.Broadcast(Readback);
+			}
+		}
+	}
+
+	bool FTouchTextureReadback::ReadPixels_RenderThread(FName Identifier, FReadbackSlot& Slot, FReadbackRing& Ring, FTouchTextureReadbackData& OutData)
+	{
+		DECLARE_SCOPE_CYCLE_COUNTER(TEXT("    III.A.6 [RT] Link Texture Import - Read Pixels"), STAT_TE_III_A_6, STATGROUP_TouchEngine);
+		Slot.bInFlight = false;
+
+		// 1. We map the staging texture. The RHI can fail to map it (with -nullrhi for example), in which case we do not have any pixel to deliver
+		int32 RowPitchInPixels = 0;
+		const uint8* Source = static_cast<const uint8*>(Slot.Readback->Lock(RowPitchInPixels));
+		if (!Source || RowPitchInPixels < Slot.Size.X)
+		{
+			if (Source)
+			{
+				Slot.Readback->Unlock();
+			}
+			INC_DWORD_STAT(STAT_TE_Import_ReadbacksDropped)
+			UE_LOG_TOUCHENGINE_HOT_PATH(Verbose, TEXT("[FTouchTextureReadback::ReadPixels_RenderThread[%s]] Dropping the readback of `%s` for frame `%lld` as its staging texture could not be mapped"),
+				*GetCurrentThreadStr(), *Identifier.ToString(), Slot.FrameID);
+			return false;
+		}
+		
+		OutData.Identifier = Identifier;
+		OutData.FrameID = Slot.FrameID;
+		OutData.SizeX = Slot.Size.X;
+		OutData.SizeY = Slot.Size.Y;
+		OutData.PixelFormat = Slot.PixelFormat;
+		OutData.RowPitchInBytes = static_cast<int64>(Slot.Size.X) * GPixelFormats[Slot.PixelFormat].BlockBytes;
+
+		// 2. We reuse a buffer the listeners are done with, or add a new one to the ring
+		TSharedPtr<TArray64<uint8>, ESPMode::ThreadSafe>* FreeBuffer = Ring.Buffers.FindByPredicate([](const TSharedPtr<TArray64<uint8>, ESPMode::ThreadSafe>& Buffer) { return Buffer.IsUnique(); });
+		OutData.Pixels = FreeBuffer ? *FreeBuffer : Ring.Buffers.Add_GetRef(MakeShared<TArray64<uint8>, ESPMode::ThreadSafe>());
+		OutData.Pixels->SetNumUninitialized(OutData.RowPitchInBytes * OutData.SizeY, EAllowShrinking::No);
+
+		// 3. The staging texture rows can be padded, so we copy the rows one by one
+		const int64 SourceRowPitchInBytes = static_cast<int64>(RowPitchInPixels) * GPixelFormats[Slot.PixelFormat].BlockBytes;
+		for (int32 Row = 0; Row < OutData.SizeY; ++Row)
+		{
+			FMemory::Memcpy(OutData.Pixels->GetData() + Row * OutData.RowPitchInBytes, Source + Row * SourceRowPitchInBytes, OutData.RowPitchInBytes);
+		}
+		Slot.Readback->Unlock();
+		return true;
+	}
+}
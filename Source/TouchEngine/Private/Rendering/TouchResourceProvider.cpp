@@ -19,11 +19,13 @@
 #include "Engine/Texture2D.h"
 #include "PixelFormat.h"
 #include "Rendering/Importing/TouchTextureImporter.h"
+#include "Util/TouchEngineTrace.h"
 
 namespace UE::TouchEngine
 {
 	TouchObject<TETexture> FTouchResourceProvider::ExportTextureToTouchEngine_AnyThread(const FTouchExportParameters& Params)
 	{
+		TOUCHENGINE_TRACE_COOK_PHASE(ExportTexture, Params.FrameData);
 		if (!Params.Texture)
 		{
 			UE_LOG(LogTouchEngine, Error, TEXT("We can only export valid Textures. Make sure the texture passed as input is valid. %s"), *Params.GetDebugDescription());
@@ -43,11 +45,20 @@ namespace UE::TouchEngine
 	void FTouchResourceProvider::PrepareForNewCook(const FTouchEngineInputFrameData& FrameData)
 	{
 		InitializeExportsToTouchEngine_GameThread(FrameData);
-		GetImporter().PrepareForNewCook(FrameData);
 	}
 
 	TFuture<FTouchTextureImportResult> FTouchResourceProvider::ImportTextureToUnrealEngine_AnyThread(const FTouchImportParameters& LinkParams, const TSharedPtr<FTouchFrameCooker>& FrameCooker)
 	{
 		return GetImporter().ImportTexture_AnyThread(LinkParams, FrameCooker);
 	}
+
+	void FTouchResourceProvider::PrewarmImportedTexturePool_GameThread(const TArray<FTouchEngineTextureDescriptor>& Descriptors)
+	{
+		GetImporter().PrewarmPool_GameThread(Descriptors);
+	}
+
+	TArray<FTouchEngineTextureDescriptor> FTouchResourceProvider::GetObservedImportedTextureDescriptors()
+	{
+		return GetImporter().GetObservedDescriptors();
+	}
 }
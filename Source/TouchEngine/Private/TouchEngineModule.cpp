@@ -15,13 +15,19 @@
 #include "TouchEngineModule.h"
 
 #include "Logging.h"
+#include "Engine/Util/TouchCookStats.h"
 #if WITH_EDITOR
 #include "MessageLogModule.h"
 #endif
 #include "Interfaces/IPluginManager.h"
 #include "Rendering/TouchResourceProvider.h"
+#include "Rendering/Headless/TouchResourceProviderHeadless.h"
+#include "Rendering/Importing/TouchTextureReadback.h"
 #include "TouchEngine/TEResult.h"
 
+#include "Misc/CommandLine.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/Parse.h"
 #include "Misc/Paths.h"
 
 #define LOCTEXT_NAMESPACE "TouchEngineModule"
@@ -32,6 +38,15 @@ namespace UE::TouchEngine
 	{
 		LoadTouchEngineLib();
 
+		// Without a GPU (-nullrhi), the textures are kept in host memory so the cook pipeline can still run
+		BindResourceProvider(Headless::NullRHIName, FResourceProviderFactory::CreateLambda([](const FResourceProviderInitArgs& Args)
+		{
+			return Headless::MakeHeadlessResourceProvider(Args);
+		}));
+
+		FTouchTextureReadback::RegisterFrameHook();
+		FTouchCookStats::Create();
+
 #if WITH_EDITOR
 		// Register the Message Log Category
 		FMessageLogModule& MessageLogModule = FModuleManager::LoadModuleChecked<FMessageLogModule>("MessageLog");
@@ -46,6 +61,8 @@ namespace UE::TouchEngine
 	void FTouchEngineModule::ShutdownModule()
 	{
 		ResourceFactories.Reset();
+		FTouchTextureReadback::UnregisterFrameHook();
+		FTouchCookStats::Destroy();
 		UnloadTouchEngineLib();
 
 #if WITH_EDITOR
@@ -101,25 +118,64 @@ namespace UE::TouchEngine
 		return nullptr;
 	}
 
-	void FTouchEngineModule::LoadTouchEngineLib()
+	FString FTouchEngineModule::GetTouchEngineLibPath()
 	{
+#if PLATFORM_WINDOWS
+		const FString LibName = TEXT("TouchEngine.dll");
+#else
+		const FString LibName = TEXT("libTouchEngine.so");
+#endif
+
+		// 1. An explicit path, for example to load a stand-in implementation of the TouchEngine API when profiling without TouchDesigner installed
+		FString ConfiguredPath;
+#if PLATFORM_WINDOWS
+		FParse::Value(FCommandLine::Get(), TEXT("TouchEngineLib="), ConfiguredPath);
+#else
+		// Outside of Windows, TouchEngineAPI.Build.cs links against the library at [TouchEngine] LibraryPath, which is bound by the dynamic loader before we get here,
+		// so the command line cannot pick another library anymore
+		FString CommandLinePath;
+		UE_CLOG(FParse::Value(FCommandLine::Get(), TEXT("TouchEngineLib="), CommandLinePath), LogTouchEngine, Warning,
+			TEXT("-TouchEngineLib=%s is ignored on this platform, set [TouchEngine] LibraryPath in Engine.ini and rebuild the plugin instead"), *CommandLinePath);
+#endif
+		if (ConfiguredPath.IsEmpty() && GConfig)
+		{
+			GConfig->GetString(TEXT("TouchEngine"), TEXT("LibraryPath"), ConfiguredPath, GEngineIni);
+		}
+		if (!ConfiguredPath.IsEmpty())
+		{
+			FPaths::NormalizeFilename(ConfiguredPath);
+			if (FPaths::IsRelative(ConfiguredPath))
+			{
+				ConfiguredPath = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir(), ConfiguredPath);
+			}
+			return FPaths::DirectoryExists(ConfiguredPath) ? FPaths::Combine(ConfiguredPath, LibName) : ConfiguredPath;
+		}
+
+		// 2. The library shipped with the plugin
 #if WITH_EDITOR
-		const FString BasePath = FPaths::Combine(IPluginManager::Get().FindPlugin(TEXT("TouchEngine"))->GetBaseDir(), TEXT("/Binaries/ThirdParty/Win64"));
+		const FString BasePath = FPaths::Combine(IPluginManager::Get().FindPlugin(TEXT("TouchEngine"))->GetBaseDir(), TEXT("/Binaries/ThirdParty"), FPlatformProcess::GetBinariesSubdirectory());
 #else
-		const FString BasePath = FPaths::Combine(FPaths::ProjectDir(), TEXT("/Binaries/Win64"));
+		const FString BasePath = FPaths::Combine(FPaths::ProjectDir(), TEXT("/Binaries"), FPlatformProcess::GetBinariesSubdirectory());
 #endif
-		const FString FullPathToDLL = FPaths::Combine(BasePath, TEXT("TouchEngine.dll"));
+		return FPaths::Combine(BasePath, LibName);
+	}
+
+	void FTouchEngineModule::LoadTouchEngineLib()
+	{
+		const FString FullPathToDLL = GetTouchEngineLibPath();
 		if (!FPaths::FileExists(FullPathToDLL))
 		{
-			UE_LOG(LogTouchEngine, Error, TEXT("Invalid path to TouchEngine.dll: %s"), *FullPathToDLL);
+			UE_LOG(LogTouchEngine, Error, TEXT("Invalid path to the TouchEngine library: %s"), *FullPathToDLL);
 			return;
 		}
 		
+		const FString BasePath = FPaths::GetPath(FullPathToDLL);
 		FPlatformProcess::PushDllDirectory(*BasePath);
 		TouchEngineLibHandle = FPlatformProcess::GetDllHandle(*FullPathToDLL);
 		FPlatformProcess::PopDllDirectory(*BasePath);
 		
 		UE_CLOG(!IsTouchEngineLibInitialized(), LogTouchEngine, Error, TEXT("Failed to load TouchEngine library: %s"), *FullPathToDLL);
+		UE_CLOG(IsTouchEngineLibInitialized(), LogTouchEngine, Log, TEXT("Loaded TouchEngine library: %s"), *FullPathToDLL);
 	}
 
 	void FTouchEngineModule::UnloadTouchEngineLib()
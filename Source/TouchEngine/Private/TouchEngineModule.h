@@ -43,6 +43,8 @@ namespace UE::TouchEngine
 		/** Result of loading lib */
 		void* TouchEngineLibHandle = nullptr;
 		
+		/** The TouchEngine library to load: -TouchEngineLib=<path> on the command line, then [TouchEngine] LibraryPath in Engine.ini, then the one shipped with the plugin. The path can be a file or a directory. */
+		static FString GetTouchEngineLibPath();
 		void LoadTouchEngineLib();
 		void UnloadTouchEngineLib();
 	};
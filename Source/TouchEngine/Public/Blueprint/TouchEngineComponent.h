@@ -17,6 +17,8 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "TouchEngineDynamicVariableStruct.h"
+#include "Blueprint/TouchEngineStatistics.h"
+#include "Blueprint/TouchEngineTextureDescriptor.h"
 #include "Engine/TouchEngine.h"
 #include "Engine/Util/CookFrameData.h"
 #include "TouchEngineComponent.generated.h"
@@ -30,6 +32,7 @@ namespace UE::TouchEngine
 {
 	struct FCachedToxFileInfo;
 	struct FCookFrameResult;
+	class FTouchCookTimeline;
 }
 
 
@@ -68,6 +71,21 @@ enum class ETouchEngineCookMode : uint8
 	Max							UMETA(Hidden)
 };
 
+/*
+* How often the TouchEngine component requests a cook
+*/
+UENUM(BlueprintType)
+enum class ETouchEngineCookRate : uint8
+{
+	/** A cook is requested every tick */
+	EveryTick = 0				UMETA(DisplayName = "Every Tick"),
+	/** Cooks are requested at the TE Frame Rate. The ticks in between only accumulate the input changes */
+	TouchEngineFrameRate = 1	UMETA(DisplayName = "TE Frame Rate"),
+	/** Cooks are requested at the Custom Cook Rate. The ticks in between only accumulate the input changes */
+	Custom = 2					UMETA(DisplayName = "Custom"),
+	Max							UMETA(Hidden)
+};
+
 /*
 * The different times the TouchEngine component will set / get variables from the TouchEngine instance. todo: to deprecate
 */
@@ -79,6 +97,24 @@ enum class ETouchEngineSendMode : uint8
 	Max					UMETA(Hidden)
 };
 
+/*
+* How far behind TouchEngine is compared to the rate at which the component requests cooks
+*/
+UENUM(BlueprintType)
+enum class ETouchEngineBackpressure : uint8
+{
+	/** TouchEngine keeps up with the cooks requested by the component */
+	None = 0			UMETA(DisplayName = "None"),
+	/** Cooks are queueing up or take longer than a tick. Sending inputs less often would let TouchEngine catch up */
+	Elevated = 1		UMETA(DisplayName = "Elevated"),
+	/** The Input Buffer Limit is reached and inputs are being discarded. Inputs sent now are likely to be merged into a later cook */
+	Saturated = 2		UMETA(DisplayName = "Saturated"),
+	Max					UMETA(Hidden)
+};
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnBackpressureChanged_Native, ETouchEngineBackpressure /*Backpressure*/);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnBackpressureChanged, ETouchEngineBackpressure, Backpressure);
+
 
 /*
 * Adds a TouchEngine instance to an object.
@@ -109,9 +145,20 @@ public:
 	UPROPERTY(meta=(DeprecatedProperty, DeprecationMessage="There shouldn't be the need for a SendMode available to the user, the backend of the component will deal with this."))
 	ETouchEngineSendMode SendMode_DEPRECATED = ETouchEngineSendMode::EveryFrame;
 
-	/** TouchEngine framerate */
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Tox File", meta = (DisplayName = "TE Frame Rate"))
-	int64 TEFrameRate = 60;
+	/** TouchEngine framerate. Fractional rates are supported, and NTSC rates like 29.97 or 59.94 are sent to TouchEngine as their exact N*1000/1001 value */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Tox File", meta = (DisplayName = "TE Frame Rate", ClampMin = 0.001, UIMin = 1, UIMax = 240))
+	double TEFrameRate = 60.0;
+
+	/**
+	 * How often the component requests a cook, independently of the game tick rate.
+	 * When not cooking every tick, the ticks in between only accumulate the input changes and the elapsed time, which are sent with the next cook, and OnStartFrame is only called when a cook is requested.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tox File")
+	ETouchEngineCookRate CookRate = ETouchEngineCookRate::TouchEngineFrameRate;
+
+	/** The number of cooks per second to request when Cook Rate is set to Custom */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tox File", meta = (EditCondition = "CookRate == ETouchEngineCookRate::Custom", EditConditionHides, ClampMin = 1, UIMin = 1, UIMax = 240, ForceUnits = "Hz"))
+	float CustomCookRate = 60.f;
 
 	/** Multiplier applied to delta time before sending to TouchEngine. Deprecated as it shouldn't be set by the user */
 	UPROPERTY(meta=(DeprecatedProperty, DeprecationMessage="There shouldn't be the need for the TimeScale to be adjustable by the user, it is automatically computed by the backend."))
@@ -161,6 +208,61 @@ public:
 	 */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tox File", AdvancedDisplay, meta=(ClampMin=1, UIMin=1, UIMax=30))
 	int32 ImportedTexturePoolSize = 20;
+	/**
+	 * The maximum GPU memory, in megabytes, that the textures kept in the export texture pool can take.
+	 * When over budget, the least recently used textures are released first. 0 means the pool is only limited by ExportedTexturePoolSize.
+	 * This will only have an effect if changed before loading a tox file.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tox File", AdvancedDisplay, meta=(ClampMin=0, UIMin=0, UIMax=4096, ForceUnits="MB"))
+	int32 ExportedTexturePoolBudget = 0;
+	/**
+	 * The maximum GPU memory, in megabytes, that the Frame UTextures kept in the import texture pool can take.
+	 * When over budget, the least recently used textures are released first. 0 means the pool is only limited by ImportedTexturePoolSize.
+	 * This will only have an effect if changed before loading a tox file.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tox File", AdvancedDisplay, meta=(ClampMin=0, UIMin=0, UIMax=4096, ForceUnits="MB"))
+	int32 ImportedTexturePoolBudget = 0;
+	/**
+	 * If true, the texture pools are trimmed to the number of textures actually needed over the last few seconds of cooks, instead of always keeping
+	 * ExportedTexturePoolSize and ImportedTexturePoolSize textures. The pools grow back as soon as more textures are needed, and the pool sizes act as upper bounds.
+	 * This will only have an effect if changed before loading a tox file.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tox File", AdvancedDisplay)
+	bool bAdaptiveTexturePoolSize = false;
+	/** The minimum number of textures the export texture pool keeps when bAdaptiveTexturePoolSize is true */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tox File", AdvancedDisplay, meta=(EditCondition="bAdaptiveTexturePoolSize", ClampMin=0, UIMin=0, UIMax=20))
+	int32 MinExportedTexturePoolSize = 2;
+	/** The minimum number of textures the import texture pool keeps when bAdaptiveTexturePoolSize is true */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tox File", AdvancedDisplay, meta=(EditCondition="bAdaptiveTexturePoolSize", ClampMin=0, UIMin=0, UIMax=20))
+	int32 MinImportedTexturePoolSize = 2;
+	/**
+	 * The identifiers of the TOP outputs to read back to the CPU after each cook. The readback is asynchronous: the pixels are delivered on the render thread
+	 * a few frames later to the listeners added with FTouchEngine::AddTOPReadbackListener, tagged with the FrameID of the cook which produced them.
+	 * This will only have an effect if changed before loading a tox file.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tox File", AdvancedDisplay)
+	TArray<FString> ReadbackTOPOutputs;
+	/** The number of readbacks of a single TOP output which can be in flight. When they are all in flight, the readback of the next cook is dropped */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tox File", AdvancedDisplay, meta=(ClampMin=1, UIMin=1, UIMax=8))
+	int32 ReadbackRingSize = 3;
+	/**
+	 * The textures expected to be sent to TouchEngine. The export texture pool will be filled with matching textures when the tox file is loaded,
+	 * to avoid creating them during the first cooks.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tox File", AdvancedDisplay)
+	TArray<FTouchEngineTextureDescriptor> PrewarmedExportedTextures;
+	/**
+	 * The textures expected to be received from TouchEngine. The import texture pool will be filled with matching Frame UTextures when the tox file is loaded,
+	 * to avoid creating them during the first cooks.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tox File", AdvancedDisplay)
+	TArray<FTouchEngineTextureDescriptor> PrewarmedImportedTextures;
+	/**
+	 * If true, the textures exchanged with TouchEngine are remembered when the tox file is unloaded,
+	 * and the texture pools are filled with them, in addition to the Prewarmed Textures, the next time this tox file is loaded.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tox File", AdvancedDisplay)
+	bool bLearnPrewarmedTextures = false;
 	
 	/**
 	 * The number of second to wait for the tox file to load before cancelling.
@@ -222,6 +324,46 @@ public:
 	 */
 	UFUNCTION(BlueprintCallable, Category = "TouchEngine|TOP")
 	bool KeepFrameTexture(UTexture2D* FrameTexture, UTexture2D*& Texture);
+
+	/**
+	 * Returns the descriptors of the textures exchanged with TouchEngine since the tox file was loaded.
+	 * They can be used to fill Prewarmed Exported Textures and Prewarmed Imported Textures.
+	 * @return true if the component is running and the descriptors could be retrieved
+	 */
+	UFUNCTION(BlueprintCallable, Category = "TouchEngine|TOP")
+	bool GetObservedTextureDescriptors(TArray<FTouchEngineTextureDescriptor>& ExportedTextures, TArray<FTouchEngineTextureDescriptor>& ImportedTextures) const;
+
+	/**
+	 * Returns the last statistics TouchEngine delivered for this component's instance. TouchEngine delivers them about once per second.
+	 * Comparing their CPU Frame Time with the Latency of the cooks tells the time spent in the TouchDesigner network apart from the time spent transferring and scheduling in the plugin.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "TouchEngine|Statistics")
+	FTouchEngineStatistics GetTouchEngineStatistics() const;
+
+	/**
+	 * Returns the number of frames delivered, dropped, duplicated and discarded since the component was created or ResetFrameCounters was called.
+	 * Unlike the Was Frame Dropped flag of OnEndFrame, they keep track of every cadence problem, which is useful for long running installations.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "TouchEngine|Statistics")
+	FTouchEngineFrameCounters GetFrameCounters() const { return FrameCounters; }
+
+	/** Resets the counts returned by GetFrameCounters */
+	UFUNCTION(BlueprintCallable, Category = "TouchEngine|Statistics")
+	void ResetFrameCounters() { FrameCounters = FTouchEngineFrameCounters(); }
+
+	/**
+	 * Returns how far behind TouchEngine is. It is derived from the number of cooks waiting in the queue, the inputs discarded and the duration of the last cooks compared to the tick interval.
+	 * While it is not None, game code can send inputs less often, as inputs sent while Saturated are likely to be discarded.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "TouchEngine|States")
+	ETouchEngineBackpressure GetBackpressure() const { return Backpressure; }
+
+	/** Returns the number of cooks waiting for the current cook to be done before being sent to TouchEngine */
+	UFUNCTION(BlueprintCallable, Category = "TouchEngine|States")
+	int32 GetNumPendingCooks() const;
+
+	/** Returns the timestamps of the last cooks of this component, or null if no cook was recorded yet. They can be dumped to a file with TouchEngine.CookTimeline.Dump */
+	const TSharedPtr<UE::TouchEngine::FTouchCookTimeline>& GetCookTimeline() const { return CookTimeline; }
 	
 	//~ Begin UObject Interface
 	virtual void BeginDestroy() override;
@@ -264,6 +406,7 @@ public:
 	FOnToxReset_Native& GetOnToxReset() { return OnToxReset_Native; }
 	FOnToxFailedLoad_Native& GetOnToxFailedLoad() { return OnToxFailedLoad_Native; }
 	FOnToxUnloaded_Native& GetOnToxUnloaded() { return OnToxUnloaded_Native; }
+	FOnBackpressureChanged_Native& GetOnBackpressureChanged() { return OnBackpressureChanged_Native; }
 
 protected:
 	/** Called when the TouchEngine instance starts to load the tox file */
@@ -299,6 +442,11 @@ protected:
 	UPROPERTY(BlueprintAssignable, Category = "Components|Parameters")
 	FOnEndFrame OnEndFrame;
 
+	/** Called when the backpressure of the cooks changes. See GetBackpressure */
+	UPROPERTY(BlueprintAssignable, Category = "Components|Parameters")
+	FOnBackpressureChanged OnBackpressureChanged;
+	FOnBackpressureChanged_Native OnBackpressureChanged_Native;
+
 	/** Begins Play for the component that also fires in the Editor. */
 	UPROPERTY(BlueprintAssignable, Category = "Components|Activation", meta=(DisplayName = "Begin Play"))
 	FBeginPlay CustomBeginPlay;
@@ -313,6 +461,7 @@ protected:
 	void BroadcastOnToxUnloaded(bool bInSkipBlueprintEvent = false);
 	void BroadcastOnStartFrame(const FTouchEngineInputFrameData& FrameData) const;
 	void BroadcastOnEndFrame(ECookFrameResult Result, const FTouchEngineOutputFrameData& FrameData) const;
+	void BroadcastOnBackpressureChanged() const;
 
 	void BroadcastCustomBeginPlay() const;
 	void BroadcastCustomEndPlay() const;
@@ -326,7 +475,34 @@ private:
 
 	FDelegateHandle ParamsLoadedDelegateHandle;
 	FDelegateHandle LoadFailedDelegateHandle;
+
+	ETouchEngineBackpressure Backpressure = ETouchEngineBackpressure::None;
+	/** Moving averages, in seconds, of the duration of the TouchEngine cooks and of the interval between two cook requests */
+	double AverageCookDuration = 0.0;
+	double AverageCookRequestInterval = 0.0;
+	/** The number of cooks which came back with InputsDiscarded since the backpressure was last updated */
+	int32 NumInputsDiscardedSinceUpdate = 0;
+	/** The last time the backpressure was at least at its current level. It is only lowered after a short while, to not flip every tick */
+	double LastBackpressureRaisedTime = 0.0;
+	/** Updates the backpressure from the state of the cook queue. Called once per cook request */
+	void UpdateBackpressure_GameThread();
+	void ResetBackpressure_GameThread();
+
+	/** Records the timestamps of the last cooks. Created on the first cook finishing while TouchEngine.CookTimeline.Enable is set */
+	TSharedPtr<UE::TouchEngine::FTouchCookTimeline> CookTimeline;
 	
+	/** The time accumulated towards the next cook when not cooking every tick. Can be negative when the last cook was requested a bit early */
+	double CookRateAccumulator = 0.0;
+	/** The cumulative counts returned by GetFrameCounters. They are kept when the tox is reloaded */
+	FTouchEngineFrameCounters FrameCounters;
+
+	/** The game time elapsed since the last cook was requested, sent to TouchEngine with the next cook */
+	float TimeSinceLastCookRequest = 0.f;
+	/** Returns true if a cook should be requested this tick, according to the CookRate */
+	bool ShouldRequestCook_GameThread(float DeltaTime);
+	/** Returns the number of seconds between two cooks, or 0 if a cook is requested every tick */
+	double GetCookInterval() const;
+
 	void StartNewCook(float DeltaTime);
 	void OnCookFinished(const UE::TouchEngine::FCookFrameResult& CookFrameResult);
 
@@ -347,6 +523,10 @@ private:
 	TFuture<UE::TouchEngine::FCachedToxFileInfo> LoadToxThroughCache(bool bForceReloadTox);
 	
 	void CreateEngineInfo();
+	/** Fills the texture pools of the local engine with the prewarmed textures and the ones learnt from previous runs */
+	void PrewarmTexturePools() const;
+	/** Remembers the textures exchanged with TouchEngine for the next time the tox file is loaded, if bLearnPrewarmedTextures is true */
+	void LearnPrewarmedTextures() const;
 
 	FString GetAbsoluteToxPath() const;
 	
@@ -27,6 +27,9 @@ struct FTouchEngineInputFrameData
 
 	/** The time at which the frame started. Only used to compute the tick latency of the matching FTouchEngineOutputFrameData */
 	double StartTime = 0.0;
+
+	/** The path of the component which started the frame. Only set when the TouchEngine trace channel is enabled, to tag the trace events of the frame */
+	FName ComponentName;
 };
 
 USTRUCT(BlueprintType)
@@ -0,0 +1,84 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TouchEngineStatistics.generated.h"
+
+/** The statistics TouchEngine reports about an instance, about once per second */
+USTRUCT(BlueprintType)
+struct FTouchEngineStatistics
+{
+	GENERATED_BODY()
+
+	/** False until TouchEngine delivered its first statistics for the instance */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "TouchEngine")
+	bool bIsValid = false;
+
+	/** The GPU memory used by the instance, in bytes */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "TouchEngine")
+	int64 GPUMemoryUsed = 0;
+	/** The CPU memory used by the instance, in bytes */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "TouchEngine")
+	int64 CPUMemoryUsed = 0;
+
+	/** The CPU time TouchEngine spent on the frames, in milliseconds. This is the time spent in the TouchDesigner network, excluding the transfers and scheduling done by the plugin */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "TouchEngine")
+	double CPUFrameTime = 0.0;
+	/** The GPU time TouchEngine spent on the frames, in milliseconds. It is delayed by one frame, and -1 if the version of TouchDesigner does not report it */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "TouchEngine")
+	double GPUFrameTime = -1.0;
+
+	/** The number of frames processed by TouchEngine since the previous statistics */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "TouchEngine")
+	int64 FramesProcessed = 0;
+	/** The number of frames dropped by TouchEngine since the previous statistics, -1 if the version of TouchDesigner does not report it */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "TouchEngine")
+	int64 FramesDropped = 0;
+
+	/** The number of frames processed by TouchEngine since the instance was created */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "TouchEngine")
+	int64 TotalFramesProcessed = 0;
+	/** The number of frames dropped by TouchEngine since the instance was created */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "TouchEngine")
+	int64 TotalFramesDropped = 0;
+
+	/** The number of seconds since the statistics were received, as they are only delivered about once per second */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "TouchEngine")
+	double Age = 0.0;
+
+	/** The FPlatformTime::Seconds() at which the statistics were received */
+	double ReceivedTime = 0.0;
+};
+
+/** The cumulative frame counts of a TouchEngine component, used to find cadence problems over long periods of time */
+USTRUCT(BlueprintType)
+struct FTouchEngineFrameCounters
+{
+	GENERATED_BODY()
+
+	/** The number of cooks TouchEngine delivered a frame for */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "TouchEngine")
+	int64 FramesDelivered = 0;
+	/** The number of TouchEngine frames which were never delivered, because the time between two cooks was longer than the time requested between them */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "TouchEngine")
+	int64 FramesDropped = 0;
+	/** The number of cooks TouchEngine answered with a frame it had already delivered, so the outputs did not change */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "TouchEngine")
+	int64 FramesDuplicated = 0;
+	/** The number of cooks which were never delivered, because their inputs were discarded or the cooks were cancelled, timed out or failed */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "TouchEngine")
+	int64 FramesDiscarded = 0;
+};
@@ -0,0 +1,67 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PixelFormat.h"
+#include "TouchEngineTextureDescriptor.generated.h"
+
+/** Describes textures expected to be exchanged with TouchEngine, used to fill the texture pools before the first cook */
+USTRUCT(BlueprintType)
+struct FTouchEngineTextureDescriptor
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TouchEngine", meta=(ClampMin=1, UIMin=1))
+	int32 SizeX = 1920;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TouchEngine", meta=(ClampMin=1, UIMin=1))
+	int32 SizeY = 1080;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TouchEngine")
+	TEnumAsByte<EPixelFormat> PixelFormat = PF_B8G8R8A8;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TouchEngine", meta=(ClampMin=1, UIMin=1))
+	int32 NumMips = 1;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TouchEngine")
+	bool bIsSRGB = false;
+
+	/** The number of textures matching this descriptor to create in the texture pool */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TouchEngine", meta=(ClampMin=0, UIMin=0, UIMax=10))
+	int32 Count = 2;
+
+	/** Returns true if both descriptors describe the same textures, regardless of their Count */
+	bool MatchesTexture(const FTouchEngineTextureDescriptor& Other) const
+	{
+		return SizeX == Other.SizeX
+			&& SizeY == Other.SizeY
+			&& PixelFormat == Other.PixelFormat
+			&& NumMips == Other.NumMips
+			&& bIsSRGB == Other.bIsSRGB;
+	}
+
+	/** Adds the descriptors of Other into Descriptors, keeping the highest Count for descriptors present in both */
+	static void Merge(TArray<FTouchEngineTextureDescriptor>& Descriptors, const TArray<FTouchEngineTextureDescriptor>& Other)
+	{
+		for (const FTouchEngineTextureDescriptor& Descriptor : Other)
+		{
+			if (FTouchEngineTextureDescriptor* Existing = Descriptors.FindByPredicate([&Descriptor](const FTouchEngineTextureDescriptor& Item) { return Item.MatchesTexture(Descriptor); }))
+			{
+				Existing->Count = FMath::Max(Existing->Count, Descriptor.Count);
+			}
+			else
+			{
+				Descriptors.Add(Descriptor);
+			}
+		}
+	}
+};
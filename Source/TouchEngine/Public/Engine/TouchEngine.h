@@ -15,7 +15,9 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Misc/FrameRate.h"
 
+#include "Blueprint/TouchEngineStatistics.h"
 #include "Engine/TouchLoadResults.h"
 #include "Engine/Util/TouchVariableManager.h"
 #include "TouchEngineDynamicVariableStruct.h"
@@ -64,6 +66,7 @@ namespace UE::TouchEngine
 		
 		static void TouchEventCallback_AnyThread(TEInstance* Instance, TEEvent Event, TEResult Result, int64_t StartTimeValue, int32_t StartTimeScale, int64_t EndTimeValue, int32_t EndTimeScale, void* Info);
 		static void	LinkValueCallback_AnyThread(TEInstance* Instance, TELinkEvent Event, const char* Identifier, void* Info);
+		static void StatisticsCallback_AnyThread(TEInstance* Instance, const TEInstanceStatistics* Statistics, void* Info);
 	};
 	
 	class TOUCHENGINE_API FTouchEngine : public TSharedFromThis<FTouchEngine>
@@ -84,19 +87,39 @@ namespace UE::TouchEngine
 
 		/** Returns the FrameID to be used for the next cook. */
 		int64 GetNextFrameID() const;
+		/** Returns the number of cooks waiting in the queue of the frame cooker */
+		int32 GetNumPendingCooks() const;
 
 		TFuture<FCookFrameResult> CookFrame_GameThread(FCookFrameRequest&& CookFrameRequest, int32 InputBufferLimit);
 		/** Execute the next queued CookFrameRequest if no cook is on going */
 		bool ExecuteNextPendingCookFrame_GameThread() const;
 		
 		void SetCookMode(bool bIsIndependent);
-		bool SetFrameRate(int64 FrameRate);
-		float GetFrameRate() const
+		/** Sets the frame rate TouchEngine runs at. Integer and NTSC rates (like 29.97 or 59.94) are converted to exact rational numbers */
+		bool SetFrameRate(double FrameRate);
+		FFrameRate GetFrameRate() const
 		{
 			return TargetFrameRate;
 		}
+		/** Returns the TimeScale the cook times are sent with, chosen so that a frame lasts a whole number of ticks */
+		int64 GetTimeScale() const;
 		bool SetExportedTexturePoolSize(int ExportedTexturePoolSize);
 		bool SetImportedTexturePoolSize(int ImportedTexturePoolSize);
+		bool SetExportedTexturePoolBudget(int64 ExportedTexturePoolBudgetBytes);
+		bool SetImportedTexturePoolBudget(int64 ImportedTexturePoolBudgetBytes);
+		/** Enables trimming the texture pools to the observed demand. The pool sizes then act as upper bounds and the pools never go below MinPoolSize */
+		bool SetTexturePoolAdaptiveSizing(bool bEnabled, int32 MinExportedPoolSize, int32 MinImportedPoolSize);
+		/** Fills the texture pools with textures matching the given descriptors, so the first cooks do not need to create them */
+		void PrewarmTexturePools_GameThread(const TArray<FTouchEngineTextureDescriptor>& ImportedTextures, const TArray<FTouchEngineTextureDescriptor>& ExportedTextures);
+		/** Returns the descriptors of the textures imported and exported since the tox file was loaded, which can be used to prewarm the pools on the next load */
+		bool GetObservedTextureDescriptors(TArray<FTouchEngineTextureDescriptor>& OutImportedTextures, TArray<FTouchEngineTextureDescriptor>& OutExportedTextures) const;
+		/** Enables or disables the asynchronous CPU readback of the given TOP output. RingSize is the number of readbacks which can be in flight before new ones are dropped */
+		bool SetTOPReadbackEnabled(const FString& Identifier, bool bEnabled, int32 RingSize = FTouchTextureReadback::DefaultRingSize);
+		/** Adds a listener receiving the pixels of the TOP outputs the readback is enabled for. The listener is called on the render thread */
+		FDelegateHandle AddTOPReadbackListener(FOnTouchTextureReadback::FDelegate&& Listener);
+		void RemoveTOPReadbackListener(FDelegateHandle Handle);
+		/** Returns the last statistics TouchEngine delivered for the instance. They are invalid until TouchEngine delivered some, which happens about once per second */
+		FTouchEngineStatistics GetStatistics() const;
 
 		/* Code to be reviewed */
 		FTouchEngineCHOP GetCHOPOutputSingleSample(const FString& Identifier) const	{ return LoadState_GameThread == ELoadState::Ready && ensure(TouchResources.VariableManager) ? TouchResources.VariableManager->GetCHOPOutputSingleSample(Identifier) : FTouchEngineCHOP{}; }
@@ -140,6 +163,16 @@ namespace UE::TouchEngine
 			}
 			return false;
 		}
+		/** Returns what the imported texture pool did since the tox was loaded, or false if it is not loaded */
+		bool GetImportedTexturePoolCounters(FTouchTexturePoolCounters& OutCounters) const
+		{
+			if (LoadState_GameThread == ELoadState::Ready && ensure(TouchResources.ResourceProvider))
+			{
+				OutCounters = TouchResources.ResourceProvider->GetImporter().GetPoolCounters();
+				return true;
+			}
+			return false;
+		}
 
 		void CancelCurrentAndNextCooks_GameThread(ECookFrameResult CookFrameResult);
 		bool CancelCurrentFrame_GameThread(int64 FrameID, ECookFrameResult CookFrameResult = ECookFrameResult::Cancelled);
@@ -209,7 +242,13 @@ namespace UE::TouchEngine
 		 * If this is the first one we receive, LastFrameStartTimeValue would not be set. */
 		TOptional<int64_t> LastFrameStartTimeValue; 
 
-		float TargetFrameRate = 60.f;
+		/** Guards Statistics and bAcceptsStatistics, which are written from the TouchEngine threads */
+		mutable FCriticalSection StatisticsLock;
+		FTouchEngineStatistics Statistics;
+		/** Only true while the instance is alive, so the statistics delivered latently after it is destroyed do not show up in the stats */
+		bool bAcceptsStatistics = false;
+
+		FFrameRate TargetFrameRate = FFrameRate(60, 1);
 		TETimeMode TimeMode = TETimeInternal;
 
 		/** Systems that are only valid while there is a TouchEngine (being) loaded. */
@@ -231,6 +270,9 @@ namespace UE::TouchEngine
 		void ResumeLoadAfterUnload_GameThread();
 
 		void LinkValue_AnyThread(TEInstance* Instance, TELinkEvent Event, const char* Identifier);
+		void OnStatistics_AnyThread(const TEInstanceStatistics& InStatistics);
+		/** Stops accepting statistics and removes those of the instance from the stats */
+		void ResetStatistics();
 
 		void SharedCleanUp();
 		void CreateNewLoadPromise();
@@ -19,6 +19,7 @@
 #include "PixelFormat.h"
 #include "Engine/TextureRenderTarget2D.h"
 #include "TouchEngineDynamicVariableStruct.h"
+#include "Blueprint/TouchEngineTextureDescriptor.h"
 #include "TouchLoadResults.h"
 #include "Subsystems/EngineSubsystem.h"
 #include "TouchEngineSubsystem.generated.h"
@@ -90,6 +91,15 @@ public:
 	void LoadPixelFormats(const UTouchEngineInfo* ComponentEngineInfo);
 
 	TObjectPtr<UTouchEngineInfo> GetTempEngineInfo() const { return EngineForLoading; }
+
+	/**
+	 * Remembers the textures a component exchanged with TouchEngine while running the given tox file,
+	 * so the texture pools can be filled with them the next time this tox file is loaded.
+	 * The descriptors are merged with the ones previously cached for this tox file.
+	 */
+	void CacheObservedTextureDescriptors(const UToxAsset* ToxAsset, const TArray<FTouchEngineTextureDescriptor>& ImportedTextures, const TArray<FTouchEngineTextureDescriptor>& ExportedTextures);
+	/** Returns the textures previously cached with CacheObservedTextureDescriptors for the given tox file. Returns false if there are none */
+	bool GetObservedTextureDescriptors(const UToxAsset* ToxAsset, TArray<FTouchEngineTextureDescriptor>& OutImportedTextures, TArray<FTouchEngineTextureDescriptor>& OutExportedTextures) const;
 	
 private:
 	struct FLoadTask
@@ -104,6 +114,14 @@ private:
 
 	TMap<FString, UE::TouchEngine::FTouchLoadResult> CachedFileData;
 
+	struct FObservedTextureDescriptors
+	{
+		TArray<FTouchEngineTextureDescriptor> ImportedTextures;
+		TArray<FTouchEngineTextureDescriptor> ExportedTextures;
+	};
+	/** The textures observed while running each tox file, keyed by absolute path */
+	TMap<FString, FObservedTextureDescriptors> CachedTextureDescriptors;
+
 	// Temporary pointer needed to have IsLoading return true for this asset when it is starting to be processed in GetOrLoadParamsFromTox.
 	TWeakObjectPtr<UToxAsset> ToxAssetToStartLoading;
 
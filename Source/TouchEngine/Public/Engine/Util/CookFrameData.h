@@ -84,6 +84,20 @@ namespace UE::TouchEngine
 		double TECookStartTime = 0.0;
 		/** The end_time returned by the TEInstanceEventCallback for this TE Cook. */
 		double TECookEndTime = 0.0;
+		/** When TEInstanceStartFrameAtTime was called for this cook, in seconds since GStartTime. 0 if the cook was never started. */
+		double CookStartedTime = 0.0;
+		/** When TouchEngine let us know this cook was done, in seconds since GStartTime. 0 if TouchEngine never answered. */
+		double CookFinishedTime = 0.0;
+
+		/**
+		 * The number of TouchEngine frames between the previous frame TouchEngine delivered and this one which we never received, found from the gap between their TE start and end times.
+		 * The frames TouchEngine was expected to skip because less than one cook was requested per TouchEngine frame are not counted.
+		 */
+		int32 NumFramesDropped = 0;
+		/** 1 if TouchEngine answered this cook with a frame it had already delivered, either because it did not process it (bWasFrameDropped) or because its TE times overlap the previous frame. */
+		int32 NumFramesDuplicated = 0;
+		/** The number of cooks requested between the previous frame TouchEngine delivered and this one which were never delivered (discarded, cancelled, timed out or failed), found from their FrameIDs. */
+		int32 NumFramesDiscarded = 0;
 
 
 		static FCookFrameResult FromCookFrameRequest(const FCookFrameRequest& CookRequest, ECookFrameResult ErrorCode, int64 FrameLastUpdated, TEResult TouchEngineInternalResult)
@@ -15,7 +15,6 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "Containers/Queue.h"
 #include "Logging/MessageLog.h"
 #include "TouchEngine/TEResult.h"
 #include "TouchEngine/TouchObject.h"
@@ -70,6 +69,7 @@ namespace UE::TouchEngine
 			TEResult Result;
 			FName FunctionName;
 			FString VarName;
+			/** Empty for the coded errors, whose message is built from the ErrorCode when they are output. See GetLogMessage */
 			FString Message;
 			FString AdditionalDescription;
 			bool operator==(const FLogData& Other) const
@@ -100,12 +100,31 @@ namespace UE::TouchEngine
 		static FMessageLog CreateMessageLog();
 		bool bWasLogOpened = false;
 
-		TQueue<FLogData, EQueueMode::Mpsc> PendingMessages;
+		/** How many times an error was triggered, and how many of those were already output */
+		struct FLogEntry
+		{
+			int32 Count = 0;
+			int32 CountAtLastOutput = 0;
+			double LastOutputTime = 0.0;
+			/** True if the error was triggered outside the GameThread and still needs to be output by OutputMessages_GameThread */
+			bool bOutputPending = false;
+		};
 
-		/** List of errors already triggered to not trigger them again */
-		TSet<FLogData> TriggeredErrors;
+		FCriticalSection LogEntriesLock;
+		/** The errors already triggered, coalesced by FLogData::operator==. Bounded by TouchEngine.ErrorLog.MaxDistinctErrors */
+		TMap<FLogData, FLogEntry> LogEntries;
+		/** True if some entries have bOutputPending set */
+		bool bHasPendingOutput = false;
+		/** The time after which OutputMessages_GameThread will look for repeated errors to report */
+		double NextRepeatCheckTime = 0.0;
+		/** The number of distinct errors which were not recorded because LogEntries was full */
+		int32 NumDroppedLogs = 0;
+		int32 NumDroppedLogsReported = 0;
 
-		void AddLog(const FLogData& LogData);
-		void OutputLogData_GameThread(const FLogData& LogData);
+		void AddLog(FLogData&& LogData);
+		/** Outputs the error. If NumRepeats is above 0, this is a reminder that the error occurred NumRepeats more times during the last RepeatPeriod seconds */
+		void OutputLogData_GameThread(const FLogData& LogData, int32 NumRepeats = 0, double RepeatPeriod = 0.0);
+		/** Builds the message of the error. The messages of the coded errors are only built here, when they are output */
+		static FString GetLogMessage(const FLogData& LogData);
 	};
 }
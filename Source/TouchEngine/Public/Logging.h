@@ -19,3 +19,40 @@
 
 DEFINE_LOG_CATEGORY_STATIC(LogTouchEngine, Display, All)
 DEFINE_LOG_CATEGORY_STATIC(LogTouchEngineTECalls, Error, All)
+/** Per-frame diagnostics of the cook pipeline. Only logged through UE_LOG_TOUCHENGINE_HOT_PATH, when TouchEngine.Log.HotPath is set */
+DEFINE_LOG_CATEGORY_STATIC(LogTouchEngineHotPath, Log, All)
+
+/**
+ * If 0, UE_LOG_TOUCHENGINE_HOT_PATH and UE_CLOG_TOUCHENGINE_HOT_PATH compile to nothing, including the evaluation of their arguments.
+ * Defaults to 0 in Shipping and Test builds.
+ */
+#ifndef WITH_TOUCHENGINE_HOT_PATH_LOG
+	#define WITH_TOUCHENGINE_HOT_PATH_LOG (!UE_BUILD_SHIPPING && !UE_BUILD_TEST && !NO_LOGGING)
+#endif
+
+#if WITH_TOUCHENGINE_HOT_PATH_LOG
+namespace UE::TouchEngine
+{
+	/** Set by TouchEngine.Log.HotPath. Checked before anything is formatted so the disabled hot path logs only cost a branch */
+	extern TOUCHENGINE_API bool GEnableHotPathLog;
+}
+
+/** Logs to LogTouchEngineHotPath. To be used for the messages logged for every cook, every parameter or every texture */
+#define UE_LOG_TOUCHENGINE_HOT_PATH(Verbosity, Format, ...) \
+	{ \
+		if (UE::TouchEngine::GEnableHotPathLog) \
+		{ \
+			UE_LOG(LogTouchEngineHotPath, Verbosity, Format, ##__VA_ARGS__); \
+		} \
+	}
+#define UE_CLOG_TOUCHENGINE_HOT_PATH(Condition, Verbosity, Format, ...) \
+	{ \
+		if (UE::TouchEngine::GEnableHotPathLog) \
+		{ \
+			UE_CLOG(Condition, LogTouchEngineHotPath, Verbosity, Format, ##__VA_ARGS__); \
+		} \
+	}
+#else
+#define UE_LOG_TOUCHENGINE_HOT_PATH(Verbosity, Format, ...) {}
+#define UE_CLOG_TOUCHENGINE_HOT_PATH(Condition, Verbosity, Format, ...) {}
+#endif
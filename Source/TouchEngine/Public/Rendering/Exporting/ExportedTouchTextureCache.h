@@ -15,17 +15,69 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "RenderUtils.h"
 #include "TouchExportParams.h"
 #include "TouchTextureExporter.h"
+#include "Blueprint/TouchEngineTextureDescriptor.h"
 #include "Engine/TEDebug.h"
 #include "Rendering/TouchResourceProvider.h"
 #include "Util/TouchEngineStatsGroup.h"
 #include "Util/TouchHelpers.h"
+#include "Util/TouchTexturePoolCounters.h"
+#include "Util/TouchTexturePoolSizer.h"
 #include "TouchEngine/Public/Logging.h"
 
 
 namespace UE::TouchEngine
 {
+	/** Describes the RHI textures an exported texture can hold. The export pool is bucketed by this descriptor. */
+	struct FTouchExportTextureDescriptor
+	{
+		FIntPoint Size = FIntPoint::ZeroValue;
+		EPixelFormat PixelFormat = PF_Unknown;
+		int32 NumMips = 0;
+		int32 NumSamples = 0;
+		bool bIsSRGB = false;
+
+		FTouchExportTextureDescriptor() = default;
+		explicit FTouchExportTextureDescriptor(const FRHITexture* Texture)
+		{
+			if (Texture)
+			{
+				const FRHITextureDesc& Desc = Texture->GetDesc();
+				Size = Desc.Extent;
+				PixelFormat = Desc.Format;
+				NumMips = Desc.NumMips;
+				NumSamples = Desc.NumSamples;
+				bIsSRGB = EnumHasAnyFlags(Desc.Flags, ETextureCreateFlags::SRGB);
+			}
+		}
+
+		/** The GPU memory a texture matching this descriptor takes */
+		int64 GetSizeInBytes() const
+		{
+			return PixelFormat != PF_Unknown ? static_cast<int64>(CalcTextureSize(Size.X, Size.Y, PixelFormat, FMath::Max(NumMips, 1))) * FMath::Max(NumSamples, 1) : 0;
+		}
+
+		bool operator==(const FTouchExportTextureDescriptor& Other) const
+		{
+			return Size == Other.Size
+				&& PixelFormat == Other.PixelFormat
+				&& NumMips == Other.NumMips
+				&& NumSamples == Other.NumSamples
+				&& bIsSRGB == Other.bIsSRGB;
+		}
+		bool operator!=(const FTouchExportTextureDescriptor& Other) const { return !(*this == Other); }
+
+		friend uint32 GetTypeHash(const FTouchExportTextureDescriptor& Descriptor)
+		{
+			uint32 Hash = HashCombine(GetTypeHash(Descriptor.Size), GetTypeHash(static_cast<int32>(Descriptor.PixelFormat)));
+			Hash = HashCombine(Hash, GetTypeHash(Descriptor.NumMips));
+			Hash = HashCombine(Hash, GetTypeHash(Descriptor.NumSamples));
+			return HashCombine(Hash, GetTypeHash(Descriptor.bIsSRGB));
+		}
+	};
+	
 	/**
 	 * Keeps track of textures that are being or have been exported from Unreal to TouchEngine.
 	 * 
@@ -33,7 +85,8 @@ namespace UE::TouchEngine
 	 * after the shared texture are no longer needed, they can only be released after TE has stopped using them.
 	 *
 	 * Subclasses must implement:
-	 *  - TSharedPtr<TExportedTouchTexture> CreateTexture(const FTextureCreationArgs& Params)
+	 *  - TSharedPtr<TExportedTouchTexture> CreateTexture(const FTouchExportParameters& Params, const FTouchExportTextureDescriptor& Descriptor)
+	 *    which creates a texture matching the descriptor. Params.Texture is null when the texture is created to prewarm the pool
 	 */
 	template<typename TExportedTouchTexture, typename TCrtp>
 	class TExportedTouchTextureCache
@@ -48,6 +101,9 @@ namespace UE::TouchEngine
 			TSharedPtr<TExportedTouchTexture> ExportedPlatformTexture;
 			TSet<FName> ParametersInUsage;
 			int64 FrameCreated; //The frame ID at which this texture was created
+			FTouchExportTextureDescriptor Descriptor; //The descriptor of the texture this was created for, used as the key of its bucket in the TexturePool
+			uint64 PooledOrder = 0; //Incremented each time a texture is added to the pool, used to evict the textures which have been in the pool the longest
+			int64 SizeInBytes = 0; //The GPU memory taken by this texture, counted against the PoolBudgetBytes
 
 			bool IsExportedPlatformTextureHealthy()
 			{
@@ -57,6 +113,18 @@ namespace UE::TouchEngine
 		
 	public:
 		int32 PoolSize = 20;
+		/** The maximum GPU memory, in bytes, the textures of the pool can take. 0 means the pool is only bounded by PoolSize */
+		int64 PoolBudgetBytes = 0;
+
+		/**
+		 * When enabled, the pool is trimmed to the number of textures actually needed over the last frames instead of PoolSize,
+		 * which then only acts as an upper bound. The pool never goes below MinPoolSize.
+		 */
+		void SetAdaptivePoolSize(bool bEnabled, int32 MinPoolSize)
+		{
+			FScopeLock Lock(&PooledTextureMutex);
+			PoolSizer.SetEnabled(bEnabled, MinPoolSize);
+		}
 		
 		virtual ~TExportedTouchTextureCache()
 		{
@@ -72,7 +140,7 @@ namespace UE::TouchEngine
 			check(Params.Texture)
 			
 			FScopeLock Lock(&PooledTextureMutex);
-			UE_LOG(LogTemp, Verbose, TEXT("[TExportedTouchTextureCache::GetOrCreateTexture] for param `%s` and texture `%s`"), *Params.ParameterName.ToString(), *GetNameSafe(Params.Texture));
+			UE_LOG_TOUCHENGINE_HOT_PATH(Verbose, TEXT("[TExportedTouchTextureCache::GetOrCreateTexture] for param `%s` and texture `%s`"), *Params.ParameterName.ToString(), *GetNameSafe(Params.Texture));
 
 			// // 1. we check if we have sent the same texture for the same parameter
 			FTextureRHIRef ParamTextureRHI = FTouchResourceProvider::GetStableRHIFromTexture(Params.Texture);
@@ -93,7 +161,7 @@ namespace UE::TouchEngine
 						// If another texture exported it this frame, we can just reuse it,
 						// otherwise the texture from a previous cook is still in use, so we need to create a new one
 						check(TextureData->ExportedPlatformTexture)
-						UE_LOG(LogTemp, Verbose, TEXT("[TExportedTouchTextureCache::GetNextOrAllocPooledTexture] Reusing existing texture for param `%s` and texture `%s`"), *Params.ParameterName.ToString(), *GetNameSafe(Params.Texture));
+						UE_LOG_TOUCHENGINE_HOT_PATH(Verbose, TEXT("[TExportedTouchTextureCache::GetNextOrAllocPooledTexture] Reusing existing texture for param `%s` and texture `%s`"), *Params.ParameterName.ToString(), *GetNameSafe(Params.Texture));
 						bTextureNeedsCopy = TextureData->ParametersInUsage.IsEmpty(); // if other parameters are using this texture, they are already taking care of the copy
 						TextureData->ParametersInUsage.Add(Params.ParameterName);
 						bIsNewTexture = false;
@@ -110,10 +178,14 @@ namespace UE::TouchEngine
 			}
 
 			bTextureNeedsCopy = true;
+			RecordPoolRequest(FTouchExportTextureDescriptor(ParamTextureRHI), Params.FrameData.FrameID);
 			
 			// 4. if we have an existing pool, try to get it from there
 			if (TSharedPtr<FTextureData> TextureData = FindSuitableTextureFromPool(Params, ParamTextureRHI))
 			{
+				INC_DWORD_STAT(STAT_TE_ExportedTexturePool_Hits)
+				PoolSizer.RecordRequest(true);
+				++PoolCounters.Hits;
 				check(!TextureData->ExportedPlatformTexture->IsInUseByTouchEngine())
 				bIsNewTexture = false;
 				TextureData->ExportedPlatformTexture->SetStableRHIOfTextureToCopy(MoveTemp(ParamTextureRHI));
@@ -121,28 +193,30 @@ namespace UE::TouchEngine
 			}
 
 			//5. Otherwise, we just create a new one
+			INC_DWORD_STAT(STAT_TE_ExportedTexturePool_Misses)
+			PoolSizer.RecordRequest(false);
+			++PoolCounters.Misses;
 			bIsNewTexture = true;
 			return ShareTexture(Params, MoveTemp(ParamTextureRHI))->ExportedPlatformTexture; 
 		}
 
 		void TexturePoolMaintenance()
 		{
-			TArray<TSharedPtr<FTextureData>> TexturesToPool;
-			TArray<TSharedPtr<FTextureData>> TexturesToWait;
-			TArray<TSharedPtr<FTextureData>> TexturesToRelease;
+			TSet<TSharedPtr<FTextureData>> TexturesToPool;
+			TSet<TSharedPtr<FTextureData>> TexturesToWait;
+			TSet<TSharedPtr<FTextureData>> TexturesToRelease;
 
 			// 1.  we check the CachedTextureData which holds the recent textures exported
-			TArray<UTexture*> Keys;
-			CachedTextureData.GenerateKeyArray(Keys);
-			for (UTexture* Key : Keys)
+			for (typename TMap<UTexture*, TSharedPtr<FTextureData>>::TIterator It = CachedTextureData.CreateIterator(); It; ++It)
 			{
-				if (!ensure(Key)) // if the key is null for some reason
+				if (!ensure(It.Key())) // if the key is null for some reason
 				{
-					TexturesToRelease.AddUnique(CachedTextureData.FindAndRemoveChecked(Key));
+					TexturesToRelease.Add(It.Value());
+					It.RemoveCurrent();
 					continue;
 				}
 
-				TSharedPtr<FTextureData>& TextureData = CachedTextureData[Key];
+				TSharedPtr<FTextureData>& TextureData = It.Value();
 				if (ensure(TextureData && TextureData->IsExportedPlatformTextureHealthy()))
 				{
 					if (TextureData->ParametersInUsage.IsEmpty()) // if we processed all the parameters and none are using this texture
@@ -150,12 +224,13 @@ namespace UE::TouchEngine
 						TextureData->UETexture = nullptr;
 						if (TextureData->ExportedPlatformTexture->IsInUseByTouchEngine())
 						{
-							TexturesToWait.AddUnique(CachedTextureData.FindAndRemoveChecked(Key)); // if it is still in use, we cannot reuse it right away.
+							TexturesToWait.Add(TextureData); // if it is still in use, we cannot reuse it right away.
 						}
 						else
 						{
-							TexturesToPool.AddUnique(CachedTextureData.FindAndRemoveChecked(Key)); // otherwise we'll add it to the pool
+							TexturesToPool.Add(TextureData); // otherwise we'll add it to the pool
 						}
+						It.RemoveCurrent();
 					}
 					else
 					{
@@ -165,60 +240,163 @@ namespace UE::TouchEngine
 				else
 				{
 					// this is not supposed to happen, but now that we have a pool, lifetime of the texture could be different so to be sure
-					TexturesToRelease.AddUnique(CachedTextureData.FindAndRemoveChecked(Key));
+					TexturesToRelease.Add(TextureData);
+					It.RemoveCurrent();
 				}
 			}
 
 			// 2. Then we ensure our pool is healthy
-			for (int i = 0; i < TexturePool.Num(); ++i)
+			for (typename TMap<FTouchExportTextureDescriptor, TArray<TSharedPtr<FTextureData>>>::TIterator It = TexturePool.CreateIterator(); It; ++It)
 			{
-				TSharedPtr<FTextureData>& TextureData = TexturePool[i];
-				if (!ensure(TextureData && TextureData->IsExportedPlatformTextureHealthy()))
+				TArray<TSharedPtr<FTextureData>>& Bucket = It.Value();
+				for (int i = 0; i < Bucket.Num(); ++i)
 				{
-					TexturesToRelease.AddUnique(TextureData);
-					TexturePool.RemoveAt(i);
-					--i;
+					TSharedPtr<FTextureData>& TextureData = Bucket[i];
+					if (!ensure(TextureData && TextureData->IsExportedPlatformTextureHealthy()))
+					{
+						TexturesToRelease.Add(RemoveTextureFromBucket(Bucket, i));
+						--i;
+					}
+				}
+				if (Bucket.IsEmpty())
+				{
+					It.RemoveCurrent();
 				}
 			}
 
 			// 3. Check if the textures are still in use by TouchEngine and add the new ones
-			for (int i = 0; i < FutureTexturesToPool.Num(); ++i)
+			for (typename TSet<TSharedPtr<FTextureData>>::TIterator It = FutureTexturesToPool.CreateIterator(); It; ++It)
 			{
-				TSharedPtr<FTextureData>& TextureData = FutureTexturesToPool[i];
+				TSharedPtr<FTextureData>& TextureData = *It;
 				if (ensure(TextureData && TextureData->IsExportedPlatformTextureHealthy()))
 				{
 					if (!TextureData->ExportedPlatformTexture->IsInUseByTouchEngine()) // if freed up, we can add it to the Pool
 					{
-						TexturesToPool.AddUnique(TextureData);
-						FutureTexturesToPool.RemoveAt(i);
-						--i;
+						TexturesToPool.Add(TextureData);
+						It.RemoveCurrent();
 					}
 				}
 				else
 				{
-					TexturesToRelease.AddUnique(TextureData);
-					FutureTexturesToPool.RemoveAt(i);
-					--i;
+					TexturesToRelease.Add(TextureData);
+					It.RemoveCurrent();
 				}
 			}
 			FutureTexturesToPool.Append(TexturesToWait);
 			
 			// 4. We add to the pool the ones that can be added and we ensure the pool is not too big
-			TexturePool.Append(TexturesToPool);
-			while (TexturePool.Num() > PoolSize)
+			for (const TSharedPtr<FTextureData>& TextureData : TexturesToPool)
+			{
+				TextureData->PooledOrder = NextPooledOrder++;
+				TexturePool.FindOrAdd(TextureData->Descriptor).Add(TextureData);
+				++NumPooledTextures;
+				PooledBytes += TextureData->SizeInBytes;
+			}
+			int32 TargetPoolSize;
+			{
+				FScopeLock Lock(&PooledTextureMutex);
+				PoolSizer.RecordFrame(NumPooledTextures, PoolSize);
+				TargetPoolSize = PoolSizer.GetPoolSize(PoolSize);
+			}
+			while (NumPooledTextures > TargetPoolSize || (PoolBudgetBytes > 0 && PooledBytes > PoolBudgetBytes))
 			{
-				TexturesToRelease.AddUnique(TexturePool[0]); // we remove from the front as they have been here the longest
-				TexturePool.RemoveAt(0);
+				// we remove the textures which have been unused the longest
+				TSharedPtr<FTextureData> TextureData = PopLeastRecentlyPooledTexture();
+				if (!TextureData)
+				{
+					break;
+				}
+				TexturesToRelease.Add(TextureData);
+				INC_DWORD_STAT(STAT_TE_ExportedTexturePool_Evictions)
+				++PoolCounters.Evictions;
 			}
 			
 			// 5. And finally we release the textures
-			for (TSharedPtr<FTextureData>& TextureData : TexturesToRelease)
+			for (const TSharedPtr<FTextureData>& TextureData : TexturesToRelease)
 			{
-				ReleaseTexture(TextureData->ExportedPlatformTexture);
+				if (TextureData)
+				{
+					ReleaseTexture(TextureData->ExportedPlatformTexture);
+				}
+			}
+
+			UpdatePoolStats(TargetPoolSize);
+		}
+		/** Creates textures matching the given descriptors and adds them to the pool, so the first cooks do not need to create them */
+		void PrewarmPool(const TArray<FTouchEngineTextureDescriptor>& Descriptors)
+		{
+			FScopeLock Lock(&PooledTextureMutex);
+			for (const FTouchEngineTextureDescriptor& Descriptor : Descriptors)
+			{
+				if (Descriptor.SizeX <= 0 || Descriptor.SizeY <= 0 || Descriptor.PixelFormat == PF_Unknown || Descriptor.Count <= 0)
+				{
+					continue;
+				}
+
+				FTouchExportTextureDescriptor ExportDescriptor;
+				ExportDescriptor.Size = FIntPoint(Descriptor.SizeX, Descriptor.SizeY);
+				ExportDescriptor.PixelFormat = Descriptor.PixelFormat;
+				ExportDescriptor.NumMips = FMath::Max(Descriptor.NumMips, 1);
+				ExportDescriptor.NumSamples = 1;
+				ExportDescriptor.bIsSRGB = Descriptor.bIsSRGB;
+				
+				FTouchExportParameters Params;
+				Params.ParameterName = TEXT("Prewarm");
+				for (int32 i = 0; i < Descriptor.Count; ++i)
+				{
+					TSharedPtr<TExportedTouchTexture> ExportedTexture = This()->CreateTexture(Params, ExportDescriptor);
+					if (!ensure(ExportedTexture))
+					{
+						break;
+					}
+					INC_DWORD_STAT(STAT_TE_ExportedTexturePool_NbTexturesTotal)
+					ExportedTexture->DebugName = FString::Printf(TEXT("Prewarm__%dx%d__%s__%d"), Descriptor.SizeX, Descriptor.SizeY, GetPixelFormatString(Descriptor.PixelFormat), i);
+					TSharedPtr<FTextureData> TextureData = MakeShared<FTextureData>();
+					TextureData->DebugName = ExportedTexture->DebugName;
+					TextureData->UETexture = nullptr;
+					TextureData->ExportedPlatformTexture = ExportedTexture;
+					TextureData->FrameCreated = -1;
+					TextureData->Descriptor = ExportDescriptor;
+					TextureData->SizeInBytes = TextureData->Descriptor.GetSizeInBytes();
+					TextureData->PooledOrder = NextPooledOrder++;
+					
+					TexturePool.FindOrAdd(TextureData->Descriptor).Add(TextureData);
+					++NumPooledTextures;
+					PooledBytes += TextureData->SizeInBytes;
+				}
 			}
+			UpdatePoolStats(PoolSizer.GetPoolSize(PoolSize)); // PooledTextureMutex is held for the whole function
+		}
+
+		/** Returns what the pool did since this cache was created */
+		FTouchTexturePoolCounters GetPoolCounters()
+		{
+			FScopeLock Lock(&PooledTextureMutex);
+			FTouchTexturePoolCounters Counters = PoolCounters;
+			Counters.NumPooledTextures = NumPooledTextures;
+			Counters.NumBuckets = TexturePool.Num();
+			return Counters;
+		}
 
-			SET_DWORD_STAT(STAT_TE_ExportedTexturePool_NbTexturesPool, TexturePool.Num())
+		/** Returns the descriptors of the textures exported so far, with the number of textures needed to export them without having to create new ones */
+		TArray<FTouchEngineTextureDescriptor> GetObservedDescriptors()
+		{
+			FScopeLock Lock(&PooledTextureMutex);
+			TArray<FTouchEngineTextureDescriptor> Descriptors;
+			for (const TPair<FTouchExportTextureDescriptor, FObservedDescriptorUsage>& Observed : ObservedDescriptors)
+			{
+				FTouchEngineTextureDescriptor& Descriptor = Descriptors.AddDefaulted_GetRef();
+				Descriptor.SizeX = Observed.Key.Size.X;
+				Descriptor.SizeY = Observed.Key.Size.Y;
+				Descriptor.PixelFormat = Observed.Key.PixelFormat;
+				Descriptor.NumMips = Observed.Key.NumMips;
+				Descriptor.bIsSRGB = Observed.Key.bIsSRGB;
+				// TouchEngine can still be using the textures of the previous cook while we export the next ones, so we need two textures per request
+				Descriptor.Count = Observed.Value.PeakRequestsPerFrame * 2;
+			}
+			return Descriptors;
 		}
+		
 		/** Waits for TouchEngine to release the textures and then proceeds to destroy them. */
 		TFuture<FTouchSuspendResult> ReleaseTextures()
 		{
@@ -233,21 +411,25 @@ namespace UE::TouchEngine
 			CachedTextureData.Empty();
 			check(CachedTextureData.IsEmpty());
 			
-			while(!FutureTexturesToPool.IsEmpty())
+			for (const TSharedPtr<FTextureData>& TextureData : FutureTexturesToPool)
 			{
-				TSharedPtr<FTextureData> TextureData = FutureTexturesToPool.Pop();
 				ReleaseTexture(TextureData->ExportedPlatformTexture);
 				TextureData->ExportedPlatformTexture.Reset();
 			}
-			check(FutureTexturesToPool.IsEmpty());
+			FutureTexturesToPool.Empty();
 			
-			while(!TexturePool.IsEmpty())
+			for (TPair<FTouchExportTextureDescriptor, TArray<TSharedPtr<FTextureData>>>& Bucket : TexturePool)
 			{
-				TSharedPtr<FTextureData> TextureData = TexturePool.Pop();
-				ReleaseTexture(TextureData->ExportedPlatformTexture);
-				TextureData->ExportedPlatformTexture.Reset();
+				for (const TSharedPtr<FTextureData>& TextureData : Bucket.Value)
+				{
+					ReleaseTexture(TextureData->ExportedPlatformTexture);
+					TextureData->ExportedPlatformTexture.Reset();
+				}
 			}
-			check(TexturePool.IsEmpty());
+			TexturePool.Empty();
+			NumPooledTextures = 0;
+			PooledBytes = 0;
+			UpdatePoolStats(0); // removes this pool from the stats
 			
 			TPromise<FTouchSuspendResult> Promise;
 			TFuture<FTouchSuspendResult> Future = Promise.GetFuture();
@@ -280,9 +462,9 @@ namespace UE::TouchEngine
 					TextureData->ParametersInUsage.Remove(Params.ParameterName);
 					if (TextureData->ParametersInUsage.IsEmpty())
 					{
-						UE_LOG(LogTouchEngine, Log, TEXT("FExportedTouchTexture::ForceReturnTextureToPool called for Texture %s : %s"), *ExportedTexture->DebugName, *Params.GetDebugDescription())
+						UE_LOG_TOUCHENGINE_HOT_PATH(Log, TEXT("FExportedTouchTexture::ForceReturnTextureToPool called for Texture %s : %s"), *ExportedTexture->DebugName, *Params.GetDebugDescription())
 						TextureData->ExportedPlatformTexture->ClearStableRHI();
-						FutureTexturesToPool.AddUnique(CachedTextureData.FindAndRemoveChecked(Params.Texture));
+						FutureTexturesToPool.Add(CachedTextureData.FindAndRemoveChecked(Params.Texture));
 						return true;
 					}
 				}
@@ -308,7 +490,7 @@ namespace UE::TouchEngine
 				}
 			}
 			
-			UE_LOG(LogTouchEngine, Log, TEXT("[ExportTextureToTE_AnyThread[%s]] GetOrCreateTexture returned %s `%s` (%sneeding a copy). %s"),
+			UE_LOG_TOUCHENGINE_HOT_PATH(Log, TEXT("[ExportTextureToTE_AnyThread[%s]] GetOrCreateTexture returned %s `%s` (%sneeding a copy). %s"),
 			       *GetCurrentThreadStr(), bIsNewTexture ? TEXT("a NEW texture") : TEXT("the EXISTING texture"),
 			       bTextureNeedsCopy ? TEXT("") : TEXT("NOT "),
 			       *ExportedTexture->DebugName, *ParamsConst.GetDebugDescription());
@@ -318,7 +500,7 @@ namespace UE::TouchEngine
 			// 2.a If we don't need to copy because the copy is already enqueued by another parameter, return early...
 			if (!bTextureNeedsCopy) // if the texture is already ready
 			{
-				UE_LOG(LogTouchEngine, Log, TEXT("[ExportTextureToTE_AnyThread[%s]] Reusing existing texture as it was already used by other parameters. %s"),
+				UE_LOG_TOUCHENGINE_HOT_PATH(Log, TEXT("[ExportTextureToTE_AnyThread[%s]] Reusing existing texture as it was already used by other parameters. %s"),
 					*GetCurrentThreadStr(), *ParamsConst.GetDebugDescription());
 				return TouchTexture;
 			}
@@ -376,7 +558,8 @@ namespace UE::TouchEngine
 		 */
 		TSharedPtr<FTextureData> ShareTexture(const FTouchExportParameters& Params, const FTextureRHIRef& ParamTextureRHI)
 		{
-			TSharedPtr<TExportedTouchTexture> ExportedTexture = This()->CreateTexture(Params, ParamTextureRHI);
+			const FTouchExportTextureDescriptor Descriptor(ParamTextureRHI);
+			TSharedPtr<TExportedTouchTexture> ExportedTexture = This()->CreateTexture(Params, Descriptor);
 			if (ensure(ExportedTexture))
 			{
 				INC_DWORD_STAT(STAT_TE_ExportedTexturePool_NbTexturesTotal)
@@ -388,6 +571,8 @@ namespace UE::TouchEngine
 				NewTextureData->ParametersInUsage = {Params.ParameterName};
 				NewTextureData->ExportedPlatformTexture->SetStableRHIOfTextureToCopy(ParamTextureRHI);
 				NewTextureData->FrameCreated = Params.FrameData.FrameID;
+				NewTextureData->Descriptor = Descriptor;
+				NewTextureData->SizeInBytes = NewTextureData->Descriptor.GetSizeInBytes();
 
 				if (!ensure(!CachedTextureData.Contains(Params.Texture)))
 				{
@@ -407,12 +592,24 @@ namespace UE::TouchEngine
 		 */
 		TSharedPtr<FTextureData> FindSuitableTextureFromPool(const FTouchExportParameters& Params, const FTextureRHIRef& ParamTextureRHI)
 		{
-			TSharedPtr<FTextureData> SuitableTextureFromPool;
+			const FTouchExportTextureDescriptor Descriptor(ParamTextureRHI);
+			TArray<TSharedPtr<FTextureData>>* Bucket = TexturePool.Find(Descriptor);
+			if (!Bucket)
+			{
+				return nullptr;
+			}
 			
-			for (TSharedPtr<FTextureData>& TextureData : TexturePool)
+			for (int i = 0; i < Bucket->Num(); ++i)
 			{
+				TSharedPtr<FTextureData> TextureData = (*Bucket)[i];
 				if (ensure(TextureData && TextureData->IsExportedPlatformTextureHealthy()) && !TextureData->ExportedPlatformTexture->IsInUseByTouchEngine() && TextureData->ExportedPlatformTexture->CanFitTexture(ParamTextureRHI))
 				{
+					RemoveTextureFromBucket(*Bucket, i);
+					if (Bucket->IsEmpty())
+					{
+						TexturePool.Remove(Descriptor); // the descriptors can vary a lot, for example while a texture is being resized, so we do not keep empty buckets around
+					}
+					
 					TextureData->ExportedPlatformTexture->DebugName = FString::Printf(TEXT("%s__frame%lld__%s"), *GetNameSafe(Params.Texture), Params.FrameData.FrameID, *Params.ParameterName.ToString());
 					TextureData->DebugName = GetNameSafe(Params.Texture);
 					TextureData->UETexture = Params.Texture;
@@ -424,17 +621,71 @@ namespace UE::TouchEngine
 						FutureTexturesToPool.Add(CachedTextureData.FindAndRemoveChecked(Params.Texture)); // just to be sure we keep track of this texture
 					}
 					CachedTextureData.Add(Params.Texture, TextureData);
+					return TextureData;
+				}
+			}
+			return nullptr;
+		}
 
-					SuitableTextureFromPool = TextureData;
-					break;
+		/**
+		 * Removes from the TexturePool the least recently used texture, which is the one that has been pooled the longest.
+		 * Each bucket is ordered from the oldest to the newest texture, so we only need to compare the front of each bucket
+		 */
+		TSharedPtr<FTextureData> PopLeastRecentlyPooledTexture()
+		{
+			TPair<FTouchExportTextureDescriptor, TArray<TSharedPtr<FTextureData>>>* OldestBucket = nullptr;
+			for (TPair<FTouchExportTextureDescriptor, TArray<TSharedPtr<FTextureData>>>& Bucket : TexturePool)
+			{
+				if (!Bucket.Value.IsEmpty() && (!OldestBucket || Bucket.Value[0]->PooledOrder < OldestBucket->Value[0]->PooledOrder))
+				{
+					OldestBucket = &Bucket;
 				}
 			}
+			if (!ensure(OldestBucket))
+			{
+				return nullptr;
+			}
 			
-			if (SuitableTextureFromPool)
+			TSharedPtr<FTextureData> TextureData = RemoveTextureFromBucket(OldestBucket->Value, 0);
+			if (OldestBucket->Value.IsEmpty())
 			{
-				TexturePool.Remove(SuitableTextureFromPool);
+				const FTouchExportTextureDescriptor Descriptor = OldestBucket->Key; // copied as the pair is destroyed while being removed
+				TexturePool.Remove(Descriptor);
 			}
-			return SuitableTextureFromPool;
+			return TextureData;
+		}
+
+		/** Updates the stats tracking the content of the pool. Each cache only adds its own changes so the stats sum the pools of all the instances */
+		void UpdatePoolStats(int32 TargetPoolSize)
+		{
+			DEC_DWORD_STAT_BY(STAT_TE_ExportedTexturePool_NbTexturesPool, ReportedNumPooledTextures)
+			DEC_DWORD_STAT_BY(STAT_TE_ExportedTexturePool_TargetSize, ReportedTargetPoolSize)
+			DEC_MEMORY_STAT_BY(STAT_TE_ExportedTexturePool_ResidentBytes, ReportedPooledBytes)
+			ReportedNumPooledTextures = NumPooledTextures;
+			ReportedTargetPoolSize = TargetPoolSize;
+			ReportedPooledBytes = PooledBytes;
+			INC_DWORD_STAT_BY(STAT_TE_ExportedTexturePool_NbTexturesPool, ReportedNumPooledTextures)
+			INC_DWORD_STAT_BY(STAT_TE_ExportedTexturePool_TargetSize, ReportedTargetPoolSize)
+			INC_MEMORY_STAT_BY(STAT_TE_ExportedTexturePool_ResidentBytes, ReportedPooledBytes)
+		}
+
+		/** Removes the texture at the given index of the bucket and updates the pool totals */
+		TSharedPtr<FTextureData> RemoveTextureFromBucket(TArray<TSharedPtr<FTextureData>>& Bucket, int32 Index)
+		{
+			TSharedPtr<FTextureData> TextureData = Bucket[Index];
+			Bucket.RemoveAt(Index);
+			--NumPooledTextures;
+			PooledBytes -= TextureData ? TextureData->SizeInBytes : 0;
+			return TextureData;
+		}
+
+		/** Keeps track of how many textures matching the descriptor are needed in a single frame, to be returned by GetObservedDescriptors */
+		void RecordPoolRequest(const FTouchExportTextureDescriptor& Descriptor, int64 FrameID)
+		{
+			FObservedDescriptorUsage& Usage = ObservedDescriptors.FindOrAdd(Descriptor);
+			Usage.NumRequestsThisFrame = Usage.LastRequestedFrameID == FrameID ? Usage.NumRequestsThisFrame + 1 : 1;
+			Usage.LastRequestedFrameID = FrameID;
+			Usage.PeakRequestsPerFrame = FMath::Max(Usage.PeakRequestsPerFrame, Usage.NumRequestsThisFrame);
 		}
 
 		/** Release the texture, ensuring it has been released by TouchEngine before we let it be destroyed */
@@ -456,10 +707,32 @@ namespace UE::TouchEngine
 		/** Associates UTexture objects with the resource shared with TE. */
 		TMap<UTexture*, TSharedPtr<FTextureData>> CachedTextureData;
 
-		/** The pool of available textures to be reused. Managed and trimmed in TexturePoolMaintenance */
-		TArray<TSharedPtr<FTextureData>> TexturePool;
+		/** The pool of available textures to be reused, bucketed by descriptor. A bucket is removed as soon as it is empty. Managed and trimmed in TexturePoolMaintenance */
+		TMap<FTouchExportTextureDescriptor, TArray<TSharedPtr<FTextureData>>> TexturePool;
+		/** The total number of textures across all the buckets of the TexturePool */
+		int32 NumPooledTextures = 0;
+		/** The total GPU memory taken by the textures of the TexturePool */
+		int64 PooledBytes = 0;
+		/** The PooledOrder to give to the next texture added to the TexturePool */
+		uint64 NextPooledOrder = 0;
+		/** What this pool last added to the stats, see UpdatePoolStats */
+		int32 ReportedNumPooledTextures = 0;
+		int32 ReportedTargetPoolSize = 0;
+		int64 ReportedPooledBytes = 0;
+		struct FObservedDescriptorUsage
+		{
+			int64 LastRequestedFrameID = -1;
+			int32 NumRequestsThisFrame = 0;
+			int32 PeakRequestsPerFrame = 0;
+		};
+		/** The usage of each descriptor requested from the pool, returned by GetObservedDescriptors */
+		TMap<FTouchExportTextureDescriptor, FObservedDescriptorUsage> ObservedDescriptors;
+		/** Computes the size the pool is trimmed to when the adaptive pool size is enabled */
+		FTouchTexturePoolSizer PoolSizer;
+		/** The hits, misses and evictions of the pool, returned by GetPoolCounters */
+		FTouchTexturePoolCounters PoolCounters;
 		/** The Texture Pool of textures not yet available for reuse. Their availability will be checked in TexturePoolMaintenance and they will be moved to the Texture Pool once ready */
-		TArray<TSharedPtr<FTextureData>> FutureTexturesToPool;
+		TSet<TSharedPtr<FTextureData>> FutureTexturesToPool;
 
 		/** Tracks the tasks of releasing textures. */
 		FTaskSuspender PendingTextureReleases;
@@ -0,0 +1,38 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace UE::TouchEngine
+{
+	class FTouchResourceProvider;
+	struct FResourceProviderInitArgs;
+}
+
+namespace UE::TouchEngine::Headless
+{
+	/** The name of the RHI used when running with -nullrhi, for which the headless resource provider is bound */
+	static constexpr const TCHAR* NullRHIName = TEXT("Null");
+	
+	/**
+	 * Creates a resource provider which does not need any GPU: the textures exported to TouchEngine are copied to host memory, and the textures imported
+	 * from TouchEngine are filled from host memory. No texture is actually shared with TouchEngine, the TOP inputs are set to null.
+	 * This allows running the cook, import and texture pool pipeline on machines without a GPU, for profiling and load testing.
+	 * The TouchEngine module is only allowed on Win64, so this is supported with the installed TouchEngine or the stand-in (see Source/ThirdParty/TouchEngineStandIn).
+	 * Running it on Linux is an opt-in setup: the stand-in must be built with its CMakeLists.txt and "Linux" added to the PlatformAllowList of the TouchEngine module.
+	 */
+	TOUCHENGINE_API TSharedPtr<FTouchResourceProvider> MakeHeadlessResourceProvider(const FResourceProviderInitArgs& InitArgs);
+}
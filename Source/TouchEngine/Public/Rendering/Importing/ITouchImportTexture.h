@@ -22,6 +22,7 @@
 
 #include "Async/Future.h"
 #include "PixelFormat.h"
+#include "RenderUtils.h"
 #include "Engine/Texture.h"
 #include "Engine/Texture2D.h"
 
@@ -43,7 +44,65 @@ namespace UE::TouchEngine
 		EPixelFormat PixelFormat;
 		bool IsSRGB;
 	};
-	
+
+	/** Describes which imported UTexture2D can receive a TouchEngine texture. The import pool is bucketed by this descriptor. */
+	struct FTouchImportTextureDescriptor
+	{
+		uint32 SizeX = 0;
+		uint32 SizeY = 0;
+		EPixelFormat PixelFormat = PF_Unknown;
+		/** The imported textures are created by UTexture2D::CreateTransient which only creates one mip */
+		int32 NumMips = 1;
+		bool IsSRGB = false;
+
+		FTouchImportTextureDescriptor() = default;
+		explicit FTouchImportTextureDescriptor(const FTextureMetaData& MetaData)
+			: SizeX(MetaData.SizeX)
+			, SizeY(MetaData.SizeY)
+			, PixelFormat(MetaData.PixelFormat)
+			, IsSRGB(MetaData.IsSRGB)
+		{}
+
+		/** Reads the descriptor from the platform data of the texture, which does not require its RHI to be initialised */
+		static FTouchImportTextureDescriptor FromTexture(const UTexture2D* Texture)
+		{
+			FTouchImportTextureDescriptor Descriptor;
+			if (IsValid(Texture) && Texture->GetPlatformData())
+			{
+				Descriptor.SizeX = Texture->GetSizeX();
+				Descriptor.SizeY = Texture->GetSizeY();
+				Descriptor.PixelFormat = Texture->GetPixelFormat();
+				Descriptor.NumMips = Texture->GetNumMips();
+				Descriptor.IsSRGB = Texture->SRGB;
+			}
+			return Descriptor;
+		}
+
+		/** The GPU memory a texture matching this descriptor takes */
+		int64 GetSizeInBytes() const
+		{
+			return PixelFormat != PF_Unknown ? static_cast<int64>(CalcTextureSize(SizeX, SizeY, PixelFormat, FMath::Max(NumMips, 1))) : 0;
+		}
+
+		bool operator==(const FTouchImportTextureDescriptor& Other) const
+		{
+			return SizeX == Other.SizeX
+				&& SizeY == Other.SizeY
+				&& PixelFormat == Other.PixelFormat
+				&& NumMips == Other.NumMips
+				&& IsSRGB == Other.IsSRGB;
+		}
+		bool operator!=(const FTouchImportTextureDescriptor& Other) const { return !(*this == Other); }
+
+		friend uint32 GetTypeHash(const FTouchImportTextureDescriptor& Descriptor)
+		{
+			uint32 Hash = HashCombine(GetTypeHash(Descriptor.SizeX), GetTypeHash(Descriptor.SizeY));
+			Hash = HashCombine(Hash, GetTypeHash(static_cast<int32>(Descriptor.PixelFormat)));
+			Hash = HashCombine(Hash, GetTypeHash(Descriptor.NumMips));
+			return HashCombine(Hash, GetTypeHash(Descriptor.IsSRGB));
+		}
+	};
+
 	enum class ECopyTouchToUnrealResult
 	{
 		Success,
@@ -72,7 +131,10 @@ namespace UE::TouchEngine
 		
 		virtual ECopyTouchToUnrealResult CopyNativeToUnrealRHI_RenderThread(const FTouchCopyTextureArgs& CopyArgs, TSharedRef<FTouchTextureImporter> Importer) = 0;
 
-		/** Check if the internal semaphore for the end of the copy has been signaled, which would mean that this texture can be safely deleted */
-		virtual bool IsCurrentCopyDone() = 0;
+		/**
+		 * Executes the callback once the GPU is done with the copy enqueued by the last call to CopyNativeToUnrealRHI_RenderThread, which means that this texture can be safely deleted.
+		 * To be called on the render thread right after the copy has been enqueued. The callback can be executed on any thread, and it is also executed if the wait times out.
+		 */
+		virtual void OnCurrentCopyDone_RenderThread(FRHICommandListImmediate& RHICmdList, TUniqueFunction<void()>&& Callback) = 0;
 	};
 }
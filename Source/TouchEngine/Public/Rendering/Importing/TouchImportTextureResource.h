@@ -0,0 +1,61 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ITouchImportTexture.h"
+#include "TextureResource.h"
+
+class UTexture2D;
+
+namespace UE::TouchEngine
+{
+	/**
+	 * The resource of the UTexture2D receiving the imported TouchEngine textures.
+	 * Contrary to the resource created by UTexture2D::UpdateResource, it does not need any mip data and can be set from any thread:
+	 * the RHI texture is created on the render thread in InitRHI, where the texture reference of the UTexture2D is also created and pointed to it.
+	 */
+	class TOUCHENGINE_API FTouchImportTextureResource : public FTextureResource
+	{
+	public:
+		FTouchImportTextureResource(const FTouchImportTextureDescriptor& InDescriptor, FTextureReference& InTextureReference)
+			: Descriptor(InDescriptor)
+			, TextureReference(InTextureReference)
+		{
+			bSRGB = InDescriptor.IsSRGB;
+		}
+
+		/**
+		 * Creates a transient UTexture2D matching the given descriptor, with a FTouchImportTextureResource as resource. Can be called from any thread.
+		 * The UTexture2D is rooted and its RHI will be ready for any render command enqueued after this call.
+		 */
+		static UTexture2D* CreateTexture_AnyThread(const FTouchImportTextureDescriptor& Descriptor);
+
+		//~ Begin FRenderResource Interface
+		virtual void InitRHI(FRHICommandListBase& RHICmdList) override;
+		virtual void ReleaseRHI() override;
+		//~ End FRenderResource Interface
+
+		//~ Begin FTextureResource Interface
+		virtual uint32 GetSizeX() const override { return Descriptor.SizeX; }
+		virtual uint32 GetSizeY() const override { return Descriptor.SizeY; }
+		//~ End FTextureResource Interface
+
+	private:
+		FTouchImportTextureDescriptor Descriptor;
+		/** The TextureReference of the UTexture2D owning this resource, which outlives it */
+		FTextureReference& TextureReference;
+	};
+}
@@ -41,8 +41,11 @@ namespace UE::TouchEngine
 		virtual bool AcquireMutex(const FTouchCopyTextureArgs& CopyArgs, const TouchObject<TESemaphore>& Semaphore, uint64 WaitValue) = 0;
 		/** Gets the texture while the mutex is acquired. */
 		virtual FTexture2DRHIRef ReadTextureDuringMutex() = 0;
-		/** Releases the mutex. If this is a CPU mutex, this may block. If executed on the GPU, it is enqueued here. */
-		virtual void ReleaseMutex_RenderThread(const FTouchCopyTextureArgs& CopyArgs, const TouchObject<TESemaphore>& Semaphore, FTexture2DRHIRef& SourceTexture) = 0;
+		/**
+		 * Releases the mutex. If this is a CPU mutex, this may block. If executed on the GPU, it is enqueued here.
+		 * Implementations giving the texture back with their own unique semaphore value should report it with FTouchTextureImporter::OnTextureTransferReturned_AnyThread.
+		 */
+		virtual void ReleaseMutex_RenderThread(const FTouchCopyTextureArgs& CopyArgs, const TouchObject<TESemaphore>& Semaphore, FTexture2DRHIRef& SourceTexture, const TSharedRef<FTouchTextureImporter>& Importer) = 0;
 		virtual void CopyTexture_RenderThread(FRHICommandListImmediate& RHICmdList, const FTexture2DRHIRef SrcTexture, const FTexture2DRHIRef DstTexture, TSharedRef<FTouchTextureImporter> Importer) = 0;
 	};
 }
\ No newline at end of file
@@ -17,8 +17,13 @@
 #include "CoreMinimal.h"
 #include "ITouchImportTexture.h"
 
+#include "Blueprint/TouchEngineTextureDescriptor.h"
+
 #include "Rendering/TouchResourceProvider.h"
+#include "Rendering/Importing/TouchTextureReadback.h"
 #include "Util/TaskSuspender.h"
+#include "Util/TouchTexturePoolCounters.h"
+#include "Util/TouchTexturePoolSizer.h"
 
 #include "Async/TaskGraphInterfaces.h"
 
@@ -37,9 +42,20 @@ namespace UE::TouchEngine
 	struct FTouchTextureLinkData
 	{
 		/** Whether a task is currently in progress */
-		bool bIsInProgress;
+		bool bIsInProgress = false;
 		
-		UTexture* UnrealTexture;
+		UTexture* UnrealTexture = nullptr;
+
+		/** The TouchEngine texture received for the last import */
+		TouchObject<TETexture> LastImportedTETexture;
+		/**
+		 * The transfer we gave back to TouchEngine after copying LastImportedTETexture. TouchEngine adds its own transfer when it writes to the texture,
+		 * so receiving this exact transfer again is the proof that the texture still has the content we copied. Null when the platform cannot provide it.
+		 */
+		TouchObject<TESemaphore> LastReturnedSemaphore;
+		uint64 LastReturnedWaitValue = 0;
+		/** The UTexture the last import was copied into, which is returned again if TouchEngine sends the same content */
+		UTexture2D* LastImportDestination = nullptr;
 	};
 	
 	/** Util for importing a TouchEngine texture into a UTexture2D */
@@ -75,21 +91,51 @@ namespace UE::TouchEngine
 
 		/** The maximum size of the Importing texture pool */
 		int32 PoolSize = 10;
+		/** The maximum GPU memory, in bytes, the textures of the Importing texture pool can take. 0 means the pool is only bounded by PoolSize */
+		int64 PoolBudgetBytes = 0;
 		/**
-		 * Ensure the number of available textures in the pool is less than the PoolSize.
+		 * Ensure the number of available textures in the pool is less than the PoolSize, and that they fit in the PoolBudgetBytes.
 		 * We could have more textures in the pool than the PoolSize as we are not removing textures recently added to the pool.
+		 * Textures are evicted from the buckets whose descriptor has not been requested for the longest first, so a texture matching
+		 * what TouchEngine currently outputs is never evicted while a texture nobody asked for is still pooled.
 		 */
 		void TexturePoolMaintenance(const FTouchEngineInputFrameData& FrameData);
+		/**
+		 * When enabled, the pool is trimmed to the number of textures actually needed over the last frames instead of PoolSize,
+		 * which then only acts as an upper bound. The pool never goes below MinPoolSize.
+		 */
+		void SetAdaptivePoolSize(bool bEnabled, int32 MinPoolSize)
+		{
+			FScopeLock PoolLock(&TexturePoolMutex);
+			PoolSizer.SetEnabled(bEnabled, MinPoolSize);
+		}
+
+		/** Creates UTexture2D matching the given descriptors and adds them to the pool, so the first cooks do not need to create them */
+		void PrewarmPool_GameThread(const TArray<FTouchEngineTextureDescriptor>& Descriptors);
+		/** Returns the descriptors of the textures imported so far, with the number of textures needed to import them without having to create new ones */
+		TArray<FTouchEngineTextureDescriptor> GetObservedDescriptors();
+		/** Returns what the pool did since this importer was created */
+		FTouchTexturePoolCounters GetPoolCounters();
 
 		/**
 		 * Remove a UTexture from the pool, so its lifetime will not be managed by the Importer anymore. Returns true if the Texture was found and the operation successful.
 		 */
 		bool RemoveUTextureFromPool(UTexture2D* Texture);
-		
-		void PrepareForNewCook(const FTouchEngineInputFrameData& FrameData)
-		{
-			RemoveUnusedAliveTextures();
-		}
+
+		/**
+		 * Called by the platform textures when they give a copied texture back to TouchEngine with their own semaphore.
+		 * The semaphore and wait value must be unique to this copy (i.e. a timeline semaphore or a fence with an increasing value), as they are used to detect unchanged outputs.
+		 */
+		void OnTextureTransferReturned_AnyThread(const FTouchImportParameters& ImportParams, const TouchObject<TESemaphore>& Semaphore, uint64 WaitValue);
+
+		/** Enqueues a single render command executing all the texture copies requested since the last call. Called when a cook is done so the copies of all its TOP outputs are batched together */
+		void FlushPendingCopies_AnyThread();
+
+		/**
+		 * The CPU readback of the TOP outputs. Disabled for all the outputs by default.
+		 * Outputs whose content did not change since the last cook are not copied again, so they are not read back again either.
+		 */
+		FTouchTextureReadback& GetReadback() { return Readback; }
 	
 	protected:
 
@@ -104,14 +150,27 @@ namespace UE::TouchEngine
 
 		/** Initiates a texture transfer by calling the appropriate TEInstanceGetTextureTransfer */
 		virtual FTouchTextureTransfer GetTextureTransfer(const FTouchImportParameters& ImportParams);
+		/** Gives the transfer obtained by GetTextureTransfer back to TouchEngine without accessing the texture, for when the import is skipped */
+		virtual void ReturnTextureTransfer(const FTouchImportParameters& ImportParams);
 		
 		virtual void CopyNativeToUnreal_RenderThread(const TSharedPtr<ITouchImportTexture>& TETexture, const FTouchCopyTextureArgs& CopyArgs);
 
-		void RemoveUnusedAliveTextures();
+		struct FPendingTextureCopy
+		{
+			FTouchImportParameters LinkParams;
+			UTexture2D* UEDestinationTexture;
+		};
+		/** Executes the copies of a batch enqueued by FlushPendingCopies_AnyThread. Subclasses can override this to merge the waits and barriers of the copies */
+		virtual void ExecuteCopies_RenderThread(FRHICommandListImmediate& RHICmdList, const TArray<FPendingTextureCopy>& Copies);
+		
+		/** Called by the ITouchImportTexture once the GPU is done with a copy started in CopyNativeToUnreal_RenderThread */
+		void OnCopyDone_AnyThread();
 	private:
 		
 		/** Tracks running tasks and helps us execute an event when all tasks are done (once they've been suspended). */
 		FTaskSuspender TaskSuspender;
+		/** Reads back the imported textures of the outputs it is enabled for */
+		FTouchTextureReadback Readback;
 		FCriticalSection LinkDataMutex;
 		TMap<FName, FTouchTextureLinkData> LinkData;
 
@@ -121,14 +180,48 @@ namespace UE::TouchEngine
 			 * a texture can only be reused on a frame after they have been added to the pool */
 			int64 PooledFrameID;
 			TObjectPtr<UTexture2D> UETexture;
+			/** The GPU memory taken by the texture, as computed when it was added to the pool */
+			int64 SizeInBytes;
+		};
+		struct FImportedTexturePoolBucket
+		{
+			/** The last FrameID at which a texture matching this bucket was requested. Buckets which have not been requested for the longest are evicted first */
+			int64 LastRequestedFrameID = -1;
+			/** The number of textures matching this bucket requested during LastRequestedFrameID */
+			int32 NumRequestsThisFrame = 0;
+			/** The pooled textures matching this bucket, from the oldest to the most recently pooled */
+			TArray<FImportedTexturePoolData> Textures;
 		};
 		FCriticalSection TexturePoolMutex;
 		/** The texture pool itself, keeping hold of the temporary UTexture created to reuse them when an import is needed, saving the need to go back to GameThread to create a new one */
-		TArray<FImportedTexturePoolData> TexturePool;
-
-		FCriticalSection KeepTexturesAliveMutex;
-		/** Array of textures to keep alive while we are copying them */
-		TArray<TPair<TSharedPtr<ITouchImportTexture>, FTexture2DRHIRef>> KeepTexturesAliveForCopy;
+		TMap<FTouchImportTextureDescriptor, FImportedTexturePoolBucket> TexturePool;
+		/** The total number of textures across all the buckets of the TexturePool */
+		int32 NumPooledTextures = 0;
+		/** The total GPU memory taken by the textures of the TexturePool */
+		int64 PooledBytes = 0;
+		/** The maximum number of textures requested during a single frame for each descriptor. Kept after the buckets are removed to be returned by GetObservedDescriptors */
+		TMap<FTouchImportTextureDescriptor, int32> ObservedPeakRequestsPerFrame;
+		/** Computes the size the pool is trimmed to when the adaptive pool size is enabled */
+		FTouchTexturePoolSizer PoolSizer;
+		/** The hits, misses and evictions of the pool, returned by GetPoolCounters. Guarded by TexturePoolMutex */
+		FTouchTexturePoolCounters PoolCounters;
+		/** What this pool last added to the stats. Each instance only adds its own changes so the stats sum the pools of all the instances */
+		int32 ReportedNumPooledTextures = 0;
+		int32 ReportedTargetPoolSize = 0;
+		int64 ReportedPooledBytes = 0;
+
+		FCriticalSection PendingCopiesMutex;
+		/** The copies requested during the current cook, waiting for FlushPendingCopies_AnyThread */
+		TArray<FPendingTextureCopy> PendingCopies;
+		
+		FCriticalSection CopiesInFlightMutex;
+		/**
+		 * The number of copies enqueued which the GPU has not finished yet. Guarded by CopiesInFlightMutex.
+		 * The textures involved in a copy are kept alive by the callback given to ITouchImportTexture::OnCurrentCopyDone_RenderThread, and released as soon as it executes.
+		 */
+		int32 NumCopiesInFlight = 0;
+		/** Set by SuspendAsyncTasks when copies are still in flight, fulfilled by the last of them to be done. Guarded by CopiesInFlightMutex */
+		TOptional<TPromise<FTouchSuspendResult>> CopiesDonePromise;
 		
 		/**
 		 * @brief 
@@ -138,8 +231,22 @@ namespace UE::TouchEngine
 		 */
 		void ExecuteLinkTextureRequest_AnyThread(TPromise<FTouchTextureImportResult>&& Promise, const FTouchImportParameters& LinkParams, const TSharedPtr<FTouchFrameCooker>& FrameCooker);
 		
-		UTexture2D* GetOrCreateUTextureMatchingMetaData(const FTextureMetaData& TETextureMetadata, const FTouchImportParameters& LinkParams, bool& bOutAccessRHIViaReferenceTexture);
+		/** Returns the UTexture of the last import of this parameter if TouchEngine sent the same texture with the transfer we gave back after copying it, meaning its content did not change */
+		UTexture2D* FindUnchangedImport(const FTouchImportParameters& LinkParams);
+		UTexture2D* GetOrCreateUTextureMatchingMetaData(const FTextureMetaData& TETextureMetadata, const FTouchImportParameters& LinkParams);
 		UTexture2D* FindPoolTextureMatchingMetadata(const FTextureMetaData& TETextureMetadata, const FTouchEngineInputFrameData& FrameData);
+		/** Adds a texture to the bucket matching its descriptor. Expects the TexturePoolMutex to be locked */
+		void AddTextureToPool(UTexture2D* Texture, int64 FrameID);
+		/** Removes the texture at the given index of the bucket and updates the pool totals. Expects the TexturePoolMutex to be locked */
+		FImportedTexturePoolData RemoveTextureFromBucket(FImportedTexturePoolBucket& Bucket, int32 Index);
+		/** Returns true if the pool holds more textures than allowed by the PoolSizer or PoolBudgetBytes. Expects the TexturePoolMutex to be locked */
+		bool IsPoolOverBudget() const { return NumPooledTextures > PoolSizer.GetPoolSize(PoolSize) || (PoolBudgetBytes > 0 && PooledBytes > PoolBudgetBytes); }
+		/** Updates the stats tracking the content of the pool. Expects the TexturePoolMutex to be locked */
+		void UpdatePoolStats(int32 TargetPoolSize);
+		/** Returns the bucket we should evict a texture from, or nullptr if all the pooled textures have been added this frame. Expects the TexturePoolMutex to be locked */
+		FImportedTexturePoolBucket* FindBucketToEvictFrom(const FTouchEngineInputFrameData& FrameData);
+		/** Releases the resources of a texture evicted from the pool */
+		static void DestroyPooledTexture(UTexture2D* Texture);
 	};
 }
 
@@ -0,0 +1,114 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PixelFormat.h"
+
+class FRHICommandListImmediate;
+class FRHIGPUTextureReadback;
+class FRHITexture;
+
+namespace UE::TouchEngine
+{
+	/** The pixels of a TOP output read back to the CPU */
+	struct FTouchTextureReadbackData
+	{
+		/** The identifier of the TOP output */
+		FName Identifier;
+		/** The FrameID of the cook which produced this output */
+		int64 FrameID = -1;
+		int32 SizeX = 0;
+		int32 SizeY = 0;
+		EPixelFormat PixelFormat = PF_Unknown;
+		/** The number of bytes between the start of two rows in Pixels. The rows are tightly packed */
+		int64 RowPitchInBytes = 0;
+		/** The pixel data. The buffer is reused for later readbacks once all the references to it have been released, so listeners should not keep it longer than needed */
+		TSharedPtr<TArray64<uint8>, ESPMode::ThreadSafe> Pixels;
+	};
+	
+	DECLARE_MULTICAST_DELEGATE_OneParam(FOnTouchTextureReadback, const FTouchTextureReadbackData&);
+
+	/**
+	 * Asynchronously reads back the imported TOP outputs to the CPU, for the outputs it has been enabled for.
+	 * Each output has a ring of GPU readbacks, so the render thread never waits on the GPU: readbacks are checked at the start of every render thread frame and delivered once ready.
+	 * If all the readbacks of an output are still in flight, the new one is dropped. Block compressed formats are not supported.
+	 */
+	class TOUCHENGINE_API FTouchTextureReadback
+	{
+	public:
+		/** The default number of readbacks that can be in flight for a single output */
+		static constexpr int32 DefaultRingSize = 3;
+
+		FTouchTextureReadback();
+		~FTouchTextureReadback();
+
+		/** Starts polling the readbacks of every FTouchTextureReadback at the start of each render thread frame, so they are delivered even when no new copy is enqueued. Called by the module */
+		static void RegisterFrameHook();
+		static void UnregisterFrameHook();
+		
+		/** Enables or disables the readback of the given TOP output. RingSize is the number of readbacks which can be in flight for this output */
+		void SetReadbackEnabled(FName Identifier, bool bEnabled, int32 RingSize = DefaultRingSize);
+		bool IsReadbackEnabled(FName Identifier) const;
+
+		/** Adds a listener which will be called on the render thread when the pixels of an output are ready */
+		FDelegateHandle AddListener(FOnTouchTextureReadback::FDelegate&& Listener);
+		void RemoveListener(FDelegateHandle Handle);
+
+		/** Enqueues the readback of the texture the TOP output was copied into, if the readback is enabled for this output. Expects the copy to have been enqueued on RHICmdList */
+		void EnqueueReadback_RenderThread(FRHICommandListImmediate& RHICmdList, FName Identifier, int64 FrameID, FRHITexture* Texture);
+		/** Delivers the readbacks which are done to the listeners, without waiting for the others */
+		void ProcessReadbacks_RenderThread() { DeliverReadbacks_RenderThread(false); }
+
+		/** Calls ProcessReadbacks_RenderThread on every FTouchTextureReadback. Bound to FCoreDelegates::OnBeginFrameRT, and can be called directly when no render thread frame runs (i.e. in commandlets) */
+		static void ProcessAllReadbacks_RenderThread();
+		/**
+		 * Waits for the GPU to be done with all the readbacks in flight of every FTouchTextureReadback, and delivers them to the listeners.
+		 * This blocks the render thread until the GPU is idle, so it is only meant for tools like the benchmarks which need all the readbacks of their cooks.
+		 */
+		static void FlushAllReadbacks_RenderThread(FRHICommandListImmediate& RHICmdList);
+
+	private:
+		struct FReadbackSlot
+		{
+			TUniquePtr<FRHIGPUTextureReadback> Readback;
+			int64 FrameID = -1;
+			FIntPoint Size = FIntPoint::ZeroValue;
+			EPixelFormat PixelFormat = PF_Unknown;
+			bool bInFlight = false;
+		};
+		struct FReadbackRing
+		{
+			TArray<FReadbackSlot> Slots;
+			/** The slot the next readback will use, which is also the oldest readback in flight */
+			int32 NextSlot = 0;
+			/** The CPU buffers given to the listeners, reused once the listeners released them */
+			TArray<TSharedPtr<TArray64<uint8>, ESPMode::ThreadSafe>> Buffers;
+			/** True once we warned that the output has a format we cannot read back, so we only warn once */
+			bool bHasWarnedUnsupportedFormat = false;
+		};
+		
+		/** Delivers the readbacks which are done to the listeners. If bGPUIsIdle, all the readbacks in flight are considered done */
+		void DeliverReadbacks_RenderThread(bool bGPUIsIdle);
+		/** Copies the pixels of a ready readback into a pooled CPU buffer. Returns false if the staging texture could not be mapped, in which case there is nothing to deliver */
+		static bool ReadPixels_RenderThread(FName Identifier, FReadbackSlot& Slot, FReadbackRing& Ring, FTouchTextureReadbackData& OutData);
+
+		mutable FCriticalSection RingsMutex;
+		TMap<FName, FReadbackRing> Rings;
+
+		FCriticalSection ListenersMutex;
+		FOnTouchTextureReadback OnReadback;
+	};
+}
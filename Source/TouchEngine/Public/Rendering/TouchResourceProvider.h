@@ -15,6 +15,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Blueprint/TouchEngineTextureDescriptor.h"
 
 #include "Exporting/TouchExportParams.h"
 #include "Importing/TouchImportParams.h"
@@ -99,6 +100,22 @@ namespace UE::TouchEngine
 
 		virtual bool SetExportedTexturePoolSize(int ExportedTexturePoolSize) = 0;
 		virtual bool SetImportedTexturePoolSize(int ImportedTexturePoolSize) = 0;
+		/** Sets the maximum GPU memory, in bytes, the exported texture pool can take. 0 means the pool is only bounded by its size. Returns false if the provider does not support it, like D3D11 */
+		virtual bool SetExportedTexturePoolBudget(int64 ExportedTexturePoolBudgetBytes) = 0;
+		/** Sets the maximum GPU memory, in bytes, the imported texture pool can take. 0 means the pool is only bounded by its size. Returns false if the provider does not support it, like D3D11 */
+		virtual bool SetImportedTexturePoolBudget(int64 ImportedTexturePoolBudgetBytes) = 0;
+		/** Enables trimming the exported texture pool to the observed demand, between MinPoolSize and the exported texture pool size. Returns false if the provider does not support it, like D3D11 */
+		virtual bool SetExportedTexturePoolAdaptiveSizing(bool bEnabled, int32 MinPoolSize) = 0;
+		/** Enables trimming the imported texture pool to the observed demand, between MinPoolSize and the imported texture pool size. Returns false if the provider does not support it, like D3D11 */
+		virtual bool SetImportedTexturePoolAdaptiveSizing(bool bEnabled, int32 MinPoolSize) = 0;
+		/** Fills the exported texture pool with textures matching the given descriptors */
+		virtual bool PrewarmExportedTexturePool_GameThread(const TArray<FTouchEngineTextureDescriptor>& Descriptors) = 0;
+		/** Fills the imported texture pool with textures matching the given descriptors */
+		void PrewarmImportedTexturePool_GameThread(const TArray<FTouchEngineTextureDescriptor>& Descriptors);
+		/** Returns the descriptors of the textures exported so far, with the number of textures needed for each */
+		virtual TArray<FTouchEngineTextureDescriptor> GetObservedExportedTextureDescriptors() = 0;
+		/** Returns the descriptors of the textures imported so far, with the number of textures needed for each */
+		TArray<FTouchEngineTextureDescriptor> GetObservedImportedTextureDescriptors();
 		
 		/**
 		 * Returns a stable RHI for the given texture. The texture needs to not be null.
@@ -15,11 +15,49 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "ProfilingDebugging/CsvProfiler.h"
 
 DECLARE_STATS_GROUP(TEXT("TouchEngine"), STATGROUP_TouchEngine, STATCAT_Advanced)
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(TOUCHENGINE_API, TouchEngine);
 
 DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Export - Texture Pool - Nb Total Textures"), STAT_TE_ExportedTexturePool_NbTexturesTotal, STATGROUP_TouchEngine)
 DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Export - Texture Pool - Nb Textures in Pool"), STAT_TE_ExportedTexturePool_NbTexturesPool, STATGROUP_TouchEngine)
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Export - Texture Pool - Target Size"), STAT_TE_ExportedTexturePool_TargetSize, STATGROUP_TouchEngine)
+DECLARE_MEMORY_STAT(TEXT("Export - Texture Pool - Resident Memory"), STAT_TE_ExportedTexturePool_ResidentBytes, STATGROUP_TouchEngine)
+DECLARE_DWORD_COUNTER_STAT(TEXT("Export - Texture Pool - Hits"), STAT_TE_ExportedTexturePool_Hits, STATGROUP_TouchEngine)
+DECLARE_DWORD_COUNTER_STAT(TEXT("Export - Texture Pool - Misses"), STAT_TE_ExportedTexturePool_Misses, STATGROUP_TouchEngine)
+DECLARE_DWORD_COUNTER_STAT(TEXT("Export - Texture Pool - Evictions"), STAT_TE_ExportedTexturePool_Evictions, STATGROUP_TouchEngine)
 
 DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Import - Texture Pool - Nb Textures in Pool"), STAT_TE_ImportedTexturePool_NbTexturesPool, STATGROUP_TouchEngine)
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Import - Texture Pool - Target Size"), STAT_TE_ImportedTexturePool_TargetSize, STATGROUP_TouchEngine)
+DECLARE_MEMORY_STAT(TEXT("Import - Texture Pool - Resident Memory"), STAT_TE_ImportedTexturePool_ResidentBytes, STATGROUP_TouchEngine)
+DECLARE_DWORD_COUNTER_STAT(TEXT("Import - Texture Pool - Hits"), STAT_TE_ImportedTexturePool_Hits, STATGROUP_TouchEngine)
+DECLARE_DWORD_COUNTER_STAT(TEXT("Import - Texture Pool - Misses"), STAT_TE_ImportedTexturePool_Misses, STATGROUP_TouchEngine)
+DECLARE_DWORD_COUNTER_STAT(TEXT("Import - Texture Pool - Evictions"), STAT_TE_ImportedTexturePool_Evictions, STATGROUP_TouchEngine)
+DECLARE_DWORD_COUNTER_STAT(TEXT("Import - Unchanged Textures Skipped"), STAT_TE_Import_NbUnchangedTexturesSkipped, STATGROUP_TouchEngine)
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Import - Nb Copies in Flight"), STAT_TE_Import_NbCopiesInFlight, STATGROUP_TouchEngine)
 DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Import - No Texture2d Created for Import"), STAT_TE_Import_NbTexture2dCreated, STATGROUP_TouchEngine)
+DECLARE_DWORD_COUNTER_STAT(TEXT("Import - Readbacks Dropped"), STAT_TE_Import_ReadbacksDropped, STATGROUP_TouchEngine)
+
+DECLARE_MEMORY_STAT(TEXT("Instance - GPU Memory Used"), STAT_TE_Instance_GPUMemoryUsed, STATGROUP_TouchEngine)
+DECLARE_MEMORY_STAT(TEXT("Instance - CPU Memory Used"), STAT_TE_Instance_CPUMemoryUsed, STATGROUP_TouchEngine)
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Instance - CPU Frame Time (ms)"), STAT_TE_Instance_CPUFrameTime, STATGROUP_TouchEngine)
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Instance - GPU Frame Time (ms)"), STAT_TE_Instance_GPUFrameTime, STATGROUP_TouchEngine)
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Instance - Frames Processed"), STAT_TE_Instance_FramesProcessed, STATGROUP_TouchEngine)
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Instance - Frames Dropped"), STAT_TE_Instance_FramesDropped, STATGROUP_TouchEngine)
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Cook - Requested"), STAT_TE_Cook_Requested, STATGROUP_TouchEngine)
+DECLARE_DWORD_COUNTER_STAT(TEXT("Cook - Started"), STAT_TE_Cook_Started, STATGROUP_TouchEngine)
+DECLARE_DWORD_COUNTER_STAT(TEXT("Cook - Failed To Start"), STAT_TE_Cook_FailedToStart, STATGROUP_TouchEngine)
+DECLARE_DWORD_COUNTER_STAT(TEXT("Cook - Inputs Discarded"), STAT_TE_Cook_InputsDiscarded, STATGROUP_TouchEngine)
+DECLARE_DWORD_COUNTER_STAT(TEXT("Cook - Timeouts"), STAT_TE_Cook_Timeouts, STATGROUP_TouchEngine)
+DECLARE_DWORD_COUNTER_STAT(TEXT("Cook - Succeeded"), STAT_TE_Cook_Succeeded, STATGROUP_TouchEngine)
+DECLARE_DWORD_COUNTER_STAT(TEXT("Cook - Frames Dropped"), STAT_TE_Cook_FramesDropped, STATGROUP_TouchEngine)
+DECLARE_DWORD_COUNTER_STAT(TEXT("Cook - Cancelled"), STAT_TE_Cook_Cancelled, STATGROUP_TouchEngine)
+DECLARE_DWORD_COUNTER_STAT(TEXT("Cook - Errors"), STAT_TE_Cook_Errors, STATGROUP_TouchEngine)
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Cook - Pending Queue Depth"), STAT_TE_Cook_PendingQueueDepth, STATGROUP_TouchEngine)
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Cook - Latency p50 (ms)"), STAT_TE_Cook_LatencyP50, STATGROUP_TouchEngine)
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Cook - Latency p95 (ms)"), STAT_TE_Cook_LatencyP95, STATGROUP_TouchEngine)
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Cook - Latency p99 (ms)"), STAT_TE_Cook_LatencyP99, STATGROUP_TouchEngine)
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Cook - Latency Max (ms)"), STAT_TE_Cook_LatencyMax, STATGROUP_TouchEngine)
+DECLARE_DWORD_COUNTER_STAT(TEXT("Cook - Tick Latency Max"), STAT_TE_Cook_TickLatencyMax, STATGROUP_TouchEngine)
@@ -0,0 +1,83 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Blueprint/TouchEngineInputFrameData.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Trace/Trace.h"
+
+/**
+ * The TouchEngine trace channel, enabled with -trace=cpu,touchengine or `Trace.Enable TouchEngine`.
+ * Each cook shows up in Insights as a timing region named after its component and FrameID, spanning from the input copy to the output retrieval,
+ * and each phase of the cook emits a CPU scope plus CookPhaseBegin / CookPhaseEnd events tagged with the component and FrameID, on whichever thread it runs.
+ */
+UE_TRACE_CHANNEL_EXTERN(TouchEngineChannel, TOUCHENGINE_API)
+
+namespace UE::TouchEngine
+{
+	/** The phases of a cook which can be traced with TOUCHENGINE_TRACE_COOK_PHASE. The enumerator name is the Phase of the trace events */
+	enum class ECookPhase : uint8
+	{
+		/** The copy of the component's inputs into the cook request, on the GameThread */
+		InputCopy,
+		/** The inputs being set on the TouchEngine links */
+		SendInput,
+		/** The export of all the textures of the cook being finalized */
+		Export,
+		/** The export of a single texture input */
+		ExportTexture,
+		/** The call to TEInstanceStartFrameAtTime */
+		StartFrame,
+		/** The TouchEngine callback telling an output changed */
+		LinkValueCallback,
+		/** The copy of a TOP output into its UTexture2D, on the render thread */
+		ImportCopy,
+		/** The retrieval of the outputs once the cook is done */
+		GetOutputs,
+	};
+	
+	/** Emits the begin and end events of a phase of a cook on the TouchEngine channel. Use TOUCHENGINE_TRACE_COOK_PHASE rather than this directly */
+	class TOUCHENGINE_API FCookPhaseTraceScope : public FNoncopyable
+	{
+	public:
+		FCookPhaseTraceScope(const TCHAR* InPhase, const FTouchEngineInputFrameData& FrameData);
+		~FCookPhaseTraceScope();
+
+	private:
+		const TCHAR* Phase;
+		int64 FrameID;
+		bool bIsTracing;
+	};
+
+	/** Begins the timing region of a cook. Use TOUCHENGINE_TRACE_BEGIN_COOK rather than this directly */
+	TOUCHENGINE_API void TraceBeginCook(const FTouchEngineInputFrameData& FrameData);
+	/** Ends the timing region of a cook. Use TOUCHENGINE_TRACE_END_COOK rather than this directly */
+	TOUCHENGINE_API void TraceEndCook(const FTouchEngineInputFrameData& FrameData);
+}
+
+#if UE_TRACE_ENABLED
+/** Traces the rest of the scope as the given phase of the cook of FrameData. Phase must be the name of an ECookPhase enumerator */
+#define TOUCHENGINE_TRACE_COOK_PHASE(Phase, FrameData) \
+	static_assert(sizeof(UE::TouchEngine::ECookPhase::Phase) > 0, "Unknown TouchEngine cook phase"); \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR("TouchEngine::" #Phase, TouchEngineChannel); \
+	const UE::TouchEngine::FCookPhaseTraceScope PREPROCESSOR_JOIN(TouchEngineCookPhaseScope, __LINE__)(TEXT(#Phase), FrameData)
+#define TOUCHENGINE_TRACE_BEGIN_COOK(FrameData) UE::TouchEngine::TraceBeginCook(FrameData)
+#define TOUCHENGINE_TRACE_END_COOK(FrameData) UE::TouchEngine::TraceEndCook(FrameData)
+#else
+#define TOUCHENGINE_TRACE_COOK_PHASE(Phase, FrameData)
+#define TOUCHENGINE_TRACE_BEGIN_COOK(FrameData)
+#define TOUCHENGINE_TRACE_END_COOK(FrameData)
+#endif
@@ -0,0 +1,36 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace UE::TouchEngine
+{
+	/** What a texture pool did since it was created. Lets tools and benchmarks check the pools without relying on the stats being enabled */
+	struct FTouchTexturePoolCounters
+	{
+		/** The number of requests which reused a pooled texture */
+		int64 Hits = 0;
+		/** The number of requests which needed a new texture */
+		int64 Misses = 0;
+		/** The number of textures released to keep the pool within its size and budget */
+		int64 Evictions = 0;
+		/** The number of textures currently in the pool */
+		int32 NumPooledTextures = 0;
+		/** The number of descriptors the pool currently has a bucket for */
+		int32 NumBuckets = 0;
+	};
+}
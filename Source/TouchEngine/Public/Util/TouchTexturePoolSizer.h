@@ -0,0 +1,126 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace UE::TouchEngine
+{
+	/**
+	 * Computes the size a texture pool should have from the demand observed over a sliding window of frames.
+	 * The pool grows as soon as requests miss the pool, and shrinks when some textures stayed unused in the pool for the whole window.
+	 * Not thread safe, expected to be called while holding the lock of the pool.
+	 */
+	class FTouchTexturePoolSizer
+	{
+	public:
+		/** The number of frames over which the demand is observed */
+		static constexpr int32 WindowSize = 120;
+
+		/** Enables or disables the adaptive sizing. When disabled, GetPoolSize always returns the MaxPoolSize it is given */
+		void SetEnabled(bool bInEnabled, int32 InMinPoolSize)
+		{
+			bEnabled = bInEnabled;
+			MinPoolSize = FMath::Max(InMinPoolSize, 0);
+			CurrentPoolSize = MAX_int32; // we start from the upper bound and let the pool shrink, to avoid creating textures while the demand is being observed
+			Samples.Reset();
+			NextSampleIndex = 0;
+			CurrentFrame = {};
+		}
+		bool IsEnabled() const { return bEnabled; }
+
+		/** To be called every time a texture is requested from the pool */
+		void RecordRequest(bool bWasHit)
+		{
+			++(bWasHit ? CurrentFrame.Hits : CurrentFrame.Misses);
+		}
+
+		/**
+		 * To be called once per frame, before trimming the pool
+		 * @param NumIdleTextures The number of textures currently sitting unused in the pool
+		 * @param MaxPoolSize The upper bound of the pool size set by the user
+		 */
+		void RecordFrame(int32 NumIdleTextures, int32 MaxPoolSize)
+		{
+			if (!bEnabled)
+			{
+				return;
+			}
+
+			CurrentPoolSize = FMath::Min(CurrentPoolSize, MaxPoolSize);
+			CurrentFrame.IdleTextures = NumIdleTextures;
+			if (Samples.Num() < WindowSize)
+			{
+				Samples.Add(CurrentFrame);
+			}
+			else
+			{
+				Samples[NextSampleIndex] = CurrentFrame;
+			}
+			NextSampleIndex = (NextSampleIndex + 1) % WindowSize;
+
+			// 1. Any miss means the pool was too small for this frame, so we grow straight away by the number of textures we had to create
+			if (CurrentFrame.Misses > 0)
+			{
+				CurrentPoolSize += CurrentFrame.Misses;
+			}
+			// 2. Otherwise, once we have observed a full window, the textures which stayed idle during the whole window are not needed
+			else if (Samples.Num() == WindowSize)
+			{
+				int32 PeakRequests = 0;
+				int32 MinIdleTextures = MAX_int32;
+				int32 WindowMisses = 0;
+				for (const FFrameSample& Sample : Samples)
+				{
+					PeakRequests = FMath::Max(PeakRequests, Sample.Hits + Sample.Misses);
+					MinIdleTextures = FMath::Min(MinIdleTextures, Sample.IdleTextures);
+					WindowMisses += Sample.Misses;
+				}
+				if (WindowMisses == 0 && MinIdleTextures > 0)
+				{
+					// we keep at least enough textures for the peak demand of the window, and we start a new window before shrinking again
+					CurrentPoolSize = FMath::Max(PeakRequests, CurrentPoolSize - MinIdleTextures);
+					Samples.Reset();
+					NextSampleIndex = 0;
+				}
+			}
+			CurrentPoolSize = FMath::Clamp(CurrentPoolSize, FMath::Min(MinPoolSize, MaxPoolSize), MaxPoolSize);
+			CurrentFrame = {};
+		}
+
+		/** Returns the size the pool should be trimmed to */
+		int32 GetPoolSize(int32 MaxPoolSize) const
+		{
+			return bEnabled ? FMath::Min(CurrentPoolSize, MaxPoolSize) : MaxPoolSize;
+		}
+
+	private:
+		struct FFrameSample
+		{
+			int32 Hits = 0;
+			int32 Misses = 0;
+			int32 IdleTextures = 0;
+		};
+
+		bool bEnabled = false;
+		int32 MinPoolSize = 0;
+		int32 CurrentPoolSize = 0;
+
+		/** Ring buffer of the last WindowSize frames */
+		TArray<FFrameSample> Samples;
+		int32 NextSampleIndex = 0;
+		FFrameSample CurrentFrame;
+	};
+}
@@ -26,6 +26,7 @@
 #include "D3D11TouchUtils.h"
 
 #include "ITouchEngineModule.h"
+#include "Logging.h"
 #include "TouchEngine/TED3D11.h"
 #include "TouchEngine/TouchObject.h"
 
@@ -79,6 +80,13 @@ namespace UE::TouchEngine::D3DX11
 		virtual void FinalizeExportsToTouchEngine_GameThread(const FTouchEngineInputFrameData& FrameData) override {};
 		virtual bool SetExportedTexturePoolSize(int ExportedTexturePoolSize) override { return false; }
 		virtual bool SetImportedTexturePoolSize(int ImportedTexturePoolSize) override { return false; }
+		// The D3D11 provider does not pool its textures, so the budget and the adaptive sizing are not supported. They log a warning when enabled and return false
+		virtual bool SetExportedTexturePoolBudget(int64 ExportedTexturePoolBudgetBytes) override;
+		virtual bool SetImportedTexturePoolBudget(int64 ImportedTexturePoolBudgetBytes) override;
+		virtual bool SetExportedTexturePoolAdaptiveSizing(bool bEnabled, int32 MinPoolSize) override;
+		virtual bool SetImportedTexturePoolAdaptiveSizing(bool bEnabled, int32 MinPoolSize) override;
+		virtual bool PrewarmExportedTexturePool_GameThread(const TArray<FTouchEngineTextureDescriptor>& Descriptors) override { return false; }
+		virtual TArray<FTouchEngineTextureDescriptor> GetObservedExportedTextureDescriptors() override { return {}; }
 
 	protected:
 		virtual FTouchTextureImporter& GetImporter() override { return TextureImporter.Get(); }
@@ -131,6 +139,30 @@ namespace UE::TouchEngine::D3DX11
     {
      	return TEContext;
     }
+
+	bool FTouchEngineD3X11ResourceProvider::SetExportedTexturePoolBudget(int64 ExportedTexturePoolBudgetBytes)
+	{
+		UE_CLOG(ExportedTexturePoolBudgetBytes > 0, LogTouchEngine, Warning, TEXT("[SetExportedTexturePoolBudget] The exported texture pool budget is not supported on D3D11 and is ignored"));
+		return false;
+	}
+
+	bool FTouchEngineD3X11ResourceProvider::SetImportedTexturePoolBudget(int64 ImportedTexturePoolBudgetBytes)
+	{
+		UE_CLOG(ImportedTexturePoolBudgetBytes > 0, LogTouchEngine, Warning, TEXT("[SetImportedTexturePoolBudget] The imported texture pool budget is not supported on D3D11 and is ignored"));
+		return false;
+	}
+
+	bool FTouchEngineD3X11ResourceProvider::SetExportedTexturePoolAdaptiveSizing(bool bEnabled, int32 MinPoolSize)
+	{
+		UE_CLOG(bEnabled, LogTouchEngine, Warning, TEXT("[SetExportedTexturePoolAdaptiveSizing] The adaptive sizing of the exported texture pool is not supported on D3D11 and is ignored"));
+		return false;
+	}
+
+	bool FTouchEngineD3X11ResourceProvider::SetImportedTexturePoolAdaptiveSizing(bool bEnabled, int32 MinPoolSize)
+	{
+		UE_CLOG(bEnabled, LogTouchEngine, Warning, TEXT("[SetImportedTexturePoolAdaptiveSizing] The adaptive sizing of the imported texture pool is not supported on D3D11 and is ignored"));
+		return false;
+	}
 	
 	FTouchLoadInstanceResult FTouchEngineD3X11ResourceProvider::ValidateLoadedTouchEngine(TEInstance& Instance)
 	{
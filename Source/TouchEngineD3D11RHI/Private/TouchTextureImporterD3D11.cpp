@@ -91,7 +91,7 @@ namespace UE::TouchEngine::D3DX11
 				return DynamicRHI->RHICreateTexture2DFromResource(Format, TexCreate_Shared, FClearValueBinding::None, SourceD3D11Texture2D).GetReference();
 			}
 
-			virtual void ReleaseMutex_RenderThread(const FTouchCopyTextureArgs& CopyArgs, const TouchObject<TESemaphore>& Semaphore, FTexture2DRHIRef& SourceTexture) override
+			virtual void ReleaseMutex_RenderThread(const FTouchCopyTextureArgs& CopyArgs, const TouchObject<TESemaphore>& Semaphore, FTexture2DRHIRef& SourceTexture, const TSharedRef<FTouchTextureImporter>& Importer) override
 			{
 				ID3D11Texture2D* Resource = TED3D11TextureGetTexture(PlatformTexture);
 		
@@ -102,7 +102,8 @@ namespace UE::TouchEngine::D3DX11
 					: 0 + 1; //todo: used to be the passed in WaitValue
 				Mutex->ReleaseSync(ReleaseValue);
 
-				// 2. The mutex will get reacquired by TE, which will destroy the texture
+				// 2. The mutex will get reacquired by TE, which will destroy the texture.
+				// The release values are always the same, so this transfer cannot be reported to the importer to detect unchanged outputs
 				TEInstanceAddTextureTransfer(CopyArgs.RequestParams.Instance, PlatformTexture.get(), Semaphore, ReleaseValue);
 				
 				PlatformTexture.reset();
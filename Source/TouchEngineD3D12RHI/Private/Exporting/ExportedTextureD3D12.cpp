@@ -30,6 +30,7 @@ THIRD_PARTY_INCLUDES_END
 #include "D3D12TouchUtils.h"
 #include "Logging.h"
 #include "TextureShareD3D12PlatformWindows.h"
+#include "Rendering/Exporting/ExportedTouchTextureCache.h"
 
 #include "Engine/Texture.h"
 #include "Engine/Texture2D.h"
@@ -57,7 +58,7 @@ namespace UE::TouchEngine::D3DX12
 		}
 	}
 	
-	TSharedPtr<FExportedTextureD3D12> FExportedTextureD3D12::Create(const FRHITexture2D& SourceRHI, const FTextureShareD3D12SharedResourceSecurityAttributes& SharedResourceSecurityAttributes)
+	TSharedPtr<FExportedTextureD3D12> FExportedTextureD3D12::Create(const FTouchExportTextureDescriptor& Descriptor, const FString& DebugName, const FTextureShareD3D12SharedResourceSecurityAttributes& SharedResourceSecurityAttributes)
 	{
 		DECLARE_SCOPE_CYCLE_COUNTER(TEXT("      I.B.1.a [GT] Cook Frame - D3D12::CreateTexture"), STAT_TE_I_B_1_a_D3D, STATGROUP_TouchEngine);
 		using namespace Private;
@@ -66,11 +67,11 @@ namespace UE::TouchEngine::D3DX12
 		const FGuid ResourceId = FGuid::NewGuid();
 		const FString ResourceIdString = GenerateIdentifierString(ResourceId);
 
-		const int32 SizeX = SourceRHI.GetSizeX();
-		const int32 SizeY = SourceRHI.GetSizeY();
-		const EPixelFormat Format = SourceRHI.GetFormat();
-		const int32 NumMips = SourceRHI.GetNumMips();
-		const int32 NumSamples = SourceRHI.GetNumSamples();
+		const int32 SizeX = Descriptor.Size.X;
+		const int32 SizeY = Descriptor.Size.Y;
+		const EPixelFormat Format = Descriptor.PixelFormat;
+		const int32 NumMips = Descriptor.NumMips;
+		const int32 NumSamples = Descriptor.NumSamples;
 
 		// The code below is to check that the texture is copied properly by outputting the TopLeft pixel color. Check FTouchImportTextureD3D12::CopyTexture_RenderThread
 		// ENQUEUE_RENDER_COMMAND(TL)([RHI = const_cast<FRHITexture2D*>(&SourceRHI)](FRHICommandListImmediate& RHICmdList)
@@ -86,11 +87,11 @@ namespace UE::TouchEngine::D3DX12
 		{
 			DECLARE_SCOPE_CYCLE_COUNTER(TEXT("      I.B.1.b [GT] Cook Frame - D3D12::CreateTexture - Create_RHICreateTexture"), STAT_TE_I_B_1_b_D3D, STATGROUP_TouchEngine);
 
-			FRHITextureCreateDesc TextureDesc = FRHITextureCreateDesc::Create2D(*FString::Printf(TEXT("Global %s %s"), *SourceRHI.GetName().ToString(), *ResourceIdString), SizeX, SizeY, Format)
+			FRHITextureCreateDesc TextureDesc = FRHITextureCreateDesc::Create2D(*FString::Printf(TEXT("Global %s %s"), *DebugName, *ResourceIdString), SizeX, SizeY, Format)
 				.SetNumMips(NumMips)
 				.SetNumSamples(NumSamples)
 				.SetFlags(TexCreate_Shared);
-			if (EnumHasAnyFlags(SourceRHI.GetDesc().Flags, ETextureCreateFlags::SRGB))
+			if (Descriptor.bIsSRGB)
 			{
 				TextureDesc.AddFlags(ETextureCreateFlags::SRGB);
 			}
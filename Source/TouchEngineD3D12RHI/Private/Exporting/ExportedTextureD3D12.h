@@ -19,6 +19,11 @@
 
 #include "TouchEngine/TouchObject.h"
 
+namespace UE::TouchEngine
+{
+	struct FTouchExportTextureDescriptor;
+}
+
 namespace UE::TouchEngine::D3DX12
 {
 	class FTextureShareD3D12SharedResourceSecurityAttributes;
@@ -27,7 +32,8 @@ namespace UE::TouchEngine::D3DX12
 	{
 	public:
 		
-		static TSharedPtr<FExportedTextureD3D12> Create(const FRHITexture2D& SourceRHI, const FTextureShareD3D12SharedResourceSecurityAttributes& SharedResourceSecurityAttributes);
+		/** Creates a shared texture matching the descriptor. The DebugName is added to the name of the RHI texture */
+		static TSharedPtr<FExportedTextureD3D12> Create(const FTouchExportTextureDescriptor& Descriptor, const FString& DebugName, const FTextureShareD3D12SharedResourceSecurityAttributes& SharedResourceSecurityAttributes);
 		
 		FExportedTextureD3D12(FTexture2DRHIRef SharedTextureRHI, const FGuid& ResourceId, void* ResourceSharingHandle, const TouchObject<TED3DSharedTexture>& TouchRepresentation);
 		//~ Begin FExportedTouchTexture Interface
@@ -51,9 +51,9 @@ namespace UE::TouchEngine::D3DX12
 		//~ End FTouchTextureExporter Interface
 
 		//~ Begin TExportedTouchTextureCache Interface
-		TSharedPtr<FExportedTextureD3D12> CreateTexture(const FTouchExportParameters& Params, const FRHITexture2D* ParamTextureRHI) const
+		TSharedPtr<FExportedTextureD3D12> CreateTexture(const FTouchExportParameters& Params, const FTouchExportTextureDescriptor& Descriptor) const
 		{
-			return FExportedTextureD3D12::Create(*ParamTextureRHI, SharedResourceSecurityAttributes);
+			return FExportedTextureD3D12::Create(Descriptor, Params.Texture ? Params.Texture->GetName() : Params.ParameterName.ToString(), SharedResourceSecurityAttributes);
 		}
 		void InitializeExportsToTouchEngine_GameThread(const FTouchEngineInputFrameData& FrameData);
 		void FinalizeExportsToTouchEngine_GameThread(const FTouchEngineInputFrameData& FrameData);
@@ -22,8 +22,56 @@
 #include "TouchEngine/TED3D.h"
 #include "Util/TouchEngineStatsGroup.h"
 
+#include <atomic>
+
 namespace UE::TouchEngine::D3DX12
 {
+	namespace Private
+	{
+		/** The maximum time we wait for a copy to be done before executing its callback anyway */
+		constexpr uint32 CopyDoneTimeoutMs = 5000;
+		
+		/** The data of a wait registered on the Windows thread pool, deleted by whoever is done with it last between the registering thread and the wait callback */
+		struct FCopyDoneWait
+		{
+			TSharedRef<FTouchFenceCache::FFenceData> Fence; // keeps the fence alive while we are waiting on it
+			TUniqueFunction<void()> Callback;
+			HANDLE Event = nullptr;
+			HANDLE WaitHandle = nullptr;
+			std::atomic<int32> NumReferences = 2;
+
+			FCopyDoneWait(TSharedRef<FTouchFenceCache::FFenceData> InFence, TUniqueFunction<void()>&& InCallback)
+				: Fence(MoveTemp(InFence))
+				, Callback(MoveTemp(InCallback))
+			{}
+
+			void ReleaseReference()
+			{
+				if (--NumReferences == 0)
+				{
+					if (WaitHandle)
+					{
+						UnregisterWait(WaitHandle);
+					}
+					if (Event)
+					{
+						CloseHandle(Event);
+					}
+					delete this;
+				}
+			}
+
+			static void CALLBACK OnFenceSignaled(void* Context, BOOLEAN bTimedOut)
+			{
+				FCopyDoneWait* Wait = static_cast<FCopyDoneWait*>(Context);
+				UE_CLOG(bTimedOut, LogTouchEngineD3D12RHI, Warning, TEXT("[FTouchImportTextureD3D12::OnCurrentCopyDone_RenderThread] Timed out waiting for the copy to be done for fence value %llu"), Wait->Fence->LastValue);
+				Wait->Callback();
+				Wait->Callback.Reset(); // release what the callback captured as soon as possible
+				Wait->ReleaseReference();
+			}
+		};
+	}
+	
 	TSharedPtr<FTouchImportTextureD3D12> FTouchImportTextureD3D12::CreateTexture_RenderThread(ID3D12Device* Device, const TED3DSharedTexture* Shared, TSharedRef<FTouchFenceCache> FenceCache)
 	{
 		DECLARE_SCOPE_CYCLE_COUNTER(TEXT("      III.A.2.a [RT] Link Texture Import - CreateTexture"), STAT_TE_III_A_2_a_D3D, STATGROUP_TouchEngine);
@@ -89,11 +137,37 @@ namespace UE::TouchEngine::D3DX12
 		return Result;
 	}
 
-	bool FTouchImportTextureD3D12::IsCurrentCopyDone()
+	bool FTouchImportTextureD3D12::IsCurrentCopyDone() const
 	{
 		return (ReleaseMutexSemaphore->NativeFence.Get() && ReleaseMutexSemaphore->NativeFence->GetCompletedValue() >= ReleaseMutexSemaphore->LastValue);
 	}
 
+	void FTouchImportTextureD3D12::OnCurrentCopyDone_RenderThread(FRHICommandListImmediate& RHICmdList, TUniqueFunction<void()>&& Callback)
+	{
+		// LastValue has been set in ReleaseMutex_RenderThread, and the fence will be signaled with it once the copy has been executed on the GPU
+		ID3D12Fence* NativeFence = ReleaseMutexSemaphore->NativeFence.Get();
+		const uint64 WaitValue = ReleaseMutexSemaphore->LastValue;
+		if (!NativeFence || NativeFence->GetCompletedValue() >= WaitValue)
+		{
+			Callback();
+			return;
+		}
+
+		// We let the Windows thread pool wait for the fence event, so no thread is blocked or polling while the copy is in flight
+		Private::FCopyDoneWait* Wait = new Private::FCopyDoneWait(ReleaseMutexSemaphore, MoveTemp(Callback));
+		Wait->Event = CreateEvent(nullptr, false, false, nullptr);
+		if (!Wait->Event || FAILED(NativeFence->SetEventOnCompletion(WaitValue, Wait->Event))
+			|| !RegisterWaitForSingleObject(&Wait->WaitHandle, Wait->Event, &Private::FCopyDoneWait::OnFenceSignaled, Wait, Private::CopyDoneTimeoutMs, WT_EXECUTEONLYONCE))
+		{
+			UE_LOG(LogTouchEngineD3D12RHI, Warning, TEXT("[FTouchImportTextureD3D12::OnCurrentCopyDone_RenderThread] Unable to wait for the fence event (GetLastError(): %d), executing the callback now"), GetLastError());
+			Wait->WaitHandle = nullptr;
+			Wait->Callback();
+			Wait->Callback.Reset();
+			Wait->ReleaseReference(); // the reference of the callback which will never be called
+		}
+		Wait->ReleaseReference();
+	}
+
 	bool FTouchImportTextureD3D12::AcquireMutex(const FTouchCopyTextureArgs& CopyArgs, const TouchObject<TESemaphore>& Semaphore, uint64 WaitValue)
 	{
 		if (const TComPtr<ID3D12Fence> Fence = FenceCache->GetOrCreateSharedFence(Semaphore))
@@ -108,18 +182,24 @@ namespace UE::TouchEngine::D3DX12
 		return false;
 	}
 
-	void FTouchImportTextureD3D12::ReleaseMutex_RenderThread(const FTouchCopyTextureArgs& CopyArgs, const TouchObject<TESemaphore>& Semaphore, FTexture2DRHIRef& SourceTexture)
+	void FTouchImportTextureD3D12::ReleaseMutex_RenderThread(const FTouchCopyTextureArgs& CopyArgs, const TouchObject<TESemaphore>& Semaphore, FTexture2DRHIRef& SourceTexture, const TSharedRef<FTouchTextureImporter>& Importer)
 	{
 		ReleaseMutexSemaphore.Get().LastValue = ReleaseMutexSemaphore.Get().NativeFence->GetCompletedValue() + 1;
 		
-		CopyArgs.RHICmdList.EnqueueLambda([CopyArgs, Fence = ReleaseMutexSemaphore.ToSharedPtr(), SourceTexture, DestTexture = CopyArgs.TargetRHI](FRHICommandListImmediate& RHICommandList)
+		CopyArgs.RHICmdList.EnqueueLambda([CopyArgs, Fence = ReleaseMutexSemaphore.ToSharedPtr(), SourceTexture, DestTexture = CopyArgs.TargetRHI, WeakImporter = Importer.ToWeakPtr()](FRHICommandListImmediate& RHICommandList)
 		{
 			ID3D12DynamicRHI* RHI = GetID3D12DynamicRHI();
 			if (Fence && Fence->NativeFence.Get() && RHI)
 			{
 				UE_LOG(LogTouchEngineD3D12RHI, Verbose, TEXT("ReleaseMutex_RenderThread  => NativeFence Valid? %s , Address: %p, WaitValue: %llu"), Fence->NativeFence.Get() ? TEXT("Non Null") : TEXT("NULL"), Fence->NativeFence.GetAddressOf(), Fence->LastValue+1);
 				RHI->RHISignalManualFence(RHICommandList, Fence->NativeFence.Get(), Fence->LastValue);
-				TEInstanceAddTextureTransfer(CopyArgs.RequestParams.Instance, CopyArgs.RequestParams.TETexture.get(), Fence->TouchFence, Fence->LastValue);
+				const TEResult Result = TEInstanceAddTextureTransfer(CopyArgs.RequestParams.Instance, CopyArgs.RequestParams.TETexture.get(), Fence->TouchFence, Fence->LastValue);
+				const TSharedPtr<FTouchTextureImporter> ImporterPin = WeakImporter.Pin();
+				if (Result == TEResultSuccess && ImporterPin)
+				{
+					// The fence value only ever increases, so getting this transfer back means TouchEngine did not write to the texture since this copy
+					ImporterPin->OnTextureTransferReturned_AnyThread(CopyArgs.RequestParams, Fence->TouchFence, Fence->LastValue);
+				}
 			}
 		});
 		
@@ -51,15 +51,18 @@ namespace UE::TouchEngine::D3DX12
 		
 		//~ Begin ITouchPlatformTexture Interface
 		virtual FTextureMetaData GetTextureMetaData() const override;
-		virtual bool IsCurrentCopyDone() override;
+		virtual void OnCurrentCopyDone_RenderThread(FRHICommandListImmediate& RHICmdList, TUniqueFunction<void()>&& Callback) override;
 		//~ End ITouchPlatformTexture Interface
+
+		/** Check if the internal semaphore for the end of the copy has been signaled, which would mean that this texture can be safely deleted */
+		bool IsCurrentCopyDone() const;
 		
 	protected:
 
 		//~ Begin FTouchPlatformTexture_AcquireOnRenderThread Interface
 		virtual bool AcquireMutex(const FTouchCopyTextureArgs& CopyArgs, const TouchObject<TESemaphore>& Semaphore, uint64 WaitValue) override;
 		virtual FTexture2DRHIRef ReadTextureDuringMutex() override { return DestTextureRHI; }
-		virtual void ReleaseMutex_RenderThread(const FTouchCopyTextureArgs& CopyArgs, const TouchObject<TESemaphore>& Semaphore, FTexture2DRHIRef& SourceTexture) override;
+		virtual void ReleaseMutex_RenderThread(const FTouchCopyTextureArgs& CopyArgs, const TouchObject<TESemaphore>& Semaphore, FTexture2DRHIRef& SourceTexture, const TSharedRef<FTouchTextureImporter>& Importer) override;
 		virtual void CopyTexture_RenderThread(FRHICommandListImmediate& RHICmdList, const FTexture2DRHIRef SrcTexture, const FTexture2DRHIRef DstTexture, TSharedRef<FTouchTextureImporter> Importer) override;
 		//~ End FTouchPlatformTexture_AcquireOnRenderThread Interface
 
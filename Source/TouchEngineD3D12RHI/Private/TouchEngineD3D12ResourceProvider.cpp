@@ -74,6 +74,12 @@ namespace UE::TouchEngine::D3DX12
 		virtual TFuture<FTouchSuspendResult> SuspendAsyncTasks_GameThread() override;
 		virtual bool SetExportedTexturePoolSize(int ExportedTexturePoolSize) override;
 		virtual bool SetImportedTexturePoolSize(int ImportedTexturePoolSize) override;
+		virtual bool SetExportedTexturePoolBudget(int64 ExportedTexturePoolBudgetBytes) override;
+		virtual bool SetImportedTexturePoolBudget(int64 ImportedTexturePoolBudgetBytes) override;
+		virtual bool SetExportedTexturePoolAdaptiveSizing(bool bEnabled, int32 MinPoolSize) override;
+		virtual bool SetImportedTexturePoolAdaptiveSizing(bool bEnabled, int32 MinPoolSize) override;
+		virtual bool PrewarmExportedTexturePool_GameThread(const TArray<FTouchEngineTextureDescriptor>& Descriptors) override;
+		virtual TArray<FTouchEngineTextureDescriptor> GetObservedExportedTextureDescriptors() override;
 
 	protected:
 		virtual FTouchTextureImporter& GetImporter() override { return TextureImporter.Get(); }
@@ -241,4 +247,39 @@ namespace UE::TouchEngine::D3DX12
 		TextureImporter->PoolSize = FMath::Max(ImportedTexturePoolSize, 0);
 		return true;
 	}
+
+	bool FTouchEngineD3X12ResourceProvider::SetExportedTexturePoolBudget(int64 ExportedTexturePoolBudgetBytes)
+	{
+		TextureExporter->PoolBudgetBytes = FMath::Max<int64>(ExportedTexturePoolBudgetBytes, 0);
+		return true;
+	}
+
+	bool FTouchEngineD3X12ResourceProvider::SetImportedTexturePoolBudget(int64 ImportedTexturePoolBudgetBytes)
+	{
+		TextureImporter->PoolBudgetBytes = FMath::Max<int64>(ImportedTexturePoolBudgetBytes, 0);
+		return true;
+	}
+
+	bool FTouchEngineD3X12ResourceProvider::SetExportedTexturePoolAdaptiveSizing(bool bEnabled, int32 MinPoolSize)
+	{
+		TextureExporter->SetAdaptivePoolSize(bEnabled, MinPoolSize);
+		return true;
+	}
+
+	bool FTouchEngineD3X12ResourceProvider::SetImportedTexturePoolAdaptiveSizing(bool bEnabled, int32 MinPoolSize)
+	{
+		TextureImporter->SetAdaptivePoolSize(bEnabled, MinPoolSize);
+		return true;
+	}
+
+	bool FTouchEngineD3X12ResourceProvider::PrewarmExportedTexturePool_GameThread(const TArray<FTouchEngineTextureDescriptor>& Descriptors)
+	{
+		TextureExporter->PrewarmPool(Descriptors);
+		return true;
+	}
+
+	TArray<FTouchEngineTextureDescriptor> FTouchEngineD3X12ResourceProvider::GetObservedExportedTextureDescriptors()
+	{
+		return TextureExporter->GetObservedDescriptors();
+	}
 }
@@ -0,0 +1,174 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#include "Benchmark/TouchEngineBenchmarkUtils.h"
+
+#include "Async/TaskGraphInterfaces.h"
+#include "Containers/Ticker.h"
+#include "Engine/World.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CoreDelegates.h"
+#include "RenderingThread.h"
+#include "Rendering/Importing/TouchTextureReadback.h"
+
+#include <atomic>
+
+namespace UE::TouchEngine::Benchmark
+{
+	namespace Private
+	{
+		/** Forwards everything to the allocator it wraps, counting the allocations on the way */
+		class FCountingMalloc final : public FMalloc
+		{
+		public:
+
+			void Install()
+			{
+				check(!bIsInstalled);
+				Inner = GMalloc;
+				GMalloc = this;
+				bIsInstalled = true;
+			}
+
+			void Uninstall()
+			{
+				check(bIsInstalled && GMalloc == this);
+				// Inner is kept valid, other threads might still be calling into this allocator
+				GMalloc = Inner;
+				bIsInstalled = false;
+			}
+
+			uint64 GetAllocationCount() const { return AllocationCount.load(std::memory_order_relaxed); }
+			uint64 GetAllocatedBytes() const { return AllocatedBytes.load(std::memory_order_relaxed); }
+
+			//~ Begin FMalloc Interface
+			virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+			{
+				CountAllocation(Count);
+				return Inner->Malloc(Count, Alignment);
+			}
+			virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override
+			{
+				CountAllocation(Count);
+				return Inner->TryMalloc(Count, Alignment);
+			}
+			virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+			{
+				CountAllocation(Count);
+				return Inner->Realloc(Original, Count, Alignment);
+			}
+			virtual void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override
+			{
+				CountAllocation(Count);
+				return Inner->TryRealloc(Original, Count, Alignment);
+			}
+			virtual void Free(void* Original) override { Inner->Free(Original); }
+			virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return Inner->QuantizeSize(Count, Alignment); }
+			virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+			virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+			virtual void SetupTLSCachesOnCurrentThread() override { Inner->SetupTLSCachesOnCurrentThread(); }
+			virtual void ClearAndDisableTLSCachesOnCurrentThread() override { Inner->ClearAndDisableTLSCachesOnCurrentThread(); }
+			virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+			virtual bool ValidateHeap() override { return Inner->ValidateHeap(); }
+			virtual const TCHAR* GetDescriptiveName() override { return Inner->GetDescriptiveName(); }
+			//~ End FMalloc Interface
+
+		private:
+			FMalloc* Inner = nullptr;
+			bool bIsInstalled = false;
+			std::atomic<uint64> AllocationCount = 0;
+			std::atomic<uint64> AllocatedBytes = 0;
+
+			void CountAllocation(SIZE_T Count)
+			{
+				if (Count > 0)
+				{
+					AllocationCount.fetch_add(1, std::memory_order_relaxed);
+					AllocatedBytes.fetch_add(Count, std::memory_order_relaxed);
+				}
+			}
+		};
+
+		/** Never destroyed, as other threads might keep calling into it after it was uninstalled */
+		static FCountingMalloc& GetCountingMalloc()
+		{
+			static FCountingMalloc* CountingMalloc = new FCountingMalloc();
+			return *CountingMalloc;
+		}
+	}
+
+	FScopedAllocationCounter::FScopedAllocationCounter()
+	{
+		Private::FCountingMalloc& CountingMalloc = Private::GetCountingMalloc();
+		CountingMalloc.Install();
+		StartAllocationCount = CountingMalloc.GetAllocationCount();
+		StartAllocatedBytes = CountingMalloc.GetAllocatedBytes();
+	}
+
+	FScopedAllocationCounter::~FScopedAllocationCounter()
+	{
+		Private::GetCountingMalloc().Uninstall();
+	}
+
+	uint64 FScopedAllocationCounter::GetAllocationCount() const
+	{
+		return Private::GetCountingMalloc().GetAllocationCount() - StartAllocationCount;
+	}
+
+	uint64 FScopedAllocationCounter::GetAllocatedBytes() const
+	{
+		return Private::GetCountingMalloc().GetAllocatedBytes() - StartAllocatedBytes;
+	}
+
+	double ComputePercentile(TArray<double>& Values, double Percentile)
+	{
+		if (Values.IsEmpty())
+		{
+			return 0.0;
+		}
+
+		Values.Sort();
+		const int32 Index = FMath::Clamp(FMath::CeilToInt32(Percentile * Values.Num()) - 1, 0, Values.Num() - 1);
+		return Values[Index];
+	}
+
+	double TickWorld(UWorld& World, float DeltaTime)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+
+		FCoreDelegates::OnBeginFrame.Broadcast();
+		// The engine loop polls the TOP readbacks at the start of each render thread frame, which commandlets do not run
+		ENQUEUE_RENDER_COMMAND(TouchEngineBenchmarkProcessReadbacks)([](FRHICommandListImmediate&)
+		{
+			FTouchTextureReadback::ProcessAllReadbacks_RenderThread();
+		});
+		FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+		FTSTicker::GetCoreTicker().Tick(DeltaTime);
+		World.Tick(LEVELTICK_All, DeltaTime);
+		FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+		FCoreDelegates::OnEndFrame.Broadcast();
+		++GFrameCounter;
+
+		return FPlatformTime::Seconds() - StartTime;
+	}
+
+	void FlushReadbacks()
+	{
+		ENQUEUE_RENDER_COMMAND(TouchEngineBenchmarkFlushReadbacks)([](FRHICommandListImmediate& RHICmdList)
+		{
+			FTouchTextureReadback::FlushAllReadbacks_RenderThread(RHICmdList);
+		});
+	}
+}
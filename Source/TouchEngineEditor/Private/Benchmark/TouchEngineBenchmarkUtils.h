@@ -0,0 +1,50 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UWorld;
+
+namespace UE::TouchEngine::Benchmark
+{
+	/**
+	 * Counts the allocations made through GMalloc, on all threads, while it is in scope.
+	 * It temporarily wraps GMalloc, so only one can exist at a time.
+	 */
+	class FScopedAllocationCounter : public FNoncopyable
+	{
+	public:
+		FScopedAllocationCounter();
+		~FScopedAllocationCounter();
+
+		/** The number of allocations (Malloc and Realloc calls) since this counter was created */
+		uint64 GetAllocationCount() const;
+		/** The number of bytes requested by those allocations */
+		uint64 GetAllocatedBytes() const;
+
+	private:
+		uint64 StartAllocationCount;
+		uint64 StartAllocatedBytes;
+	};
+
+	/** Returns the value at the given percentile (between 0 and 1). Sorts the values in place. */
+	double ComputePercentile(TArray<double>& Values, double Percentile);
+
+	/** Ticks the world once, as the engine loop would, and returns the time spent on the game thread */
+	double TickWorld(UWorld& World, float DeltaTime);
+	/** Enqueues a render command waiting for the GPU and delivering all the TOP readbacks in flight. Blocks the render thread, not the game thread */
+	void FlushReadbacks();
+}
@@ -0,0 +1,537 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#include "Benchmark/TouchEngineCookBenchmarkCommandlet.h"
+
+#include "TouchEngineEditorLog.h"
+#include "Benchmark/TouchEngineBenchmarkUtils.h"
+#include "Blueprint/TouchEngineComponent.h"
+#include "Engine/TouchEngine.h"
+#include "Engine/TouchEngineInfo.h"
+#include "Rendering/Headless/TouchResourceProviderHeadless.h"
+#include "Rendering/Importing/TouchTextureReadback.h"
+#include "ToxAsset.h"
+
+#include "Async/TaskGraphInterfaces.h"
+#include "Containers/Ticker.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/WorldSettings.h"
+#include "DynamicRHI.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "RenderingThread.h"
+
+namespace UE::TouchEngine::Benchmark
+{
+	/** How long we wait for the components to load the tox before giving up */
+	static constexpr double LoadTimeoutSeconds = 30.0;
+	/** How long we wait for the last cooks to finish after the measured ticks */
+	static constexpr double DrainTimeoutSeconds = 5.0;
+	/** The number of readback flushes without any new readback after which we consider all the readbacks of the last cooks delivered */
+	static constexpr int32 ReadbackIdleFlushes = 3;
+	/** The number of ticks -CheckImportPool imports each texture size for */
+	static constexpr int32 ImportPoolCheckTicks = 30;
+}
+
+UTouchEngineCookBenchmarkCommandlet::UTouchEngineCookBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+	ShowErrorCount = true;
+	HelpDescription = TEXT("Measures the game thread cost, latency, dropped frames and allocations of TouchEngine cooks in each cook mode.");
+	HelpUsage = TEXT("-run=TouchEngineCookBenchmark -Tox=<path> [-Components=4] [-Cooks=600] [-Warmup=60] [-TickRate=60] [-Modes=Synchronized,DelayedSynchronized,Independent] [-Csv=<path>] [-Readback=<TOP outputs>] [-CheckImportPool]");
+}
+
+int32 UTouchEngineCookBenchmarkCommandlet::Main(const FString& Params)
+{
+	using namespace UE::TouchEngine;
+
+	// 1. Parse the arguments
+	FString ToxPath;
+	if (!FParse::Value(*Params, TEXT("Tox="), ToxPath) || !FPaths::FileExists(ToxPath))
+	{
+		UE_LOG(LogTouchEngineEditor, Error, TEXT("[UTouchEngineCookBenchmarkCommandlet] A valid -Tox=<path> is required. Usage: %s"), *HelpUsage);
+		return 1;
+	}
+
+	int32 NumComponents = 4;
+	int32 NumCooks = 600;
+	int32 NumWarmupCooks = 60;
+	float TickRate = 60.f;
+	FString ModesString = TEXT("Synchronized,DelayedSynchronized,Independent");
+	FString CsvPath;
+	FString ReadbackString;
+	FParse::Value(*Params, TEXT("Components="), NumComponents);
+	FParse::Value(*Params, TEXT("Cooks="), NumCooks);
+	FParse::Value(*Params, TEXT("Warmup="), NumWarmupCooks);
+	FParse::Value(*Params, TEXT("TickRate="), TickRate);
+	FParse::Value(*Params, TEXT("Modes="), ModesString, false);
+	FParse::Value(*Params, TEXT("Csv="), CsvPath);
+	FParse::Value(*Params, TEXT("Readback="), ReadbackString, false);
+	ReadbackString.ParseIntoArray(ReadbackOutputs, TEXT(","));
+	bCheckImportPool = FParse::Param(*Params, TEXT("CheckImportPool"));
+	for (FString& ReadbackOutput : ReadbackOutputs)
+	{
+		ReadbackOutput.TrimStartAndEndInline();
+	}
+	NumComponents = FMath::Max(NumComponents, 1);
+	NumCooks = FMath::Max(NumCooks, 1);
+	NumWarmupCooks = FMath::Max(NumWarmupCooks, 0);
+
+	TArray<ETouchEngineCookMode> CookModes;
+	TArray<FString> ModeNames;
+	ModesString.ParseIntoArray(ModeNames, TEXT(","));
+	for (const FString& ModeName : ModeNames)
+	{
+		const int64 Value = StaticEnum<ETouchEngineCookMode>()->GetValueByNameString(ModeName.TrimStartAndEnd());
+		if (Value == INDEX_NONE || Value >= static_cast<int64>(ETouchEngineCookMode::Max))
+		{
+			UE_LOG(LogTouchEngineEditor, Error, TEXT("[UTouchEngineCookBenchmarkCommandlet] Unknown cook mode `%s`"), *ModeName);
+			return 1;
+		}
+		CookModes.Add(static_cast<ETouchEngineCookMode>(Value));
+	}
+
+	// 2. Create a game world for the components to live in. There is no game mode, so we begin play ourselves
+	ToxAsset = NewObject<UToxAsset>(GetTransientPackage());
+	ToxAsset->SetFilePath(FPaths::ConvertRelativePathToFull(ToxPath));
+
+	World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("TouchEngineCookBenchmark"));
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+	World->InitializeActorsForPlay(FURL());
+	World->BeginPlay();
+	World->GetWorldSettings()->NotifyBeginPlay();
+
+	// 3. Run each cook mode
+	TArray<FModeResults> Results;
+	bool bSucceeded = true;
+	for (const ETouchEngineCookMode CookMode : CookModes)
+	{
+		UE_LOG(LogTouchEngineEditor, Display, TEXT("[UTouchEngineCookBenchmarkCommandlet] Running %d cooks on %d components in %s mode..."), NumCooks, NumComponents, *UEnum::GetValueAsString(CookMode));
+		FModeResults& ModeResults = Results.AddDefaulted_GetRef();
+		if (!RunCookMode(CookMode, NumComponents, NumCooks, NumWarmupCooks, TickRate, ModeResults))
+		{
+			Results.Pop();
+			bSucceeded = false;
+		}
+		else if (!ReadbackOutputs.IsEmpty() && (ModeResults.ReadbacksDelivered == 0 || ModeResults.ReadbacksOutOfOrder > 0))
+		{
+			UE_LOG(LogTouchEngineEditor, Error, TEXT("[UTouchEngineCookBenchmarkCommandlet] %d readbacks were delivered in %s mode, %d of them out of order"),
+				ModeResults.ReadbacksDelivered, *UEnum::GetValueAsString(CookMode), ModeResults.ReadbacksOutOfOrder);
+			bSucceeded = false;
+		}
+		else if (bCheckImportPool && ModeResults.ImportPoolMisses > 0)
+		{
+			UE_LOG(LogTouchEngineEditor, Error, TEXT("[UTouchEngineCookBenchmarkCommandlet] The imported texture pool needed %lld new textures after the warmup in %s mode"),
+				ModeResults.ImportPoolMisses, *UEnum::GetValueAsString(CookMode));
+			bSucceeded = false;
+		}
+	}
+
+	// 4. Clean up and report
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	World = nullptr;
+
+	LogResults(Results);
+	if (!CsvPath.IsEmpty() && !WriteCsv(CsvPath, Results))
+	{
+		UE_LOG(LogTouchEngineEditor, Error, TEXT("[UTouchEngineCookBenchmarkCommandlet] Unable to write the results to `%s`"), *CsvPath);
+		bSucceeded = false;
+	}
+	return bSucceeded ? 0 : 1;
+}
+
+void UTouchEngineCookBenchmarkCommandlet::OnEndFrame(bool bIsSuccessful, ECookFrameResult Result, const FTouchEngineOutputFrameData& FrameData)
+{
+	if (!bIsMeasuring)
+	{
+		return;
+	}
+
+	Latencies.Add(FrameData.Latency);
+	TickLatencySum += FrameData.TickLatency;
+	FramesDropped += FrameData.bWasFrameDropped ? 1 : 0;
+	++ResultCounts[static_cast<int32>(Result)];
+}
+
+bool UTouchEngineCookBenchmarkCommandlet::RunCookMode(ETouchEngineCookMode CookMode, int32 NumComponents, int32 NumCooks, int32 NumWarmupCooks, float TickRate, FModeResults& OutResults)
+{
+	using namespace UE::TouchEngine::Benchmark;
+	const float DeltaTime = TickRate > 0.f ? 1.f / TickRate : 1.f / 60.f;
+
+	// 1. Load the components and let the texture pools and variable containers settle
+	if (!SpawnComponents(CookMode, NumComponents, TickRate))
+	{
+		DestroyComponents(TickRate);
+		return false;
+	}
+	for (int32 Warmup = 0; Warmup < NumWarmupCooks; ++Warmup)
+	{
+		const double TickStartTime = FPlatformTime::Seconds();
+		TickWorld(DeltaTime);
+		PaceTick(TickStartTime, TickRate);
+	}
+
+	// 2. Measure. Every loaded component starts a new cook on every tick
+	Latencies.Reset(NumCooks * NumComponents);
+	TickLatencySum = 0;
+	FramesDropped = 0;
+	ResultCounts.Init(0, static_cast<int32>(ECookFrameResult::Count));
+	ReadbackCounts = MakeShared<FReadbackCounts, ESPMode::ThreadSafe>();
+	AddReadbackListeners();
+	const UE::TouchEngine::FTouchTexturePoolCounters ImportPoolCountersBefore = GetImportPoolCounters();
+	TArray<double> TickTimes;
+	TickTimes.Reserve(NumCooks);
+	{
+		bIsMeasuring = true;
+		FScopedAllocationCounter AllocationCounter;
+		for (int32 Cook = 0; Cook < NumCooks; ++Cook)
+		{
+			const double TickStartTime = FPlatformTime::Seconds();
+			TickTimes.Add(TickWorld(DeltaTime));
+			PaceTick(TickStartTime, TickRate);
+		}
+
+		// Let the last cooks come back, they were started during the measure
+		const double DrainStartTime = FPlatformTime::Seconds();
+		while (Latencies.Num() < NumCooks * NumComponents && FPlatformTime::Seconds() - DrainStartTime < DrainTimeoutSeconds)
+		{
+			FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+			FTSTicker::GetCoreTicker().Tick(DeltaTime);
+			FPlatformProcess::SleepNoStats(0.001f);
+		}
+		DrainReadbacks();
+		bIsMeasuring = false;
+		const UE::TouchEngine::FTouchTexturePoolCounters ImportPoolCountersAfter = GetImportPoolCounters();
+		OutResults.ImportPoolHits = ImportPoolCountersAfter.Hits - ImportPoolCountersBefore.Hits;
+		OutResults.ImportPoolMisses = ImportPoolCountersAfter.Misses - ImportPoolCountersBefore.Misses;
+
+		OutResults.Allocations = AllocationCounter.GetAllocationCount();
+		OutResults.AllocatedBytes = AllocationCounter.GetAllocatedBytes();
+	}
+
+	// 3. Gather the results
+	OutResults.CookMode = CookMode;
+	OutResults.Components = NumComponents;
+	OutResults.Ticks = NumCooks;
+	OutResults.CooksStarted = NumCooks * NumComponents;
+	OutResults.CooksFinished = Latencies.Num();
+	for (const double TickTime : TickTimes)
+	{
+		OutResults.GameThreadSeconds += TickTime;
+	}
+	OutResults.GameThreadTickP95 = ComputePercentile(TickTimes, 0.95);
+	if (!Latencies.IsEmpty())
+	{
+		double LatencySum = 0.0;
+		for (const double Latency : Latencies)
+		{
+			LatencySum += Latency;
+		}
+		OutResults.LatencyMean = LatencySum / Latencies.Num();
+		OutResults.TickLatencyMean = static_cast<double>(TickLatencySum) / Latencies.Num();
+		OutResults.LatencyP50 = ComputePercentile(Latencies, 0.5);
+		OutResults.LatencyP95 = ComputePercentile(Latencies, 0.95);
+		OutResults.LatencyMax = Latencies.Last();
+	}
+	OutResults.FramesDropped = FramesDropped;
+	OutResults.ResultCounts = ResultCounts;
+	{
+		FScopeLock Lock(&ReadbackCounts->Mutex);
+		OutResults.ReadbacksDelivered = ReadbackCounts->Delivered;
+		OutResults.ReadbacksOutOfOrder = ReadbackCounts->OutOfOrder;
+	}
+
+	const bool bImportPoolChecked = !bCheckImportPool || CheckImportPool(OutResults, TickRate);
+	DestroyComponents(TickRate);
+	return bImportPoolChecked;
+}
+
+bool UTouchEngineCookBenchmarkCommandlet::SpawnComponents(ETouchEngineCookMode CookMode, int32 NumComponents, float TickRate)
+{
+	for (int32 Index = 0; Index < NumComponents; ++Index)
+	{
+		AActor* Actor = World->SpawnActor<AActor>();
+		UTouchEngineComponentBase* Component = NewObject<UTouchEngineComponentBase>(Actor);
+		Component->ToxAsset = ToxAsset;
+		Component->CookMode = CookMode;
+		Component->TEFrameRate = TickRate > 0.f ? TickRate : 60.0;
+		Component->ReadbackTOPOutputs = ReadbackOutputs;
+		Component->OnEndFrame.AddDynamic(this, &UTouchEngineCookBenchmarkCommandlet::OnEndFrame);
+		Actor->AddInstanceComponent(Component);
+		Component->RegisterComponent(); // The world has begun play, so this calls BeginPlay, which loads the tox
+		Components.Add(Component);
+	}
+
+	const float DeltaTime = TickRate > 0.f ? 1.f / TickRate : 1.f / 60.f;
+	const double LoadStartTime = FPlatformTime::Seconds();
+	while (FPlatformTime::Seconds() - LoadStartTime < UE::TouchEngine::Benchmark::LoadTimeoutSeconds)
+	{
+		TickWorld(DeltaTime);
+
+		bool bAllLoaded = true;
+		for (const UTouchEngineComponentBase* Component : Components)
+		{
+			if (Component->HasFailedLoad())
+			{
+				UE_LOG(LogTouchEngineEditor, Error, TEXT("[UTouchEngineCookBenchmarkCommandlet] The tox `%s` failed to load"), *ToxAsset->GetAbsoluteFilePath());
+				return false;
+			}
+			bAllLoaded &= Component->IsLoaded();
+		}
+		if (bAllLoaded)
+		{
+			return true;
+		}
+		FPlatformProcess::SleepNoStats(0.001f);
+	}
+
+	UE_LOG(LogTouchEngineEditor, Error, TEXT("[UTouchEngineCookBenchmarkCommandlet] Timed out while loading `%s`"), *ToxAsset->GetAbsoluteFilePath());
+	return false;
+}
+
+void UTouchEngineCookBenchmarkCommandlet::DestroyComponents(float TickRate)
+{
+	for (int32 Index = 0; Index < Components.Num(); ++Index)
+	{
+		UTouchEngineComponentBase* Component = Components[Index];
+		if (IsValid(Component))
+		{
+			if (ReadbackListenerHandles.IsValidIndex(Index) && Component->EngineInfo && Component->EngineInfo->Engine)
+			{
+				Component->EngineInfo->Engine->RemoveTOPReadbackListener(ReadbackListenerHandles[Index]);
+			}
+			Component->OnEndFrame.RemoveAll(this);
+			Component->GetOwner()->Destroy(); // Ends play, which closes the TouchEngine instance
+		}
+	}
+	Components.Reset();
+	ReadbackListenerHandles.Reset();
+
+	// Let the pending game thread tasks of the closed instances run
+	const float DeltaTime = TickRate > 0.f ? 1.f / TickRate : 1.f / 60.f;
+	for (int32 Tick = 0; Tick < 10; ++Tick)
+	{
+		TickWorld(DeltaTime);
+	}
+}
+
+void UTouchEngineCookBenchmarkCommandlet::AddReadbackListeners()
+{
+	using namespace UE::TouchEngine;
+	ReadbackListenerHandles.Reset();
+	if (ReadbackOutputs.IsEmpty())
+	{
+		return;
+	}
+
+	for (const UTouchEngineComponentBase* Component : Components)
+	{
+		FDelegateHandle Handle;
+		if (Component->EngineInfo && Component->EngineInfo->Engine)
+		{
+			Handle = Component->EngineInfo->Engine->AddTOPReadbackListener(FOnTouchTextureReadback::FDelegate::CreateLambda(
+				[Counts = ReadbackCounts, Key = static_cast<const void*>(Component)](const FTouchTextureReadbackData& Readback)
+				{
+					// The readbacks of an output are expected to come in the order of the cooks which produced them
+					FScopeLock Lock(&Counts->Mutex);
+					int64& LastFrameID = Counts->LastFrameIDs.FindOrAdd({Key, Readback.Identifier}, -1);
+					Counts->OutOfOrder += Readback.FrameID <= LastFrameID ? 1 : 0;
+					LastFrameID = Readback.FrameID;
+					++Counts->Delivered;
+				}));
+		}
+		ReadbackListenerHandles.Add(Handle);
+	}
+}
+
+void UTouchEngineCookBenchmarkCommandlet::DrainReadbacks()
+{
+	using namespace UE::TouchEngine::Benchmark;
+	if (ReadbackOutputs.IsEmpty())
+	{
+		return;
+	}
+
+	// Each flush delivers all the readbacks enqueued so far, but the copies of the last cooks can still be on their way to the render thread,
+	// so we keep flushing until they stop coming
+	const double DrainStartTime = FPlatformTime::Seconds();
+	int32 IdleFlushes = 0;
+	int32 LastDelivered = -1;
+	while (IdleFlushes < ReadbackIdleFlushes && FPlatformTime::Seconds() - DrainStartTime < DrainTimeoutSeconds)
+	{
+		FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+		FlushReadbacks();
+		FlushRenderingCommands();
+		FScopeLock Lock(&ReadbackCounts->Mutex);
+		IdleFlushes = ReadbackCounts->Delivered == LastDelivered ? IdleFlushes + 1 : 0;
+		LastDelivered = ReadbackCounts->Delivered;
+	}
+}
+
+UE::TouchEngine::FTouchTexturePoolCounters UTouchEngineCookBenchmarkCommandlet::GetImportPoolCounters() const
+{
+	UE::TouchEngine::FTouchTexturePoolCounters Sum;
+	for (const UTouchEngineComponentBase* Component : Components)
+	{
+		UE::TouchEngine::FTouchTexturePoolCounters Counters;
+		if (Component->EngineInfo && Component->EngineInfo->Engine && Component->EngineInfo->Engine->GetImportedTexturePoolCounters(Counters))
+		{
+			Sum.Hits += Counters.Hits;
+			Sum.Misses += Counters.Misses;
+			Sum.Evictions += Counters.Evictions;
+			Sum.NumPooledTextures += Counters.NumPooledTextures;
+			Sum.NumBuckets += Counters.NumBuckets;
+		}
+	}
+	return Sum;
+}
+
+bool UTouchEngineCookBenchmarkCommandlet::CheckImportPool(const FModeResults& Results, float TickRate)
+{
+	using namespace UE::TouchEngine;
+	using namespace UE::TouchEngine::Benchmark;
+
+	// 1. Once warm, every import should have reused a pooled texture
+	if (Results.ImportPoolHits == 0)
+	{
+		UE_LOG(LogTouchEngineEditor, Error, TEXT("[UTouchEngineCookBenchmarkCommandlet] -CheckImportPool: nothing was imported in %s mode, the tox needs at least one TOP output"), *UEnum::GetValueAsString(Results.CookMode));
+		return false;
+	}
+
+	// 2. Without a GPU, the imported textures all have the size of TouchEngine.Headless.ImportedTextureSize, so we can make TouchEngine "resize" its outputs
+	IConsoleVariable* SizeCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("TouchEngine.Headless.ImportedTextureSize"));
+	if (!SizeCVar || FCString::Strcmp(GDynamicRHI->GetName(), Headless::NullRHIName) != 0)
+	{
+		UE_LOG(LogTouchEngineEditor, Display, TEXT("[UTouchEngineCookBenchmarkCommandlet] -CheckImportPool: not running with -nullrhi, skipping the texture size change"));
+		return true;
+	}
+
+	const float DeltaTime = TickRate > 0.f ? 1.f / TickRate : 1.f / 60.f;
+	const auto TickFor = [this, DeltaTime, TickRate](int32 NumTicks)
+	{
+		for (int32 Tick = 0; Tick < NumTicks; ++Tick)
+		{
+			const double TickStartTime = FPlatformTime::Seconds();
+			TickWorld(DeltaTime);
+			PaceTick(TickStartTime, TickRate);
+		}
+	};
+
+	const FString OriginalSize = SizeCVar->GetString();
+	FString Width, Height;
+	OriginalSize.Split(TEXT("x"), &Width, &Height);
+	const FString OtherSize = FString::Printf(TEXT("%dx%d"), FMath::Max(FCString::Atoi(*Width), 1) * 2, FMath::Max(FCString::Atoi(*Height), 1));
+	
+	SizeCVar->Set(*OtherSize, ECVF_SetByCode);
+	TickFor(ImportPoolCheckTicks);
+	SizeCVar->Set(*OriginalSize, ECVF_SetByCode);
+	TickFor(1); // the cooks started before the size changed back can still import the other size
+	
+	// 3. The textures of the original size are still pooled in their own bucket, so importing that size again should not need new textures
+	const FTouchTexturePoolCounters Before = GetImportPoolCounters();
+	TickFor(ImportPoolCheckTicks);
+	const FTouchTexturePoolCounters After = GetImportPoolCounters();
+	UE_LOG(LogTouchEngineEditor, Display, TEXT("[UTouchEngineCookBenchmarkCommandlet] -CheckImportPool: after importing %s and then %s again, %lld hits, %lld misses, %lld evictions, %d textures in %d buckets"),
+		*OtherSize, *OriginalSize, After.Hits - Before.Hits, After.Misses - Before.Misses, After.Evictions - Before.Evictions, After.NumPooledTextures, After.NumBuckets);
+	if (After.Misses > Before.Misses || After.Hits == Before.Hits)
+	{
+		UE_LOG(LogTouchEngineEditor, Error, TEXT("[UTouchEngineCookBenchmarkCommandlet] -CheckImportPool: importing %s again needed %lld new textures in %s mode"),
+			*OriginalSize, After.Misses - Before.Misses, *UEnum::GetValueAsString(Results.CookMode));
+		return false;
+	}
+	return true;
+}
+
+double UTouchEngineCookBenchmarkCommandlet::TickWorld(float DeltaTime)
+{
+	return UE::TouchEngine::Benchmark::TickWorld(*World, DeltaTime);
+}
+
+void UTouchEngineCookBenchmarkCommandlet::PaceTick(double TickStartTime, float TickRate)
+{
+	if (TickRate > 0.f)
+	{
+		const double Remaining = 1.0 / TickRate - (FPlatformTime::Seconds() - TickStartTime);
+		if (Remaining > 0.0)
+		{
+			FPlatformProcess::SleepNoStats(Remaining);
+		}
+	}
+}
+
+void UTouchEngineCookBenchmarkCommandlet::LogResults(const TArray<FModeResults>& Results)
+{
+	UE_LOG(LogTouchEngineEditor, Display, TEXT("[UTouchEngineCookBenchmarkCommandlet] ====== Results ======"));
+	for (const FModeResults& Result : Results)
+	{
+		const int32 CooksFinished = FMath::Max(Result.CooksFinished, 1);
+		UE_LOG(LogTouchEngineEditor, Display, TEXT("%s: %d components x %d cooks, %d/%d cooks finished"),
+			*UEnum::GetValueAsString(Result.CookMode), Result.Components, Result.Ticks, Result.CooksFinished, Result.CooksStarted);
+		UE_LOG(LogTouchEngineEditor, Display, TEXT("    Game thread:  %.2f us/cook   %.3f ms/tick (p95 %.3f ms)"),
+			Result.GameThreadSeconds * 1000000.0 / FMath::Max(Result.CooksStarted, 1), Result.GameThreadSeconds * 1000.0 / FMath::Max(Result.Ticks, 1), Result.GameThreadTickP95 * 1000.0);
+		UE_LOG(LogTouchEngineEditor, Display, TEXT("    Latency:      mean %.3f ms   p50 %.3f ms   p95 %.3f ms   max %.3f ms   mean %.2f ticks"),
+			Result.LatencyMean * 1000.0, Result.LatencyP50 * 1000.0, Result.LatencyP95 * 1000.0, Result.LatencyMax * 1000.0, Result.TickLatencyMean);
+		UE_LOG(LogTouchEngineEditor, Display, TEXT("    Frames:       %.2f%% dropped   %.2f%% inputs discarded   %d cancelled   %d failed"),
+			100.0 * Result.FramesDropped / CooksFinished,
+			100.0 * Result.ResultCounts[static_cast<int32>(ECookFrameResult::InputsDiscarded)] / CooksFinished,
+			Result.ResultCounts[static_cast<int32>(ECookFrameResult::Cancelled)],
+			CooksFinished - Result.ResultCounts[static_cast<int32>(ECookFrameResult::Success)] - Result.ResultCounts[static_cast<int32>(ECookFrameResult::InputsDiscarded)] - Result.ResultCounts[static_cast<int32>(ECookFrameResult::Cancelled)]);
+		if (Result.ReadbacksDelivered > 0 || Result.ReadbacksOutOfOrder > 0)
+		{
+			UE_LOG(LogTouchEngineEditor, Display, TEXT("    Readbacks:    %d delivered   %d out of order"), Result.ReadbacksDelivered, Result.ReadbacksOutOfOrder);
+		}
+		UE_LOG(LogTouchEngineEditor, Display, TEXT("    Import pool:  %lld hits   %lld misses"), Result.ImportPoolHits, Result.ImportPoolMisses);
+		UE_LOG(LogTouchEngineEditor, Display, TEXT("    Allocations:  %.1f allocs/cook   %.1f bytes/cook (all threads)"),
+			static_cast<double>(Result.Allocations) / FMath::Max(Result.CooksStarted, 1), static_cast<double>(Result.AllocatedBytes) / FMath::Max(Result.CooksStarted, 1));
+	}
+}
+
+bool UTouchEngineCookBenchmarkCommandlet::WriteCsv(const FString& CsvPath, const TArray<FModeResults>& Results)
+{
+	TArray<FString> Lines;
+	FString Header = TEXT("Mode,Components,Ticks,CooksStarted,CooksFinished,GameThreadUsPerCook,GameThreadMsPerTick,GameThreadMsPerTickP95,LatencyMeanMs,LatencyP50Ms,LatencyP95Ms,LatencyMaxMs,TickLatencyMean,FramesDropped,ReadbacksDelivered,ReadbacksOutOfOrder,ImportPoolHits,ImportPoolMisses,AllocationsPerCook,BytesPerCook");
+	for (int32 ResultIndex = 0; ResultIndex < static_cast<int32>(ECookFrameResult::Count); ++ResultIndex)
+	{
+		Header += TEXT(",") + StaticEnum<ECookFrameResult>()->GetNameStringByValue(ResultIndex);
+	}
+	Lines.Add(Header);
+
+	for (const FModeResults& Result : Results)
+	{
+		const double CooksStarted = FMath::Max(Result.CooksStarted, 1);
+		FString Line = FString::Printf(TEXT("%s,%d,%d,%d,%d,%f,%f,%f,%f,%f,%f,%f,%f,%d,%d,%d,%lld,%lld,%f,%f"),
+			*StaticEnum<ETouchEngineCookMode>()->GetNameStringByValue(static_cast<int64>(Result.CookMode)), Result.Components, Result.Ticks, Result.CooksStarted, Result.CooksFinished,
+			Result.GameThreadSeconds * 1000000.0 / CooksStarted, Result.GameThreadSeconds * 1000.0 / FMath::Max(Result.Ticks, 1), Result.GameThreadTickP95 * 1000.0,
+			Result.LatencyMean * 1000.0, Result.LatencyP50 * 1000.0, Result.LatencyP95 * 1000.0, Result.LatencyMax * 1000.0, Result.TickLatencyMean, Result.FramesDropped,
+			Result.ReadbacksDelivered, Result.ReadbacksOutOfOrder, Result.ImportPoolHits, Result.ImportPoolMisses, Result.Allocations / CooksStarted, Result.AllocatedBytes / CooksStarted);
+		for (const int32 Count : Result.ResultCounts)
+		{
+			Line += FString::Printf(TEXT(",%d"), Count);
+		}
+		Lines.Add(Line);
+	}
+
+	return FFileHelper::SaveStringArrayToFile(Lines, *CsvPath);
+}
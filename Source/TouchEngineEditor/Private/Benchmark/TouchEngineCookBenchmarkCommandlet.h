@@ -0,0 +1,134 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Blueprint/TouchEngineInputFrameData.h"
+#include "Commandlets/Commandlet.h"
+#include "Engine/Util/CookFrameData.h"
+#include "Util/TouchTexturePoolCounters.h"
+#include "TouchEngineCookBenchmarkCommandlet.generated.h"
+
+class UTouchEngineComponentBase;
+class UToxAsset;
+class UWorld;
+enum class ETouchEngineCookMode : uint8;
+
+/**
+ * Drives a number of TouchEngine components through a number of cooks in each cook mode, and reports the game thread cost per cook,
+ * the cook latency, the dropped and discarded frames, and the allocations made while cooking.
+ * It is meant to be run without a GPU, against the stand-in TouchEngine library (see Source/ThirdParty/TouchEngineStandIn):
+ *
+ * UnrealEditor-Cmd <Project> -run=TouchEngineCookBenchmark -Tox=<path to .tox> -nullrhi [-TouchEngineLib=<path>]
+ *		[-Components=4] [-Cooks=600] [-Warmup=60] [-TickRate=60] [-Modes=Synchronized,DelayedSynchronized,Independent] [-Csv=<path>] [-Readback=<TOP outputs>] [-CheckImportPool]
+ *
+ * With -Readback, the given comma separated TOP outputs are read back to the CPU, and the run fails if no readback is delivered or if they are delivered out of order.
+ * With -CheckImportPool, the run fails if the imported texture pool needed new textures once warm. With -nullrhi, the size of the imported textures is then
+ * changed for a few ticks and changed back, and the run fails if importing the original size again needed new textures.
+ */
+UCLASS()
+class UTouchEngineCookBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UTouchEngineCookBenchmarkCommandlet();
+
+	//~ Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) override;
+	//~ End UCommandlet Interface
+
+private:
+	/** What was measured for one cook mode */
+	struct FModeResults
+	{
+		ETouchEngineCookMode CookMode;
+		int32 Components = 0;
+		int32 Ticks = 0;
+		int32 CooksStarted = 0;
+		int32 CooksFinished = 0;
+		double GameThreadSeconds = 0.0;
+		double GameThreadTickP95 = 0.0;
+		double LatencyMean = 0.0;
+		double LatencyP50 = 0.0;
+		double LatencyP95 = 0.0;
+		double LatencyMax = 0.0;
+		double TickLatencyMean = 0.0;
+		int32 FramesDropped = 0;
+		TArray<int32> ResultCounts;
+		int32 ReadbacksDelivered = 0;
+		int32 ReadbacksOutOfOrder = 0;
+		/** The imported texture pool hits and misses of all the components during the measured cooks */
+		int64 ImportPoolHits = 0;
+		int64 ImportPoolMisses = 0;
+		uint64 Allocations = 0;
+		uint64 AllocatedBytes = 0;
+	};
+
+	UPROPERTY(Transient)
+	TObjectPtr<UWorld> World;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UToxAsset> ToxAsset;
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UTouchEngineComponentBase>> Components;
+
+	/** What the TOP readback listeners received. Written on the render thread */
+	struct FReadbackCounts
+	{
+		FCriticalSection Mutex;
+		int32 Delivered = 0;
+		int32 OutOfOrder = 0;
+		/** The FrameID of the last readback of each component and TOP output */
+		TMap<TPair<const void*, FName>, int64> LastFrameIDs;
+	};
+
+	/** The TOP outputs to read back, from -Readback */
+	TArray<FString> ReadbackOutputs;
+	TSharedPtr<FReadbackCounts, ESPMode::ThreadSafe> ReadbackCounts;
+	TArray<FDelegateHandle> ReadbackListenerHandles;
+	/** From -CheckImportPool */
+	bool bCheckImportPool = false;
+
+	/** True between the warmup and the end of the measured cooks, the end frames received outside of it are ignored */
+	bool bIsMeasuring = false;
+	TArray<double> Latencies;
+	int64 TickLatencySum = 0;
+	int32 FramesDropped = 0;
+	TArray<int32> ResultCounts;
+
+	UFUNCTION()
+	void OnEndFrame(bool bIsSuccessful, ECookFrameResult Result, const FTouchEngineOutputFrameData& FrameData);
+
+	bool RunCookMode(ETouchEngineCookMode CookMode, int32 NumComponents, int32 NumCooks, int32 NumWarmupCooks, float TickRate, FModeResults& OutResults);
+	/** Spawns the components and waits until they have all loaded the tox, returns false if any of them failed */
+	bool SpawnComponents(ETouchEngineCookMode CookMode, int32 NumComponents, float TickRate);
+	void DestroyComponents(float TickRate);
+	/** Listens to the readbacks of the loaded components, if -Readback was given */
+	void AddReadbackListeners();
+	/** Lets the render thread deliver the readbacks still in flight, without starting new cooks */
+	void DrainReadbacks();
+	/** Returns the sum of the imported texture pool counters of all the loaded components */
+	UE::TouchEngine::FTouchTexturePoolCounters GetImportPoolCounters() const;
+	/** Checks the imported texture pool of the components once the measured cooks are done, see -CheckImportPool */
+	bool CheckImportPool(const FModeResults& Results, float TickRate);
+	/** Ticks the world once, as the engine loop would, and returns the time spent on the game thread */
+	double TickWorld(float DeltaTime);
+	static void PaceTick(double TickStartTime, float TickRate);
+
+	static void LogResults(const TArray<FModeResults>& Results);
+	static bool WriteCsv(const FString& CsvPath, const TArray<FModeResults>& Results);
+};
@@ -0,0 +1,245 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+
+#include "Benchmark/TouchEngineExportPoolCheckCommandlet.h"
+
+#include "TouchEngineEditorLog.h"
+#include "Rendering/TouchResourceProvider.h"
+#include "Rendering/Exporting/ExportedTouchTexture.h"
+#include "Rendering/Exporting/ExportedTouchTextureCache.h"
+
+#include "Engine/Texture2D.h"
+#include "Misc/App.h"
+#include "Misc/Parse.h"
+#include "RenderingThread.h"
+
+namespace UE::TouchEngine::Benchmark
+{
+	/** The number of frames the pool needs before it can serve all the inputs: the textures of a frame are only pooled two frames later */
+	static constexpr int32 ExportPoolWarmupFrames = 2;
+	/** The size of the textures exported once the pool is warm */
+	static constexpr int32 ExportPoolTextureSize = 64;
+	/** The number of sets of textures the inputs rotate through once the pool is warm */
+	static constexpr int32 ExportPoolTextureSets = 3;
+
+	/** An exported texture which is never shared with TouchEngine. It fits the textures matching the descriptor it was created for */
+	class FFakeExportedTexture : public FExportedTouchTexture
+	{
+	public:
+		explicit FFakeExportedTexture(const FTouchExportTextureDescriptor& InDescriptor)
+			: FExportedTouchTexture(TouchObject<TETexture>(), [](const TouchObject<TETexture>&) {})
+			, Descriptor(InDescriptor)
+		{}
+
+		virtual bool CanFitTexture(const FRHITexture* TextureToFit) const override
+		{
+			return FTouchExportTextureDescriptor(TextureToFit) == Descriptor;
+		}
+
+		/** Sends the event TouchEngine sends once it is done with a texture for good */
+		void SimulateTouchEngineRelease()
+		{
+			OnTouchTextureUseUpdate(TEObjectEventRelease);
+		}
+
+	protected:
+		virtual void RemoveTextureCallback() override {}
+
+	private:
+		FTouchExportTextureDescriptor Descriptor;
+	};
+
+	/** Creates fake textures instead of sharing them with TouchEngine, and keeps them until SimulateTouchEngineRelease is called */
+	class FFakeExportedTextureCache : public TExportedTouchTextureCache<FFakeExportedTexture, FFakeExportedTextureCache>
+	{
+	public:
+		TSharedPtr<FFakeExportedTexture> CreateTexture(const FTouchExportParameters& Params, const FTouchExportTextureDescriptor& Descriptor)
+		{
+			TSharedPtr<FFakeExportedTexture> Texture = MakeShared<FFakeExportedTexture>(Descriptor);
+			CreatedTextures.Add(Texture);
+			return Texture;
+		}
+
+		/** Sends the release event to all the textures created, which is what ReleaseTextures and the evictions wait for */
+		void SimulateTouchEngineRelease()
+		{
+			for (const TSharedPtr<FFakeExportedTexture>& Texture : CreatedTextures)
+			{
+				if (!Texture->ReceivedReleaseEvent())
+				{
+					Texture->SimulateTouchEngineRelease();
+				}
+			}
+			CreatedTextures.Empty();
+		}
+
+	protected:
+		virtual TEResult AddTETextureTransfer(FTouchExportParameters& Params, const TSharedPtr<FFakeExportedTexture>& Texture) override
+		{
+			return TEResultSuccess;
+		}
+
+		virtual void FinaliseExportAndEnqueueCopy_AnyThread(FTouchExportParameters& Params, TSharedPtr<FFakeExportedTexture>& Texture) override
+		{}
+
+	private:
+		TArray<TSharedPtr<FFakeExportedTexture>> CreatedTextures;
+	};
+
+	/** Exports each of the textures to its own input, as a cook would, and then runs the maintenance done at the end of the cook */
+	static void ExportFrame(FFakeExportedTextureCache& Cache, TConstArrayView<TObjectPtr<UTexture2D>> Textures, int64 FrameID)
+	{
+		for (int32 Index = 0; Index < Textures.Num(); ++Index)
+		{
+			FTouchExportParameters Params;
+			Params.ParameterName = *FString::Printf(TEXT("in%d"), Index + 1);
+			Params.Texture = Textures[Index];
+			Params.FrameData.FrameID = FrameID;
+
+			bool bIsNewTexture, bTextureNeedsCopy;
+			Cache.GetOrCreateTexture(Params, bIsNewTexture, bTextureNeedsCopy);
+		}
+		Cache.TexturePoolMaintenance();
+	}
+}
+
+UTouchEngineExportPoolCheckCommandlet::UTouchEngineExportPoolCheckCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+	ShowErrorCount = true;
+	HelpDescription = TEXT("Checks the reuse and the trimming of the exported texture pool with fake exported textures.");
+	HelpUsage = TEXT("-run=TouchEngineExportPoolCheck -nullrhi -AllowCommandletRendering [-Inputs=3] [-Frames=120] [-PoolSize=20]");
+}
+
+int32 UTouchEngineExportPoolCheckCommandlet::Main(const FString& Params)
+{
+	using namespace UE::TouchEngine;
+	using namespace UE::TouchEngine::Benchmark;
+
+	// 1. Parse the arguments
+	int32 NumInputs = 3;
+	int32 NumFrames = 120;
+	int32 PoolSize = 20;
+	FParse::Value(*Params, TEXT("Inputs="), NumInputs);
+	FParse::Value(*Params, TEXT("Frames="), NumFrames);
+	FParse::Value(*Params, TEXT("PoolSize="), PoolSize);
+	NumInputs = FMath::Max(NumInputs, 1);
+	NumFrames = FMath::Max(NumFrames, ExportPoolWarmupFrames + 1);
+	PoolSize = FMath::Max(PoolSize, NumInputs); // the pool needs to hold the textures of one frame to serve the next ones
+
+	if (!FApp::CanEverRender())
+	{
+		UE_LOG(LogTouchEngineEditor, Error, TEXT("[UTouchEngineExportPoolCheckCommandlet] The textures cannot be initialised without rendering. Usage: %s"), *HelpUsage);
+		return 1;
+	}
+
+	FFakeExportedTextureCache Cache;
+	Cache.PoolSize = PoolSize;
+	bool bSucceeded = true;
+	int64 FrameID = 0;
+
+	// 2. The inputs rotate through sets of textures of the same size, so once warm, each texture must come from the pool
+	{
+		TArray<TObjectPtr<UTexture2D>> TextureSets[ExportPoolTextureSets];
+		for (TArray<TObjectPtr<UTexture2D>>& TextureSet : TextureSets)
+		{
+			for (int32 Index = 0; Index < NumInputs; ++Index)
+			{
+				TextureSet.Add(CreateTexture(ExportPoolTextureSize));
+			}
+		}
+		FlushRenderingCommands();
+		if (!FTouchResourceProvider::GetStableRHIFromTexture(TextureSets[0][0]).IsValid())
+		{
+			UE_LOG(LogTouchEngineEditor, Error, TEXT("[UTouchEngineExportPoolCheckCommandlet] The texture references were not initialised"));
+			return 1;
+		}
+
+		FTouchTexturePoolCounters WarmCounters;
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			if (Frame == ExportPoolWarmupFrames)
+			{
+				WarmCounters = Cache.GetPoolCounters();
+			}
+			ExportFrame(Cache, TextureSets[Frame % ExportPoolTextureSets], FrameID++);
+		}
+
+		const FTouchTexturePoolCounters Counters = Cache.GetPoolCounters();
+		const int64 Hits = Counters.Hits - WarmCounters.Hits;
+		const int64 Misses = Counters.Misses - WarmCounters.Misses;
+		UE_LOG(LogTouchEngineEditor, Display, TEXT("[UTouchEngineExportPoolCheckCommandlet] Same size: %d inputs x %d frames, %lld hits and %lld misses once warm, %d textures in %d buckets"),
+			NumInputs, NumFrames, Hits, Misses, Counters.NumPooledTextures, Counters.NumBuckets);
+		if (Misses > 0 || Hits == 0)
+		{
+			UE_LOG(LogTouchEngineEditor, Error, TEXT("[UTouchEngineExportPoolCheckCommandlet] The pool needed %lld new textures once warm"), Misses);
+			bSucceeded = false;
+		}
+	}
+
+	// 3. The inputs are then resized every frame, so the pool keeps evicting textures and must drop the buckets it emptied
+	{
+		int32 MaxBuckets = 0;
+		int32 MaxPooledTextures = 0;
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			TArray<TObjectPtr<UTexture2D>> ResizedTextures;
+			for (int32 Index = 0; Index < NumInputs; ++Index)
+			{
+				ResizedTextures.Add(CreateTexture(ExportPoolTextureSize + Frame + 1));
+			}
+			FlushRenderingCommands();
+			ExportFrame(Cache, ResizedTextures, FrameID++);
+
+			const FTouchTexturePoolCounters Counters = Cache.GetPoolCounters();
+			MaxBuckets = FMath::Max(MaxBuckets, Counters.NumBuckets);
+			MaxPooledTextures = FMath::Max(MaxPooledTextures, Counters.NumPooledTextures);
+			if (Counters.NumBuckets > Counters.NumPooledTextures || Counters.NumPooledTextures > PoolSize)
+			{
+				UE_LOG(LogTouchEngineEditor, Error, TEXT("[UTouchEngineExportPoolCheckCommandlet] After %d resizes, the pool has %d textures in %d buckets for a size of %d"),
+					Frame + 1, Counters.NumPooledTextures, Counters.NumBuckets, PoolSize);
+				bSucceeded = false;
+				break;
+			}
+		}
+
+		const FTouchTexturePoolCounters Counters = Cache.GetPoolCounters();
+		UE_LOG(LogTouchEngineEditor, Display, TEXT("[UTouchEngineExportPoolCheckCommandlet] Resized: %lld evictions, at most %d textures in %d buckets"),
+			Counters.Evictions, MaxPooledTextures, MaxBuckets);
+	}
+
+	// 4. Finally we release the textures, as the instance would when it is unloaded
+	TFuture<FTouchSuspendResult> ReleaseFuture = Cache.ReleaseTextures();
+	Cache.SimulateTouchEngineRelease();
+	if (!ReleaseFuture.IsReady())
+	{
+		UE_LOG(LogTouchEngineEditor, Error, TEXT("[UTouchEngineExportPoolCheckCommandlet] Some textures were still waiting to be released after TouchEngine released them all"));
+		bSucceeded = false;
+	}
+	Textures.Empty();
+
+	return bSucceeded ? 0 : 1;
+}
+
+UTexture2D* UTouchEngineExportPoolCheckCommandlet::CreateTexture(int32 Size)
+{
+	UTexture2D* Texture = UTexture2D::CreateTransient(Size, Size, PF_B8G8R8A8);
+	Texture->UpdateResource(); // initialises the TextureReference the cache retrieves the RHI through
+	Textures.Add(Texture);
+	return Texture;
+}
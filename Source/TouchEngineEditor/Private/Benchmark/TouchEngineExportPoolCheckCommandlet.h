@@ -0,0 +1,51 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "TouchEngineExportPoolCheckCommandlet.generated.h"
+
+class UTexture2D;
+
+/**
+ * Drives the exported texture pool (TExportedTouchTextureCache) with fake exported textures, so it can be checked without a GPU nor TouchEngine:
+ *
+ * UnrealEditor-Cmd <Project> -run=TouchEngineExportPoolCheck -nullrhi -AllowCommandletRendering [-Inputs=3] [-Frames=120] [-PoolSize=20]
+ *
+ * The inputs are first exported from a rotating set of textures of the same size, and the run fails if the pool needs new textures once warm.
+ * They are then exported at a different size each frame, and the run fails if the pool keeps buckets without textures or grows past its size.
+ */
+UCLASS()
+class UTouchEngineExportPoolCheckCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UTouchEngineExportPoolCheckCommandlet();
+
+	//~ Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) override;
+	//~ End UCommandlet Interface
+
+private:
+	/** The textures exported by the check, kept alive until the cache released them */
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UTexture2D>> Textures;
+
+	/** Creates a texture of the given size, with its RHI initialised */
+	UTexture2D* CreateTexture(int32 Size);
+};
@@ -0,0 +1,359 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#include "Benchmark/TouchEngineVariableBenchmarkCommandlet.h"
+
+#include "TouchEngineDynamicVariableStruct.h"
+#include "TouchEngineEditorLog.h"
+#include "Benchmark/TouchEngineBenchmarkUtils.h"
+#include "Blueprint/TouchEngineComponent.h"
+#include "Blueprint/TouchEngineInputFrameData.h"
+#include "Engine/TouchEngineInfo.h"
+#include "Engine/TouchVariables.h"
+#include "ToxAsset.h"
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/WorldSettings.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace UE::TouchEngine::Benchmark
+{
+	/** How long we wait for the component to load the tox before giving up */
+	static constexpr double VariableLoadTimeoutSeconds = 30.0;
+
+	static FTouchEngineDynamicVariableStruct MakeVariable(const FString& Name, EVarType VarType, bool bIsArray)
+	{
+		FTouchEngineDynamicVariableStruct Variable;
+		Variable.VarLabel = Name;
+		Variable.VarName = TEXT("i/") + Name;
+		Variable.VarIdentifier = TEXT("i/") + Name;
+		Variable.VarType = VarType;
+		Variable.bIsArray = bIsArray;
+		return Variable;
+	}
+
+	static FTouchEngineCHOP MakeCHOP(int32 NumChannels, int32 NumSamples)
+	{
+		FTouchEngineCHOP CHOP;
+		CHOP.Channels.SetNum(NumChannels);
+		for (int32 ChannelIndex = 0; ChannelIndex < NumChannels; ++ChannelIndex)
+		{
+			FTouchEngineCHOPChannel& Channel = CHOP.Channels[ChannelIndex];
+			Channel.Name = FString::Printf(TEXT("chan%d"), ChannelIndex + 1);
+			Channel.Values.SetNumUninitialized(NumSamples);
+			for (int32 Sample = 0; Sample < NumSamples; ++Sample)
+			{
+				Channel.Values[Sample] = FMath::Sin(static_cast<float>(Sample + ChannelIndex));
+			}
+		}
+		return CHOP;
+	}
+
+	static TArray<FString> MakeStrings(int32 Num)
+	{
+		TArray<FString> Strings;
+		Strings.Reserve(Num);
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			Strings.Add(FString::Printf(TEXT("Row %d of the benchmark table"), Index));
+		}
+		return Strings;
+	}
+}
+
+UTouchEngineVariableBenchmarkCommandlet::UTouchEngineVariableBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+	ShowErrorCount = true;
+	HelpDescription = TEXT("Measures the time and allocations of the TouchEngine dynamic variable operations for each variable type and size.");
+	HelpUsage = TEXT("-run=TouchEngineVariableBenchmark [-Iterations=1000] [-Tox=<path>] [-Csv=<path>]");
+}
+
+int32 UTouchEngineVariableBenchmarkCommandlet::Main(const FString& Params)
+{
+	using namespace UE::TouchEngine::Benchmark;
+
+	// 1. Parse the arguments
+	int32 Iterations = 1000;
+	FString ToxPath;
+	FString CsvPath;
+	FParse::Value(*Params, TEXT("Iterations="), Iterations);
+	FParse::Value(*Params, TEXT("Tox="), ToxPath);
+	FParse::Value(*Params, TEXT("Csv="), CsvPath);
+	Iterations = FMath::Max(Iterations, 1);
+
+	// 2. The operations which only touch the variable itself, for each type, from the smallest to the largest values we expect
+	{
+		const FTouchEngineDynamicVariableStruct Variable = MakeVariable(TEXT("Bool"), EVarType::Bool, false);
+		BenchmarkValueOperations(TEXT("Bool"), Variable, [](FTouchEngineDynamicVariableStruct& Target) { Target.SetValue(true); }, Iterations);
+	}
+	{
+		const FTouchEngineDynamicVariableStruct Variable = MakeVariable(TEXT("Int"), EVarType::Int, false);
+		BenchmarkValueOperations(TEXT("Int"), Variable, [](FTouchEngineDynamicVariableStruct& Target) { Target.SetValue(42); }, Iterations);
+	}
+	{
+		const TArray<int> Values { 1, 2, 3, 4 };
+		const FTouchEngineDynamicVariableStruct Variable = MakeVariable(TEXT("Int[4]"), EVarType::Int, true);
+		BenchmarkValueOperations(TEXT("Int[4]"), Variable, [&Values](FTouchEngineDynamicVariableStruct& Target) { Target.SetValue(Values); }, Iterations);
+	}
+	{
+		const FTouchEngineDynamicVariableStruct Variable = MakeVariable(TEXT("Double"), EVarType::Double, false);
+		BenchmarkValueOperations(TEXT("Double"), Variable, [](FTouchEngineDynamicVariableStruct& Target) { Target.SetValue(0.5); }, Iterations);
+	}
+	{
+		const TArray<double> Values { 0.1, 0.2, 0.3, 0.4 };
+		const FTouchEngineDynamicVariableStruct Variable = MakeVariable(TEXT("Double[4]"), EVarType::Double, true);
+		BenchmarkValueOperations(TEXT("Double[4]"), Variable, [&Values](FTouchEngineDynamicVariableStruct& Target) { Target.SetValue(Values); }, Iterations);
+	}
+	{
+		const TArray<float> Values { 0.1f, 0.2f, 0.3f, 1.f };
+		const FTouchEngineDynamicVariableStruct Variable = MakeVariable(TEXT("Float[4]"), EVarType::Float, true);
+		BenchmarkValueOperations(TEXT("Float[4]"), Variable, [&Values](FTouchEngineDynamicVariableStruct& Target) { Target.SetValue(Values); }, Iterations);
+	}
+	for (const FIntPoint& ChannelsAndSamples : { FIntPoint(1, 64), FIntPoint(16, 1024), FIntPoint(64, 4096) })
+	{
+		const FString Name = FString::Printf(TEXT("CHOP[%dx%d]"), ChannelsAndSamples.X, ChannelsAndSamples.Y);
+		const FTouchEngineCHOP CHOP = MakeCHOP(ChannelsAndSamples.X, ChannelsAndSamples.Y);
+		const FTouchEngineDynamicVariableStruct Variable = MakeVariable(Name, EVarType::CHOP, true);
+		BenchmarkValueOperations(Name, Variable, [&CHOP](FTouchEngineDynamicVariableStruct& Target) { Target.SetValue(CHOP); }, Iterations);
+	}
+	{
+		const FString Value = MakeStrings(1)[0];
+		const FTouchEngineDynamicVariableStruct Variable = MakeVariable(TEXT("String"), EVarType::String, false);
+		BenchmarkValueOperations(TEXT("String"), Variable, [&Value](FTouchEngineDynamicVariableStruct& Target) { Target.SetValue(Value); }, Iterations);
+	}
+	for (const int32 NumStrings : { 16, 4096 })
+	{
+		const FString Name = FString::Printf(TEXT("String[%d]"), NumStrings);
+		const TArray<FString> Values = MakeStrings(NumStrings);
+		const FTouchEngineDynamicVariableStruct Variable = MakeVariable(Name, EVarType::String, true);
+		BenchmarkValueOperations(Name, Variable, [&Values](FTouchEngineDynamicVariableStruct& Target) { Target.SetValue(Values); }, Iterations);
+	}
+
+	// 3. The operations exchanging the values with TouchEngine need a loaded instance
+	bool bSucceeded = true;
+	if (!ToxPath.IsEmpty())
+	{
+		bSucceeded = BenchmarkEngineOperations(ToxPath, Iterations);
+	}
+	else
+	{
+		UE_LOG(LogTouchEngineEditor, Display, TEXT("[UTouchEngineVariableBenchmarkCommandlet] No -Tox=<path> given, SendInput and GetOutput will not be measured"));
+	}
+
+	// 4. Report
+	LogResults();
+	if (!CsvPath.IsEmpty() && !WriteCsv(CsvPath))
+	{
+		UE_LOG(LogTouchEngineEditor, Error, TEXT("[UTouchEngineVariableBenchmarkCommandlet] Unable to write the results to `%s`"), *CsvPath);
+		bSucceeded = false;
+	}
+	return bSucceeded ? 0 : 1;
+}
+
+void UTouchEngineVariableBenchmarkCommandlet::BenchmarkValueOperations(const FString& VariableName, const FTouchEngineDynamicVariableStruct& Variable, TFunctionRef<void(FTouchEngineDynamicVariableStruct&)> SetValue, int32 Iterations)
+{
+	// 1. Give the variable its value. Every operation below reads from Source and, when it needs one, writes into Target
+	FTouchEngineDynamicVariableStruct Source = Variable;
+	SetValue(Source);
+	FTouchEngineDynamicVariableStruct Target = Variable;
+	bool bIdentical = true;
+
+	Measure(VariableName, TEXT("SetValue"), Iterations, [&SetValue, &Target]() { SetValue(Target); });
+	Measure(VariableName, TEXT("CopyConstruct"), Iterations, [&Source]() { const FTouchEngineDynamicVariableStruct Copy(Source); });
+	Measure(VariableName, TEXT("Assign"), Iterations, [&Source, &Target]() { Target = Source; });
+	Measure(VariableName, TEXT("Identical"), Iterations, [&Source, &Target, &bIdentical]() { bIdentical &= Source.Identical(&Target, PPF_None); });
+
+	// 2. Serialization, to and from the same buffer so its allocation is only made once
+	TArray<uint8> Bytes;
+	{
+		FMemoryWriter Writer(Bytes);
+		Source.Serialize(Writer);
+	}
+	Measure(VariableName, TEXT("SerializeSave"), Iterations, [&Source, &Bytes]()
+	{
+		Bytes.Reset();
+		FMemoryWriter Writer(Bytes);
+		Source.Serialize(Writer);
+	});
+	Measure(VariableName, TEXT("SerializeLoad"), Iterations, [&Target, &Bytes]()
+	{
+		FMemoryReader Reader(Bytes);
+		Target.Serialize(Reader);
+	});
+
+	// 3. Text export / import, as used by copy-paste and the details panel
+	const FString Exported = Source.ExportValue();
+	Measure(VariableName, TEXT("ExportValue"), Iterations, [&Source]() { const FString Text = Source.ExportValue(); });
+	Measure(VariableName, TEXT("ImportValue"), Iterations, [&Target, &Exported]() { Target.ImportValue(*Exported); });
+
+	if (!bIdentical)
+	{
+		UE_LOG(LogTouchEngineEditor, Warning, TEXT("[UTouchEngineVariableBenchmarkCommandlet] `%s` was not identical to its copy"), *VariableName);
+	}
+}
+
+bool UTouchEngineVariableBenchmarkCommandlet::BenchmarkEngineOperations(const FString& ToxPath, int32 Iterations)
+{
+	using namespace UE::TouchEngine::Benchmark;
+	constexpr float DeltaTime = 1.f / 60.f;
+
+	if (!FPaths::FileExists(ToxPath))
+	{
+		UE_LOG(LogTouchEngineEditor, Error, TEXT("[UTouchEngineVariableBenchmarkCommandlet] The tox `%s` does not exist"), *ToxPath);
+		return false;
+	}
+
+	// 1. Load the tox in a component. There is no game mode, so we begin play ourselves
+	UToxAsset* ToxAsset = NewObject<UToxAsset>(GetTransientPackage());
+	ToxAsset->SetFilePath(FPaths::ConvertRelativePathToFull(ToxPath));
+
+	World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("TouchEngineVariableBenchmark"));
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+	World->InitializeActorsForPlay(FURL());
+	World->BeginPlay();
+	World->GetWorldSettings()->NotifyBeginPlay();
+
+	AActor* Actor = World->SpawnActor<AActor>();
+	Component = NewObject<UTouchEngineComponentBase>(Actor);
+	Component->ToxAsset = ToxAsset;
+	Component->CookMode = ETouchEngineCookMode::Synchronized;
+	Actor->AddInstanceComponent(Component);
+	Component->RegisterComponent(); // The world has begun play, so this calls BeginPlay, which loads the tox
+
+	bool bLoaded = false;
+	const double LoadStartTime = FPlatformTime::Seconds();
+	while (!Component->HasFailedLoad() && FPlatformTime::Seconds() - LoadStartTime < VariableLoadTimeoutSeconds)
+	{
+		TickWorld(*World, DeltaTime);
+		if (Component->IsLoaded())
+		{
+			bLoaded = true;
+			break;
+		}
+		FPlatformProcess::SleepNoStats(0.001f);
+	}
+
+	// 2. Measure each variable. We do not tick while measuring, so no cook is started under our feet
+	if (bLoaded)
+	{
+		FTouchEngineInputFrameData FrameData;
+		FrameData.FrameID = 0;
+		for (FTouchEngineDynamicVariableStruct& Input : Component->DynamicVariables.DynVars_Input)
+		{
+			if (Input.VarType == EVarType::Texture)
+			{
+				continue; // Exporting textures is measured by the cook benchmark, as it depends on the RHI
+			}
+			Measure(Input.VarName, TEXT("SendInput"), Iterations, [this, &Input, &FrameData]() { Input.SendInput(Component->EngineInfo, FrameData); });
+		}
+		for (FTouchEngineDynamicVariableStruct& Output : Component->DynamicVariables.DynVars_Output)
+		{
+			if (Output.VarType == EVarType::Texture)
+			{
+				continue;
+			}
+			Measure(Output.VarName, TEXT("GetOutput"), Iterations, [this, &Output]() { Output.GetOutput(Component->EngineInfo); });
+		}
+	}
+	else
+	{
+		UE_LOG(LogTouchEngineEditor, Error, TEXT("[UTouchEngineVariableBenchmarkCommandlet] Unable to load `%s`"), *ToxAsset->GetAbsoluteFilePath());
+	}
+
+	// 3. Clean up, letting the pending game thread tasks of the closed instance run
+	Actor->Destroy(); // Ends play, which closes the TouchEngine instance
+	Component = nullptr;
+	for (int32 Tick = 0; Tick < 10; ++Tick)
+	{
+		TickWorld(*World, DeltaTime);
+	}
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	World = nullptr;
+
+	return bLoaded;
+}
+
+void UTouchEngineVariableBenchmarkCommandlet::Measure(const FString& VariableName, const FString& OperationName, int32 Iterations, TFunctionRef<void()> Operation)
+{
+	using namespace UE::TouchEngine::Benchmark;
+
+	// The samples are allocated before counting, so they do not show in the results
+	TArray<double> Samples;
+	Samples.SetNumUninitialized(Iterations);
+	const double NanosecondsPerCycle = FPlatformTime::GetSecondsPerCycle64() * 1000000000.0;
+
+	FOperationResults& Result = Results.AddDefaulted_GetRef();
+	Result.Variable = VariableName;
+	Result.Operation = OperationName;
+	Result.Iterations = Iterations;
+	{
+		FScopedAllocationCounter AllocationCounter;
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			const uint64 StartCycles = FPlatformTime::Cycles64();
+			Operation();
+			Samples[Iteration] = (FPlatformTime::Cycles64() - StartCycles) * NanosecondsPerCycle;
+		}
+		Result.Allocations = AllocationCounter.GetAllocationCount();
+		Result.AllocatedBytes = AllocationCounter.GetAllocatedBytes();
+	}
+
+	double Sum = 0.0;
+	for (const double Sample : Samples)
+	{
+		Sum += Sample;
+	}
+	Result.MeanNs = Sum / Iterations;
+	Result.P50Ns = ComputePercentile(Samples, 0.5);
+	Result.P95Ns = ComputePercentile(Samples, 0.95);
+}
+
+void UTouchEngineVariableBenchmarkCommandlet::LogResults() const
+{
+	UE_LOG(LogTouchEngineEditor, Display, TEXT("[UTouchEngineVariableBenchmarkCommandlet] ====== Results ======"));
+	UE_LOG(LogTouchEngineEditor, Display, TEXT("%-24s %-14s %12s %12s %12s %10s %12s"), TEXT("Variable"), TEXT("Operation"), TEXT("mean ns"), TEXT("p50 ns"), TEXT("p95 ns"), TEXT("allocs/op"), TEXT("bytes/op"));
+	for (const FOperationResults& Result : Results)
+	{
+		UE_LOG(LogTouchEngineEditor, Display, TEXT("%-24s %-14s %12.1f %12.1f %12.1f %10.2f %12.1f"),
+			*Result.Variable, *Result.Operation, Result.MeanNs, Result.P50Ns, Result.P95Ns,
+			static_cast<double>(Result.Allocations) / Result.Iterations, static_cast<double>(Result.AllocatedBytes) / Result.Iterations);
+	}
+}
+
+bool UTouchEngineVariableBenchmarkCommandlet::WriteCsv(const FString& CsvPath) const
+{
+	TArray<FString> Lines;
+	Lines.Add(TEXT("Variable,Operation,Iterations,MeanNs,P50Ns,P95Ns,AllocationsPerOp,BytesPerOp"));
+	for (const FOperationResults& Result : Results)
+	{
+		Lines.Add(FString::Printf(TEXT("%s,%s,%d,%f,%f,%f,%f,%f"),
+			*Result.Variable, *Result.Operation, Result.Iterations, Result.MeanNs, Result.P50Ns, Result.P95Ns,
+			static_cast<double>(Result.Allocations) / Result.Iterations, static_cast<double>(Result.AllocatedBytes) / Result.Iterations));
+	}
+	return FFileHelper::SaveStringArrayToFile(Lines, *CsvPath);
+}
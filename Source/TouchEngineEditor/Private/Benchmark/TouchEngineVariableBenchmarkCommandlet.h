@@ -0,0 +1,75 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "TouchEngineVariableBenchmarkCommandlet.generated.h"
+
+class UTouchEngineComponentBase;
+class UWorld;
+struct FTouchEngineDynamicVariableStruct;
+
+/**
+ * Measures the cost of the FTouchEngineDynamicVariableStruct operations (SetValue, copying, serialization, text export / import, comparison)
+ * for each variable type, from single values up to large CHOPs and string arrays, and the allocations each of them makes.
+ * When a tox is given, it is loaded in a component and the SendInput / GetOutput of each of its variables are measured as well:
+ *
+ * UnrealEditor-Cmd <Project> -run=TouchEngineVariableBenchmark -nullrhi [-Iterations=1000] [-Tox=<path to .tox>] [-TouchEngineLib=<path>] [-Csv=<path>]
+ */
+UCLASS()
+class UTouchEngineVariableBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UTouchEngineVariableBenchmarkCommandlet();
+
+	//~ Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) override;
+	//~ End UCommandlet Interface
+
+private:
+	/** What was measured for one operation on one variable */
+	struct FOperationResults
+	{
+		FString Variable;
+		FString Operation;
+		int32 Iterations = 0;
+		double MeanNs = 0.0;
+		double P50Ns = 0.0;
+		double P95Ns = 0.0;
+		uint64 Allocations = 0;
+		uint64 AllocatedBytes = 0;
+	};
+
+	UPROPERTY(Transient)
+	TObjectPtr<UWorld> World;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UTouchEngineComponentBase> Component;
+
+	TArray<FOperationResults> Results;
+
+	/** Runs each operation which does not need a TouchEngine instance on the given variable, which must already hold its value */
+	void BenchmarkValueOperations(const FString& VariableName, const FTouchEngineDynamicVariableStruct& Variable, TFunctionRef<void(FTouchEngineDynamicVariableStruct&)> SetValue, int32 Iterations);
+	/** Loads the tox in a component and measures SendInput on each of its inputs and GetOutput on each of its outputs */
+	bool BenchmarkEngineOperations(const FString& ToxPath, int32 Iterations);
+	/** Calls Operation Iterations times, timing each call, and adds the results */
+	void Measure(const FString& VariableName, const FString& OperationName, int32 Iterations, TFunctionRef<void()> Operation);
+
+	void LogResults() const;
+	bool WriteCsv(const FString& CsvPath) const;
+};
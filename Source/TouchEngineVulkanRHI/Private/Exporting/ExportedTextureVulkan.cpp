@@ -36,6 +36,7 @@ THIRD_PARTY_INCLUDES_END
 
 #include "Engine/TEDebug.h"
 #include "Importing/VulkanImportUtils.h"
+#include "Rendering/Exporting/ExportedTouchTextureCache.h"
 #include "TEVulkanInclude.h"
 #include "Util/TextureShareVulkanPlatformWindows.h"
 #include "Util/TouchEngineStatsGroup.h"
@@ -168,12 +169,12 @@ namespace UE::TouchEngine::Vulkan
 		}
 	}
 	
-	TSharedPtr<FExportedTextureVulkan> FExportedTextureVulkan::Create(const FRHITexture2D& SourceRHI, const TSharedRef<FVulkanSharedResourceSecurityAttributes>& SecurityAttributes)
+	TSharedPtr<FExportedTextureVulkan> FExportedTextureVulkan::Create(const FTouchExportTextureDescriptor& Descriptor, const TSharedRef<FVulkanSharedResourceSecurityAttributes>& SecurityAttributes)
 	{
 		DECLARE_SCOPE_CYCLE_COUNTER(TEXT("      I.B.1.a [GT] Cook Frame - Vulkan::CreateTexture"), STAT_TE_I_B_1_a_Vulkan, STATGROUP_TouchEngine);
-		const EPixelFormat PixelFormat = SourceRHI.GetFormat();
-		const FIntPoint Resolution = SourceRHI.GetSizeXY();
-		const bool bIsSRGB = EnumHasAnyFlags(SourceRHI.GetDesc().Flags, ETextureCreateFlags::SRGB);
+		const EPixelFormat PixelFormat = Descriptor.PixelFormat;
+		const FIntPoint Resolution = Descriptor.Size;
+		const bool bIsSRGB = Descriptor.bIsSRGB;
 
 		VkComponentMapping Mapping;
 		const VkFormat VulkanFormat = UnrealToVulkanTextureFormat(PixelFormat, bIsSRGB, Mapping);
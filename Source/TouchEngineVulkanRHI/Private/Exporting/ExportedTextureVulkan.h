@@ -21,6 +21,11 @@ THIRD_PARTY_INCLUDES_END
 #include "Rendering/Exporting/ExportedTouchTexture.h"
 #include "Util/SemaphoreVulkanUtils.h"
 
+namespace UE::TouchEngine
+{
+	struct FTouchExportTextureDescriptor;
+}
+
 namespace UE::TouchEngine::Vulkan
 {
 	class FVulkanSharedResourceSecurityAttributes;
@@ -33,7 +38,8 @@ namespace UE::TouchEngine::Vulkan
 		friend class FTouchTextureExporterVulkan;
 	public:
 
-		static TSharedPtr<FExportedTextureVulkan> Create(const FRHITexture2D& SourceRHI, const TSharedRef<FVulkanSharedResourceSecurityAttributes>& SecurityAttributes);
+		/** Creates a shared texture matching the pixel format, resolution and sRGB flag of the descriptor */
+		static TSharedPtr<FExportedTextureVulkan> Create(const FTouchExportTextureDescriptor& Descriptor, const TSharedRef<FVulkanSharedResourceSecurityAttributes>& SecurityAttributes);
 		
 		//~ Begin FExportedTouchTexture Interface
 		virtual bool CanFitTexture(const FRHITexture* TextureToFit) const override;
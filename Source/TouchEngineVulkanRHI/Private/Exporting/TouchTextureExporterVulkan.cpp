@@ -339,9 +339,9 @@ namespace UE::TouchEngine::Vulkan
 		return Future;
 	}
 
-	TSharedPtr<FExportedTextureVulkan> FTouchTextureExporterVulkan::CreateTexture(const FTouchExportParameters& Params, const FRHITexture2D* ParamTextureRHI) const
+	TSharedPtr<FExportedTextureVulkan> FTouchTextureExporterVulkan::CreateTexture(const FTouchExportParameters& Params, const FTouchExportTextureDescriptor& Descriptor) const
 	{
-		return FExportedTextureVulkan::Create(*ParamTextureRHI, SecurityAttributes);
+		return FExportedTextureVulkan::Create(Descriptor, SecurityAttributes);
 	}
 
 	void FTouchTextureExporterVulkan::FinalizeExportsToTouchEngine_AnyThread(const FTouchEngineInputFrameData& FrameData)
@@ -214,7 +214,13 @@ namespace UE::TouchEngine::Vulkan
 		++SharedTexture->CurrentSemaphoreValue;
 		CommandBuilder.AddSignalSemaphore({ *SharedTexture->SignalSemaphoreData->VulkanSemaphore.Get(), SharedTexture->CurrentSemaphoreValue });
 		// The contents of the texture can be discarded so use TEInstanceAddTextureTransfer instead of TEInstanceAddVulkanTextureTransfer
-		TEInstanceAddTextureTransfer(RequestParams.Instance, RequestParams.TETexture, SharedTexture->SignalSemaphoreData->TouchSemaphore, SharedTexture->CurrentSemaphoreValue);
+		const TEResult Result = TEInstanceAddTextureTransfer(RequestParams.Instance, RequestParams.TETexture, SharedTexture->SignalSemaphoreData->TouchSemaphore, SharedTexture->CurrentSemaphoreValue);
+		const TSharedPtr<UE::TouchEngine::FTouchTextureImporter> ImporterPin = Importer.Pin();
+		if (Result == TEResultSuccess && ImporterPin)
+		{
+			// The timeline semaphore value only ever increases, so getting this transfer back means TouchEngine did not write to the texture since this copy
+			ImporterPin->OnTextureTransferReturned_AnyThread(RequestParams, SharedTexture->SignalSemaphoreData->TouchSemaphore, SharedTexture->CurrentSemaphoreValue);
+		}
 	}
 	
 	ECopyTouchToUnrealResult CopyTouchToUnrealRHICommand(const FTouchCopyTextureArgs& CopyArgs, const TSharedRef<FTouchImportTextureVulkan>& SharedTexture, const TSharedRef<UE::TouchEngine::FTouchTextureImporter>& Importer)
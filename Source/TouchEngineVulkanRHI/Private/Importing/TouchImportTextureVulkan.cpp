@@ -22,10 +22,117 @@
 #include "VulkanTouchUtils.h"
 
 #include "TEVulkanInclude.h"
+#include "HAL/PlatformTime.h"
+#include "Tasks/Task.h"
 #include "Util/TouchEngineStatsGroup.h"
 
 namespace UE::TouchEngine::Vulkan
 {
+	namespace Private
+	{
+		/** The maximum time we wait for a copy to be done before executing its callback anyway */
+		constexpr double CopyDoneTimeoutSeconds = 5.0;
+		/** The maximum time FCopyDoneWaiter blocks in vkWaitSemaphores before picking up the copies added in the meantime */
+		constexpr uint64 CopyDoneWaitSliceNs = 2000000ull;
+		
+		/**
+		 * Waits for the copies of all the imported textures from a single background task.
+		 * Timeline semaphores cannot signal an OS event we could register a wait on, so instead of blocking one task per copy,
+		 * a single task waits for any of the pending semaphores, executes the callbacks of the copies which are done, and waits again until none are left.
+		 */
+		class FCopyDoneWaiter
+		{
+		public:
+			static FCopyDoneWaiter& Get()
+			{
+				static FCopyDoneWaiter Waiter;
+				return Waiter;
+			}
+
+			void AddWait(TSharedPtr<VkSemaphore> Semaphore, uint64 WaitValue, TUniqueFunction<void()>&& Callback)
+			{
+				bool bStartTask;
+				{
+					FScopeLock Lock(&PendingWaitsMutex);
+					PendingWaits.Add({ MoveTemp(Semaphore), WaitValue, FPlatformTime::Seconds() + CopyDoneTimeoutSeconds, MoveTemp(Callback) });
+					bStartTask = !bIsTaskRunning;
+					bIsTaskRunning = true;
+				}
+				if (bStartTask)
+				{
+					UE::Tasks::Launch(UE_SOURCE_LOCATION, [this]() { WaitForCopies(); }, LowLevelTasks::ETaskPriority::BackgroundLow);
+				}
+			}
+
+		private:
+			struct FPendingWait
+			{
+				TSharedPtr<VkSemaphore> Semaphore;
+				uint64 WaitValue;
+				double TimeoutTime;
+				TUniqueFunction<void()> Callback;
+			};
+
+			FCriticalSection PendingWaitsMutex;
+			/** The copies added since the task last picked them up */
+			TArray<FPendingWait> PendingWaits;
+			bool bIsTaskRunning = false;
+
+			void WaitForCopies()
+			{
+				const FVulkanPointers VulkanPointers;
+				TArray<FPendingWait> Waits;
+				TArray<VkSemaphore> Semaphores;
+				TArray<uint64> WaitValues;
+				while (true)
+				{
+					// 1. Pick up the copies added since the last wait, and stop once there is nothing left to wait for
+					{
+						FScopeLock Lock(&PendingWaitsMutex);
+						Waits.Append(MoveTemp(PendingWaits));
+						PendingWaits.Reset();
+						if (Waits.IsEmpty())
+						{
+							bIsTaskRunning = false;
+							return;
+						}
+					}
+
+					// 2. Wait for any of the copies to be done
+					Semaphores.Reset();
+					WaitValues.Reset();
+					for (const FPendingWait& Wait : Waits)
+					{
+						Semaphores.Add(*Wait.Semaphore);
+						WaitValues.Add(Wait.WaitValue);
+					}
+					VkSemaphoreWaitInfo WaitInfo{ VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO };
+					WaitInfo.flags = VK_SEMAPHORE_WAIT_ANY_BIT;
+					WaitInfo.semaphoreCount = Semaphores.Num();
+					WaitInfo.pSemaphores = Semaphores.GetData();
+					WaitInfo.pValues = WaitValues.GetData();
+					const VkResult Result = vkWaitSemaphores(VulkanPointers.VulkanDeviceHandle, &WaitInfo, CopyDoneWaitSliceNs);
+					UE_CLOG(Result != VK_SUCCESS && Result != VK_TIMEOUT, LogTouchEngineVulkanRHI, Warning, TEXT("[FTouchImportTextureVulkan::OnCurrentCopyDone_RenderThread] Waiting for %d copies did not succeed (VkResult: %d), executing their callbacks now"), Waits.Num(), static_cast<int32>(Result));
+
+					// 3. Execute the callbacks of the copies which are done, or which we cannot wait for anymore
+					const double Now = FPlatformTime::Seconds();
+					for (int32 Index = Waits.Num() - 1; Index >= 0; --Index)
+					{
+						FPendingWait& Wait = Waits[Index];
+						const bool bIsDone = GetCompletedSemaphoreValue(Wait.Semaphore.Get(), FString()) >= Wait.WaitValue;
+						const bool bTimedOut = !bIsDone && Now >= Wait.TimeoutTime;
+						if (bIsDone || bTimedOut || (Result != VK_SUCCESS && Result != VK_TIMEOUT))
+						{
+							UE_CLOG(bTimedOut, LogTouchEngineVulkanRHI, Warning, TEXT("[FTouchImportTextureVulkan::OnCurrentCopyDone_RenderThread] Timed out waiting for the copy to be done for semaphore value %llu"), Wait.WaitValue);
+							Wait.Callback();
+							Waits.RemoveAtSwap(Index, 1, EAllowShrinking::No); // the order does not matter as we wait for any of them
+						}
+					}
+				}
+			}
+		};
+	}
+	
 	TSharedPtr<FTouchImportTextureVulkan> FTouchImportTextureVulkan::CreateTexture(const TouchObject<TEVulkanTexture_>& SharedOutputTexture, TSharedRef<FVulkanSharedResourceSecurityAttributes> SecurityAttributes)
 	{
 		DECLARE_SCOPE_CYCLE_COUNTER(TEXT("      III.A.2.a [RT] Link Texture Import - CreateTexture"), STAT_TE_III_A_2_a_Vulkan, STATGROUP_TouchEngine);
@@ -79,11 +186,28 @@ namespace UE::TouchEngine::Vulkan
 		return Result;
 	}
 
-	bool FTouchImportTextureVulkan::IsCurrentCopyDone()
+	bool FTouchImportTextureVulkan::IsCurrentCopyDone() const
 	{
 		return (SignalSemaphoreData.IsSet() && SignalSemaphoreData->VulkanSemaphore && SignalSemaphoreData->GetCompletedSemaphoreValue() >= CurrentSemaphoreValue);
 	}
 
+	void FTouchImportTextureVulkan::OnCurrentCopyDone_RenderThread(FRHICommandListImmediate& RHICmdList, TUniqueFunction<void()>&& Callback)
+	{
+		// The semaphore value signaled by the copy is only known once FRHICommandCopyTouchToUnreal has been executed, so we start waiting from the RHI thread
+		RHICmdList.EnqueueLambda([WeakThis = AsWeak(), Callback = MoveTemp(Callback)](FRHICommandListImmediate&) mutable
+		{
+			const TSharedPtr<FTouchImportTextureVulkan> ThisPin = WeakThis.Pin();
+			if (!ThisPin || !ThisPin->SignalSemaphoreData.IsSet() || !ThisPin->SignalSemaphoreData->VulkanSemaphore || ThisPin->IsCurrentCopyDone() || !vkWaitSemaphores)
+			{
+				Callback();
+				return;
+			}
+
+			// All the pending copies are waited for by a single task, see FCopyDoneWaiter
+			Private::FCopyDoneWaiter::Get().AddWait(ThisPin->SignalSemaphoreData->VulkanSemaphore, ThisPin->CurrentSemaphoreValue, MoveTemp(Callback));
+		});
+	}
+
 	ECopyTouchToUnrealResult FTouchImportTextureVulkan::CopyNativeToUnrealRHI_RenderThread(const FTouchCopyTextureArgs& CopyArgs, TSharedRef<FTouchTextureImporter> Importer)
 	{
 		return CopyTouchToUnrealRHICommand(CopyArgs, SharedThis(this), Importer);
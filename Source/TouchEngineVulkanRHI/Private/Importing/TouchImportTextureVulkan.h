@@ -55,10 +55,13 @@ namespace UE::TouchEngine::Vulkan
 		
 		//~ Begin ITouchPlatformTexture Interface
 		virtual FTextureMetaData GetTextureMetaData() const override;
-		virtual bool IsCurrentCopyDone() override;
+		virtual void OnCurrentCopyDone_RenderThread(FRHICommandListImmediate& RHICmdList, TUniqueFunction<void()>&& Callback) override;
 		virtual ECopyTouchToUnrealResult CopyNativeToUnrealRHI_RenderThread(const FTouchCopyTextureArgs& CopyArgs, TSharedRef<FTouchTextureImporter> Importer) override;
 		//~ End ITouchPlatformTexture Interface
 
+		/** Check if the internal semaphore for the end of the copy has been signaled, which would mean that this texture can be safely deleted */
+		bool IsCurrentCopyDone() const;
+
 		TEVulkanTexture_* GetSharedTexture() const { return WeakSharedOutputTextureReference; }
 		const TSharedPtr<VkCommandBuffer>& GetCommandBuffer() const { return CommandBuffer; }
 
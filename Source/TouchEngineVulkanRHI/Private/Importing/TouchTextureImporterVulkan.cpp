@@ -25,6 +25,9 @@
 #include "TouchImportTextureVulkan.h"
 #include "VulkanTouchUtils.h"
 #include "TEVulkanInclude.h"
+#include "Logging.h"
+#include "Engine/TEDebug.h"
+#include "Util/TouchHelpers.h"
 
 namespace UE::TouchEngine::Vulkan
 {
@@ -78,6 +81,20 @@ namespace UE::TouchEngine::Vulkan
 		return Transfer;
 	}
 
+	void FTouchTextureImporterVulkan::ReturnTextureTransfer(const FTouchImportParameters& ImportParams)
+	{
+		if (ImportParams.TETextureTransfer.Result == TEResultSuccess && ImportParams.TETextureTransfer.Semaphore)
+		{
+			// We never executed the ownership transfer, so the image is still in the layout TouchEngine released it in and TouchEngine has to do the same acquire operation
+			const VkImageLayout AcquireOldLayout = static_cast<VkImageLayout>(ImportParams.TETextureTransfer.VulkanOldLayout);
+			const VkImageLayout AcquireNewLayout = static_cast<VkImageLayout>(ImportParams.TETextureTransfer.VulkanNewLayout);
+			const TEResult Result = TEInstanceAddVulkanTextureTransfer(ImportParams.Instance, ImportParams.TETexture, AcquireOldLayout, AcquireNewLayout,
+				ImportParams.TETextureTransfer.Semaphore, ImportParams.TETextureTransfer.WaitValue);
+			UE_CLOG(Result != TEResultSuccess, LogTouchEngineTECalls, Error, TEXT("[FTouchTextureImporterVulkan::ReturnTextureTransfer[%s]] TEInstanceAddVulkanTextureTransfer returned `%s` for parameter `%s`"),
+				*GetCurrentThreadStr(), *TEResultToString(Result), *ImportParams.Identifier.ToString());
+		}
+	}
+
 	TSharedPtr<FTouchImportTextureVulkan> FTouchTextureImporterVulkan::GetOrCreateSharedTexture(const TouchObject<TETexture>& Texture)
 	{
 		check(TETextureGetType(Texture) == TETextureTypeVulkan);
@@ -41,6 +41,7 @@ namespace UE::TouchEngine::Vulkan
 		virtual TSharedPtr<ITouchImportTexture> CreatePlatformTexture_RenderThread(const TouchObject<TEInstance>& Instance, const TouchObject<TETexture>& SharedTexture) override;
 		virtual FTextureMetaData GetTextureMetaData(const TouchObject<TETexture>& Texture) const override;
 		virtual FTouchTextureTransfer GetTextureTransfer(const FTouchImportParameters& ImportParams) override;
+		virtual void ReturnTextureTransfer(const FTouchImportParameters& ImportParams) override;
 		//~ End FTouchTextureImporter Interface
 
 	private:
@@ -67,6 +67,12 @@ namespace UE::TouchEngine::Vulkan
 		virtual void FinalizeExportsToTouchEngine_GameThread(const FTouchEngineInputFrameData& FrameData) override;
 		virtual bool SetExportedTexturePoolSize(int ExportedTexturePoolSize) override;
 		virtual bool SetImportedTexturePoolSize(int ImportedTexturePoolSize) override;
+		virtual bool SetExportedTexturePoolBudget(int64 ExportedTexturePoolBudgetBytes) override;
+		virtual bool SetImportedTexturePoolBudget(int64 ImportedTexturePoolBudgetBytes) override;
+		virtual bool SetExportedTexturePoolAdaptiveSizing(bool bEnabled, int32 MinPoolSize) override;
+		virtual bool SetImportedTexturePoolAdaptiveSizing(bool bEnabled, int32 MinPoolSize) override;
+		virtual bool PrewarmExportedTexturePool_GameThread(const TArray<FTouchEngineTextureDescriptor>& Descriptors) override;
+		virtual TArray<FTouchEngineTextureDescriptor> GetObservedExportedTextureDescriptors() override;
 
 	protected:
 		virtual FTouchTextureImporter& GetImporter() override { return TextureImporter.Get(); }
@@ -212,6 +218,41 @@ namespace UE::TouchEngine::Vulkan
 		return true;
 	}
 
+	bool FTouchEngineVulkanResourceProvider::SetExportedTexturePoolBudget(int64 ExportedTexturePoolBudgetBytes)
+	{
+		TextureExporter->PoolBudgetBytes = FMath::Max<int64>(ExportedTexturePoolBudgetBytes, 0);
+		return true;
+	}
+
+	bool FTouchEngineVulkanResourceProvider::SetImportedTexturePoolBudget(int64 ImportedTexturePoolBudgetBytes)
+	{
+		TextureImporter->PoolBudgetBytes = FMath::Max<int64>(ImportedTexturePoolBudgetBytes, 0);
+		return true;
+	}
+
+	bool FTouchEngineVulkanResourceProvider::SetExportedTexturePoolAdaptiveSizing(bool bEnabled, int32 MinPoolSize)
+	{
+		TextureExporter->SetAdaptivePoolSize(bEnabled, MinPoolSize);
+		return true;
+	}
+
+	bool FTouchEngineVulkanResourceProvider::SetImportedTexturePoolAdaptiveSizing(bool bEnabled, int32 MinPoolSize)
+	{
+		TextureImporter->SetAdaptivePoolSize(bEnabled, MinPoolSize);
+		return true;
+	}
+
+	bool FTouchEngineVulkanResourceProvider::PrewarmExportedTexturePool_GameThread(const TArray<FTouchEngineTextureDescriptor>& Descriptors)
+	{
+		TextureExporter->PrewarmPool(Descriptors);
+		return true;
+	}
+
+	TArray<FTouchEngineTextureDescriptor> FTouchEngineVulkanResourceProvider::GetObservedExportedTextureDescriptors()
+	{
+		return TextureExporter->GetObservedDescriptors();
+	}
+
 	TFuture<FTouchSuspendResult> FTouchEngineVulkanResourceProvider::SuspendAsyncTasks_GameThread()
 	{
 		TPromise<FTouchSuspendResult> Promise;
@@ -29,6 +29,7 @@ namespace UE::TouchEngine::Vulkan
 	PFN_vkGetSemaphoreWin32HandleKHR vkGetSemaphoreWin32HandleKHR;
 	PFN_vkGetMemoryWin32HandleKHR vkGetMemoryWin32HandleKHR;
 	PFN_vkGetSemaphoreCounterValue vkGetSemaphoreCounterValue;
+	PFN_vkWaitSemaphores vkWaitSemaphores;
 
 	bool IsVulkanSelected()
 	{
@@ -86,6 +87,10 @@ namespace UE::TouchEngine::Vulkan
 			vkGetSemaphoreCounterValue = reinterpret_cast<PFN_vkGetSemaphoreCounterValue>(VulkanDynamicAPI::vkGetDeviceProcAddr(Pointers.VulkanDeviceHandle, "vkGetSemaphoreCounterValue"));
 			UE_CLOG(vkGetSemaphoreCounterValue == nullptr, LogTouchEngineVulkanRHI, Error, TEXT("Vulkan: Proc address for \"vkGetSemaphoreCounterValue\" not found (GetLastError(): %d)."), GetLastError());
 			ensure(vkGetSemaphoreCounterValue);
+
+			vkWaitSemaphores = reinterpret_cast<PFN_vkWaitSemaphores>(VulkanDynamicAPI::vkGetDeviceProcAddr(Pointers.VulkanDeviceHandle, "vkWaitSemaphores"));
+			UE_CLOG(vkWaitSemaphores == nullptr, LogTouchEngineVulkanRHI, Error, TEXT("Vulkan: Proc address for \"vkWaitSemaphores\" not found (GetLastError(): %d)."), GetLastError());
+			ensure(vkWaitSemaphores);
 #pragma warning(pop) 
 		}
 	}
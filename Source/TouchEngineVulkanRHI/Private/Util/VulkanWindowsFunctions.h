@@ -34,6 +34,7 @@ namespace UE::TouchEngine::Vulkan
 	extern PFN_vkGetSemaphoreWin32HandleKHR vkGetSemaphoreWin32HandleKHR;
 	extern PFN_vkGetMemoryWin32HandleKHR vkGetMemoryWin32HandleKHR;
 	extern PFN_vkGetSemaphoreCounterValue vkGetSemaphoreCounterValue;
+	extern PFN_vkWaitSemaphores vkWaitSemaphores;
 
 	bool IsVulkanSelected();
 	void ConditionallySetupVulkanExtensions();